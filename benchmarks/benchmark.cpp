@@ -116,6 +116,86 @@ void bench_rpc(
     }
 #endif
 
+#if defined(RPC_HPP_ENABLE_MSGPACK)
+    bench.run("rpc.hpp (asio::tcp, MessagePack)",
+        [&]
+        {
+            nanobench::doNotOptimizeAway(
+                test_val = GetClient<msgpack_adapter>().template call_func<T>(
+                    func_name, std::forward<Args>(args)...));
+        });
+
+    if constexpr (std::is_floating_point_v<T>)
+    {
+        REQUIRE(test_val == doctest::Approx(expected));
+    }
+    else
+    {
+        REQUIRE(test_val == expected);
+    }
+#endif
+
+#if defined(RPC_HPP_ENABLE_SIMDJSON)
+    bench.run("rpc.hpp (asio::tcp, simdjson)",
+        [&]
+        {
+            nanobench::doNotOptimizeAway(
+                test_val = GetClient<simdjson_adapter>().template call_func<T>(
+                    func_name, std::forward<Args>(args)...));
+        });
+
+    if constexpr (std::is_floating_point_v<T>)
+    {
+        REQUIRE(test_val == doctest::Approx(expected));
+    }
+    else
+    {
+        REQUIRE(test_val == expected);
+    }
+#endif
+
+#if defined(RPC_HPP_ENABLE_VIEW)
+    bench.run("rpc.hpp (asio::tcp, view)",
+        [&]
+        {
+            nanobench::doNotOptimizeAway(
+                test_val = GetClient<view_adapter>().template call_func<T>(
+                    func_name, std::forward<Args>(args)...));
+        });
+
+    if constexpr (std::is_floating_point_v<T>)
+    {
+        REQUIRE(test_val == doctest::Approx(expected));
+    }
+    else
+    {
+        REQUIRE(test_val == expected);
+    }
+#endif
+
+#if defined(RPC_HPP_ENABLE_RAW)
+    if constexpr (rpc_hpp::adapters::is_raw_signature_v<T,
+                      std::remove_cv_t<std::remove_reference_t<Args>>...>)
+    {
+        bench.run("rpc.hpp (asio::tcp, raw)",
+            [&]
+            {
+                nanobench::doNotOptimizeAway(
+                    test_val = GetClient<raw_adapter>().template call_func<T>(
+                        func_name, std::forward<Args>(args)...));
+            });
+
+        if constexpr (std::is_floating_point_v<T>)
+        {
+            REQUIRE(test_val == doctest::Approx(expected));
+        }
+        else
+        {
+            REQUIRE(test_val == expected);
+        }
+    }
+#endif
+
 #if defined(RPC_HPP_BENCH_RPCLIB)
     bench.run("rpclib",
         [&]
@@ -161,6 +241,27 @@ void bench_grpc(nanobench::Bench& bench, const T& expected, F member_func, Args&
 }
 #endif
 
+// Measures the server side of a failed call: writing an exception into a received request
+template<typename Serial>
+void bench_exception(nanobench::Bench& bench, const std::string& name, const std::string& mesg)
+{
+    const auto request = Serial::serialize_pack(
+        rpc_hpp::detail::packed_func<int, int, int>{ "SimpleSum", std::nullopt, { 1, 2 } });
+
+    const rpc_hpp::remote_exec_error ex{ mesg };
+    auto serial_obj = request;
+
+    bench.run(name,
+        [&]
+        {
+            serial_obj = request;
+            Serial::set_exception(serial_obj, ex);
+            nanobench::doNotOptimizeAway(serial_obj);
+        });
+
+    REQUIRE(Serial::extract_exception(serial_obj).get_type() == ex.get_type());
+}
+
 TEST_CASE("By Value (simple)")
 {
     static constexpr uint64_t expected = 10946;
@@ -297,6 +398,57 @@ TEST_CASE("Sequential")
         });
 #endif
 
+#if defined(RPC_HPP_ENABLE_MSGPACK)
+    b.run("rpc.hpp (asio::tcp, MessagePack)",
+        [&]
+        {
+            auto vec = GetClient<msgpack_adapter>().template call_func<std::vector<uint64_t>>(
+                "GenRandInts", min_num, max_num, num_rands);
+
+            for (auto& val : vec)
+            {
+                val = GetClient<msgpack_adapter>().template call_func<uint64_t>("Fibonacci", val);
+            }
+
+            nanobench::doNotOptimizeAway(GetClient<msgpack_adapter>().template call_func<double>(
+                "AverageContainer<uint64_t>", vec));
+        });
+#endif
+
+#if defined(RPC_HPP_ENABLE_SIMDJSON)
+    b.run("rpc.hpp (asio::tcp, simdjson)",
+        [&]
+        {
+            auto vec = GetClient<simdjson_adapter>().template call_func<std::vector<uint64_t>>(
+                "GenRandInts", min_num, max_num, num_rands);
+
+            for (auto& val : vec)
+            {
+                val = GetClient<simdjson_adapter>().template call_func<uint64_t>("Fibonacci", val);
+            }
+
+            nanobench::doNotOptimizeAway(GetClient<simdjson_adapter>().template call_func<double>(
+                "AverageContainer<uint64_t>", vec));
+        });
+#endif
+
+#if defined(RPC_HPP_ENABLE_VIEW)
+    b.run("rpc.hpp (asio::tcp, view)",
+        [&]
+        {
+            auto vec = GetClient<view_adapter>().template call_func<std::vector<uint64_t>>(
+                "GenRandInts", min_num, max_num, num_rands);
+
+            for (auto& val : vec)
+            {
+                val = GetClient<view_adapter>().template call_func<uint64_t>("Fibonacci", val);
+            }
+
+            nanobench::doNotOptimizeAway(GetClient<view_adapter>().template call_func<double>(
+                "AverageContainer<uint64_t>", vec));
+        });
+#endif
+
 #if defined(RPC_HPP_BENCH_RPCLIB)
     b.run("rpclib",
         [&]
@@ -331,6 +483,82 @@ TEST_CASE("Sequential")
 #endif
 }
 
+TEST_CASE("Error path")
+{
+    const std::string mesg(2'000, 'E');
+
+    nanobench::Bench b;
+    b.title("Error path (2 KB message)").warmup(1).relative(true).minEpochIterations(2'000);
+    bench_exception<njson_adapter>(b, "rpc.hpp (njson)", mesg);
+
+#if defined(RPC_HPP_ENABLE_RAPIDJSON)
+    bench_exception<rapidjson_adapter>(b, "rpc.hpp (rapidjson)", mesg);
+#endif
+
+#if defined(RPC_HPP_ENABLE_BOOST_JSON)
+    bench_exception<boost_json_adapter>(b, "rpc.hpp (Boost.JSON)", mesg);
+#endif
+
+#if defined(RPC_HPP_ENABLE_BITSERY)
+    bench_exception<bitsery_adapter>(b, "rpc.hpp (bitsery)", mesg);
+#endif
+
+#if defined(RPC_HPP_ENABLE_MSGPACK)
+    bench_exception<msgpack_adapter>(b, "rpc.hpp (msgpack)", mesg);
+#endif
+
+#if defined(RPC_HPP_ENABLE_SIMDJSON)
+    bench_exception<simdjson_adapter>(b, "rpc.hpp (simdjson)", mesg);
+#endif
+
+#if defined(RPC_HPP_ENABLE_VIEW)
+    bench_exception<view_adapter>(b, "rpc.hpp (view)", mesg);
+#endif
+
+#if defined(RPC_HPP_ENABLE_RAW)
+    bench_exception<raw_adapter>(b, "rpc.hpp (raw)", mesg);
+#endif
+}
+
+// Measures the base64 helpers behind *_BINARY_ARRAYS, which are vectorized when built with SSSE3
+// (e.g. -mssse3 or -march=native), so compare runs with and without it
+TEST_CASE("Base64")
+{
+#if defined(__SSSE3__)
+    static constexpr auto title = "Base64 (1 MB, SSSE3)";
+#else
+    static constexpr auto title = "Base64 (1 MB, scalar)";
+#endif
+
+    std::vector<uint8_t> data(1'000'000);
+
+    for (size_t i = 0; i < data.size(); ++i)
+    {
+        data[i] = static_cast<uint8_t>((i * 7'919U) >> 3U);
+    }
+
+    std::string text(rpc_hpp::detail::base64_encoded_size(data.size()), '\0');
+    std::vector<uint8_t> decoded(data.size());
+
+    nanobench::Bench b;
+    b.title(title).warmup(1).batch(data.size()).unit("byte").minEpochIterations(20);
+
+    b.run("encode",
+        [&]
+        {
+            rpc_hpp::detail::base64_encode(data.data(), data.size(), text.data());
+            nanobench::doNotOptimizeAway(text);
+        });
+
+    b.run("decode",
+        [&]
+        {
+            nanobench::doNotOptimizeAway(rpc_hpp::detail::base64_decode(text, decoded.data()));
+        });
+
+    REQUIRE(decoded == data);
+}
+
 TEST_CASE("KillServer")
 {
 #if defined(RPC_HPP_BENCH_RPCLIB)
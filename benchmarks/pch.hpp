@@ -40,6 +40,10 @@
 #    include <rapidjson/writer.h>
 #endif
 
+#if defined(RPC_HPP_ENABLE_SIMDJSON)
+#    include <simdjson.h>
+#endif
+
 #if defined(RPC_HPP_BENCH_GRPC)
 #    include <grpc/grpc.h>
 #    include <grpcpp/channel.h>
@@ -9,7 +9,7 @@
 #include <string>
 #include <vector>
 
-using rpc_hpp::adapters::njson_adapter;
+using rpc_hpp::adapters::njson_text_adapter;
 
 RpcClient::RpcClient(const std::string& module_path) : m_module{ LoadLibrary(module_path.c_str()) }
 {
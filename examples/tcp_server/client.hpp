@@ -21,15 +21,15 @@ public:
     std::string getIP() const { return m_socket.remote_endpoint().address().to_string(); }
 
 private:
-    void send(const std::string& mesg) override
+    void send(const njson_adapter::bytes_t& mesg) override
     {
         asio::write(m_socket, asio::buffer(mesg, mesg.size()));
     }
 
-    std::string receive() override
+    njson_adapter::bytes_t receive() override
     {
         const auto numBytes = m_socket.read_some(asio::buffer(m_buffer, BUF_SZ));
-        return std::string{ m_buffer, m_buffer + numBytes };
+        return njson_adapter::bytes_t{ m_buffer, m_buffer + numBytes };
     }
 
     asio::io_context m_io{};
@@ -40,6 +40,8 @@
 #if defined(RPC_HPP_DOXYGEN_GEN)
 ///@brief Enables server-side caching abilities
 #  define RPC_HPP_ENABLE_SERVER_CACHE
+///@brief Sends a @ref rpc_hpp::message_header in front of every message (must match between client and server)
+#  define RPC_HPP_ENABLE_MESSAGE_HEADER
 ///@brief Indicates that rpc.hpp is being consumed by a client translation unit
 #  define RPC_HPP_CLIENT_IMPL
 ///@brief Indicates that rpc.hpp is being consumed by a module (dynamically loaded .dll/.so) translation unit
@@ -52,18 +54,49 @@
 #  error At least one implementation type must be defined using 'RPC_HPP_{CLIENT, SERVER, MODULE}_IMPL'
 #endif
 
-#include <cassert>     // for assert
-#include <cstddef>     // for size_t
-#include <optional>    // for nullopt, optional
-#include <stdexcept>   // for runtime_error
-#include <string>      // for string
-#include <tuple>       // for tuple, forward_as_tuple
-#include <type_traits> // for declval, false_type, is_same, integral_constant
-#include <utility>     // for move, index_sequence, make_index_sequence
+#include <array>         // for array
+#include <cassert>       // for assert
+#include <cstddef>       // for byte, size_t
+#include <cstdint>       // for uint8_t, uint32_t, uint64_t
+#include <cstring>       // for memcpy, memmove
+#include <functional>    // for function, hash
+#include <iterator>      // for distance
+#include <optional>      // for nullopt, optional
+#include <stdexcept>     // for logic_error, runtime_error
+#include <string>        // for string
+#include <string_view>   // for string_view
+#include <tuple>         // for tuple, forward_as_tuple
+#include <type_traits>   // for declval, false_type, is_same, integral_constant
+#include <unordered_map> // for unordered_map
+#include <utility>       // for move, index_sequence, make_index_sequence, pair
+#include <variant>       // for variant, variant_alternative_t
+#include <vector>        // for vector
 
 #if defined(RPC_HPP_MODULE_IMPL) || defined(RPC_HPP_SERVER_IMPL)
-#  include <functional>    // for function
-#  include <unordered_map> // for unordered_map
+#  include <memory> // for make_shared, shared_ptr
+#endif
+
+#if defined(RPC_HPP_CLIENT_IMPL) && defined(RPC_HPP_ENABLE_MESSAGE_HEADER)
+#  include <atomic> // for atomic
+#endif
+
+#if defined(RPC_HPP_SERVER_IMPL) && defined(RPC_HPP_ENABLE_SERVER_CACHE)
+#  include <atomic>             // for atomic
+#  include <chrono>             // for duration, steady_clock
+#  include <condition_variable> // for condition_variable
+#  include <istream>            // for istream
+#  include <map>                // for map
+#  include <memory>             // for make_shared, shared_ptr, unique_ptr
+#  include <mutex>              // for mutex, lock_guard, unique_lock
+#  include <ostream>            // for ostream
+#  include <thread>             // for thread, sleep_until
+#  include <typeindex>          // for type_index
+#  include <typeinfo>           // for type_info
+#  include <unordered_set>      // for unordered_set
+#endif
+
+#if defined(__SSSE3__)
+#  include <tmmintrin.h> // for _mm_shuffle_epi8, _mm_maddubs_epi16
 #endif
 
 #if defined(RPC_HPP_SERVER_IMPL) || defined(RPC_HPP_MODULE_IMPL)
@@ -83,6 +116,73 @@
 #  define RPC_HPP_INLINE
 #endif
 
+// Expands to OBJ.F1, OBJ.F2, ... for up to 16 field names
+#define RPC_HPP_DETAIL_EXPAND(X) X
+#define RPC_HPP_DETAIL_CONCAT_IMPL(A, B) A##B
+#define RPC_HPP_DETAIL_CONCAT(A, B) RPC_HPP_DETAIL_CONCAT_IMPL(A, B)
+#define RPC_HPP_DETAIL_COUNT(...)                                                                  \
+    RPC_HPP_DETAIL_EXPAND(RPC_HPP_DETAIL_COUNT_IMPL(                                               \
+        __VA_ARGS__, 16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1))
+#define RPC_HPP_DETAIL_COUNT_IMPL(                                                                 \
+    _1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, _16, N, ...)                 \
+    N
+#define RPC_HPP_DETAIL_MEMBERS_1(OBJ, F) OBJ.F
+#define RPC_HPP_DETAIL_MEMBERS_2(OBJ, F, ...)                                                      \
+    OBJ.F, RPC_HPP_DETAIL_EXPAND(RPC_HPP_DETAIL_MEMBERS_1(OBJ, __VA_ARGS__))
+#define RPC_HPP_DETAIL_MEMBERS_3(OBJ, F, ...)                                                      \
+    OBJ.F, RPC_HPP_DETAIL_EXPAND(RPC_HPP_DETAIL_MEMBERS_2(OBJ, __VA_ARGS__))
+#define RPC_HPP_DETAIL_MEMBERS_4(OBJ, F, ...)                                                      \
+    OBJ.F, RPC_HPP_DETAIL_EXPAND(RPC_HPP_DETAIL_MEMBERS_3(OBJ, __VA_ARGS__))
+#define RPC_HPP_DETAIL_MEMBERS_5(OBJ, F, ...)                                                      \
+    OBJ.F, RPC_HPP_DETAIL_EXPAND(RPC_HPP_DETAIL_MEMBERS_4(OBJ, __VA_ARGS__))
+#define RPC_HPP_DETAIL_MEMBERS_6(OBJ, F, ...)                                                      \
+    OBJ.F, RPC_HPP_DETAIL_EXPAND(RPC_HPP_DETAIL_MEMBERS_5(OBJ, __VA_ARGS__))
+#define RPC_HPP_DETAIL_MEMBERS_7(OBJ, F, ...)                                                      \
+    OBJ.F, RPC_HPP_DETAIL_EXPAND(RPC_HPP_DETAIL_MEMBERS_6(OBJ, __VA_ARGS__))
+#define RPC_HPP_DETAIL_MEMBERS_8(OBJ, F, ...)                                                      \
+    OBJ.F, RPC_HPP_DETAIL_EXPAND(RPC_HPP_DETAIL_MEMBERS_7(OBJ, __VA_ARGS__))
+#define RPC_HPP_DETAIL_MEMBERS_9(OBJ, F, ...)                                                      \
+    OBJ.F, RPC_HPP_DETAIL_EXPAND(RPC_HPP_DETAIL_MEMBERS_8(OBJ, __VA_ARGS__))
+#define RPC_HPP_DETAIL_MEMBERS_10(OBJ, F, ...)                                                     \
+    OBJ.F, RPC_HPP_DETAIL_EXPAND(RPC_HPP_DETAIL_MEMBERS_9(OBJ, __VA_ARGS__))
+#define RPC_HPP_DETAIL_MEMBERS_11(OBJ, F, ...)                                                     \
+    OBJ.F, RPC_HPP_DETAIL_EXPAND(RPC_HPP_DETAIL_MEMBERS_10(OBJ, __VA_ARGS__))
+#define RPC_HPP_DETAIL_MEMBERS_12(OBJ, F, ...)                                                     \
+    OBJ.F, RPC_HPP_DETAIL_EXPAND(RPC_HPP_DETAIL_MEMBERS_11(OBJ, __VA_ARGS__))
+#define RPC_HPP_DETAIL_MEMBERS_13(OBJ, F, ...)                                                     \
+    OBJ.F, RPC_HPP_DETAIL_EXPAND(RPC_HPP_DETAIL_MEMBERS_12(OBJ, __VA_ARGS__))
+#define RPC_HPP_DETAIL_MEMBERS_14(OBJ, F, ...)                                                     \
+    OBJ.F, RPC_HPP_DETAIL_EXPAND(RPC_HPP_DETAIL_MEMBERS_13(OBJ, __VA_ARGS__))
+#define RPC_HPP_DETAIL_MEMBERS_15(OBJ, F, ...)                                                     \
+    OBJ.F, RPC_HPP_DETAIL_EXPAND(RPC_HPP_DETAIL_MEMBERS_14(OBJ, __VA_ARGS__))
+#define RPC_HPP_DETAIL_MEMBERS_16(OBJ, F, ...)                                                     \
+    OBJ.F, RPC_HPP_DETAIL_EXPAND(RPC_HPP_DETAIL_MEMBERS_15(OBJ, __VA_ARGS__))
+#define RPC_HPP_DETAIL_MEMBERS(OBJ, ...)                                                           \
+    RPC_HPP_DETAIL_EXPAND(RPC_HPP_DETAIL_CONCAT(                                                   \
+        RPC_HPP_DETAIL_MEMBERS_, RPC_HPP_DETAIL_COUNT(__VA_ARGS__))(OBJ, __VA_ARGS__))
+
+///@brief Lists the fields of an aggregate so that every serial adapter can encode it directly
+///
+///@details Must be used in the namespace of TYPE, listing every non-static data member (at most
+///16). Each name is accessed as a member of TYPE, so misspelled names fail to compile, and a
+///structured binding checks that no member is left out. Fields are encoded in the order they are
+///listed, which must match on the client and server. Field names are used as keys by the
+///adapters that encode objects with named members.
+#define RPC_HPP_REFLECT(TYPE, ...)                                                                 \
+    [[nodiscard]] inline auto rpc_hpp_fields(TYPE& rpc_hpp_obj) noexcept                           \
+    {                                                                                              \
+        [[maybe_unused]] auto& [__VA_ARGS__] = rpc_hpp_obj;                                        \
+        return std::tie(RPC_HPP_DETAIL_MEMBERS(rpc_hpp_obj, __VA_ARGS__));                         \
+    }                                                                                              \
+    [[nodiscard]] inline auto rpc_hpp_fields(const TYPE& rpc_hpp_obj) noexcept                     \
+    {                                                                                              \
+        return std::tie(RPC_HPP_DETAIL_MEMBERS(rpc_hpp_obj, __VA_ARGS__));                         \
+    }                                                                                              \
+    [[nodiscard]] constexpr std::string_view rpc_hpp_field_names(const TYPE*) noexcept             \
+    {                                                                                              \
+        return #__VA_ARGS__;                                                                       \
+    }
+
 ///@brief Top-level namespace for rpc.hpp classes and functions
 namespace rpc_hpp
 {
@@ -248,6 +348,191 @@ public:
     }
 };
 
+#if defined(RPC_HPP_ENABLE_MESSAGE_HEADER)
+///@brief Fixed binary header sent in front of the serialized body of every message
+///
+///@details Lets a transport or server frame, route, and filter messages without parsing their body.
+/// Layout (integers are little-endian): magic "RH" (2 bytes), version (1), flags (1), request ID (8),
+/// body size (4), function name size (2), then the function name
+struct message_header
+{
+    ///@brief Size of the header, not counting the function name
+    static constexpr size_t fixed_size = 18;
+
+    ///@brief Version of the layout written by this header
+    static constexpr uint8_t current_version = 1;
+
+    ///@brief Flag set on replies from the server
+    static constexpr uint8_t response_flag = 1U;
+
+    uint8_t flags{ 0 };
+
+    ///@brief Identifier chosen by the client, echoed back in the reply
+    uint64_t request_id{ 0 };
+
+    ///@brief Size of the body following the header
+    uint32_t body_size{ 0 };
+
+    std::string func_name{};
+
+    [[nodiscard]] bool is_response() const noexcept { return (flags & response_flag) != 0; }
+
+    ///@brief Size of the header, including the function name
+    [[nodiscard]] size_t size() const noexcept { return fixed_size + func_name.size(); }
+
+    ///@brief Reads the header at the start of bytes
+    ///
+    ///@tparam Bytes Byte container (e.g. the bytes_t of a serial adapter)
+    ///@param bytes Message, or at least its header
+    ///@return std::optional<message_header> The header (std::nullopt if bytes does not start with one)
+    template<typename Bytes>
+    [[nodiscard]] static std::optional<message_header> read(const Bytes& bytes)
+    {
+        const auto* const data = reinterpret_cast<const uint8_t*>(bytes.data());
+
+        if (bytes.size() < fixed_size || data[0] != magic[0] || data[1] != magic[1]
+            || data[2] != current_version)
+        {
+            return std::nullopt;
+        }
+
+        message_header header{};
+        header.flags = data[3];
+        header.request_id = read_le<uint64_t>(data + 4);
+        header.body_size = read_le<uint32_t>(data + 12);
+        const size_t name_size = read_le<uint16_t>(data + 16);
+
+        if (bytes.size() < fixed_size + name_size)
+        {
+            return std::nullopt;
+        }
+
+        header.func_name.assign(reinterpret_cast<const char*>(data + fixed_size), name_size);
+        return header;
+    }
+
+    ///@brief Reads the request ID from the fixed part of the header at the start of bytes
+    ///
+    ///@details Unlike @ref read, this does not require the function name to be complete, so that a reply to a
+    /// malformed message can still be matched to its request
+    ///@tparam Bytes Byte container (e.g. the bytes_t of a serial adapter)
+    ///@param bytes Message, or at least the fixed part of its header
+    ///@return std::optional<uint64_t> The request ID (std::nullopt if bytes does not start with a header)
+    template<typename Bytes>
+    [[nodiscard]] static std::optional<uint64_t> read_request_id(const Bytes& bytes)
+    {
+        const auto* const data = reinterpret_cast<const uint8_t*>(bytes.data());
+
+        if (bytes.size() < fixed_size || data[0] != magic[0] || data[1] != magic[1]
+            || data[2] != current_version)
+        {
+            return std::nullopt;
+        }
+
+        return read_le<uint64_t>(data + 4);
+    }
+
+    ///@brief Creates a message from this header and body
+    ///
+    ///@note The body size written is that of body, not @ref body_size
+    ///@throws serialization_error Thrown if the function name or body are too large for the header
+    template<typename Bytes>
+    [[nodiscard]] Bytes frame(const Bytes& body) const
+    {
+        check_size(body.size());
+
+        Bytes bytes{};
+        bytes.resize(size() + body.size());
+        write(reinterpret_cast<uint8_t*>(bytes.data()), body.size());
+
+        if (!body.empty())
+        {
+            std::memcpy(bytes.data() + size(), body.data(), body.size());
+        }
+
+        return bytes;
+    }
+
+    ///@brief Turns the body held by bytes into a message with this header, in place
+    ///
+    ///@note Unlike @ref frame, no new buffer is needed if bytes has the capacity for the header
+    ///@throws serialization_error Thrown if the function name or body are too large for the header
+    template<typename Bytes>
+    void prepend(Bytes& bytes) const
+    {
+        const size_t body_len = bytes.size();
+        check_size(body_len);
+        bytes.resize(size() + body_len);
+
+        if (body_len != 0)
+        {
+            std::memmove(bytes.data() + size(), bytes.data(), body_len);
+        }
+
+        write(reinterpret_cast<uint8_t*>(bytes.data()), body_len);
+    }
+
+    ///@brief Turns a message that starts with this header into its body, in place
+    template<typename Bytes>
+    void remove_from(Bytes& bytes) const
+    {
+        const size_t body_len = bytes.size() - size();
+
+        if (body_len != 0)
+        {
+            std::memmove(bytes.data(), bytes.data() + size(), body_len);
+        }
+
+        bytes.resize(body_len);
+    }
+
+private:
+    static constexpr std::array<uint8_t, 2> magic{ 'R', 'H' };
+
+    void check_size(const size_t body_len) const
+    {
+        if (func_name.size() > UINT16_MAX || body_len > UINT32_MAX)
+        {
+            throw serialization_error("Message is too large for its header");
+        }
+    }
+
+    void write(uint8_t* const data, const size_t body_len) const noexcept
+    {
+        data[0] = magic[0];
+        data[1] = magic[1];
+        data[2] = current_version;
+        data[3] = flags;
+        write_le(data + 4, request_id);
+        write_le(data + 12, static_cast<uint32_t>(body_len));
+        write_le(data + 16, static_cast<uint16_t>(func_name.size()));
+        std::memcpy(data + fixed_size, func_name.data(), func_name.size());
+    }
+
+    template<typename T>
+    [[nodiscard]] static T read_le(const uint8_t* const data) noexcept
+    {
+        T val = 0;
+
+        for (size_t i = 0; i < sizeof(T); ++i)
+        {
+            val = static_cast<T>(val | static_cast<T>(static_cast<T>(data[i]) << (8U * i)));
+        }
+
+        return val;
+    }
+
+    template<typename T>
+    static void write_le(uint8_t* const data, const T val) noexcept
+    {
+        for (size_t i = 0; i < sizeof(T); ++i)
+        {
+            data[i] = static_cast<uint8_t>(val >> (8U * i));
+        }
+    }
+};
+#endif
+
 namespace adapters
 {
     template<typename T>
@@ -388,592 +673,3046 @@ namespace detail
     template<typename T>
     inline constexpr bool is_tuple_v = is_tuple<T>::value;
 
-    template<typename F, typename... Ts, size_t... Is>
-    constexpr void for_each_tuple(const std::tuple<Ts...>& tuple, const F& func,
-        [[maybe_unused]] std::index_sequence<Is...> iseq)
-    {
-        using expander = int[];
-        std::ignore = expander{ 0, ((void)func(std::get<Is>(tuple)), 0)... };
-    }
+    template<typename>
+    struct is_pair : std::false_type {};
 
-    template<typename F, typename... Ts>
-    constexpr void for_each_tuple(const std::tuple<Ts...>& tuple, const F& func)
-    {
-        for_each_tuple(tuple, func, std::make_index_sequence<sizeof...(Ts)>());
-    }
+    template<typename T1, typename T2>
+    struct is_pair<std::pair<T1, T2>> : std::true_type {};
 
-    template<typename F, typename... Ts, size_t... Is>
-    constexpr void for_each_tuple(std::tuple<Ts...>& tuple, const F& func,
-                                  [[maybe_unused]] std::index_sequence<Is...> iseq)
-    {
-        using expander = int[];
-        std::ignore = expander{ 0, ((void)func(std::get<Is>(tuple)), 0)... };
-    }
+    template<typename T>
+    inline constexpr bool is_pair_v = is_pair<T>::value;
 
-    template<typename F, typename... Ts>
-    constexpr void for_each_tuple(std::tuple<Ts...>& tuple, const F& func)
-    {
-        for_each_tuple(tuple, func, std::make_index_sequence<sizeof...(Ts)>());
-    }
+    template<typename>
+    struct is_optional : std::false_type {};
 
-#  if defined(RPC_HPP_CLIENT_IMPL)
-    // Allows passing in string literals
     template<typename T>
-    struct decay_str
-    {
-        static_assert(!std::is_pointer_v<std::remove_cv_t<std::remove_reference_t<T>>>,
-            "Pointer parameters are not allowed");
+    struct is_optional<std::optional<T>> : std::true_type {};
 
-        static_assert(!std::is_array_v<std::remove_cv_t<std::remove_reference_t<T>>>,
-            "C-style array parameters are not allowed");
+    template<typename T>
+    inline constexpr bool is_optional_v = is_optional<T>::value;
 
-        using type = T;
-    };
+    template<typename>
+    struct is_variant : std::false_type {};
 
-    template<>
-    struct decay_str<const char*>
+    template<typename... T>
+    struct is_variant<std::variant<T...>> : std::true_type {};
+
+    template<typename T>
+    inline constexpr bool is_variant_v = is_variant<T>::value;
+
+    // Associative containers with a mapped_type (std::map, std::unordered_map, ...)
+    template<typename C, typename = void>
+    struct is_map : std::false_type {};
+
+    template<typename C>
+    struct is_map<C, std::void_t<typename C::key_type, typename C::mapped_type>> :
+        std::integral_constant<bool, is_container_v<C>>
     {
-        using type = const std::string&;
     };
 
-    template<>
-    struct decay_str<const char*&>
+    template<typename C>
+    inline constexpr bool is_map_v = is_map<C>::value;
+
+    // Maps that text formats can encode as a native object
+    template<typename C, typename = void>
+    struct is_string_map : std::false_type {};
+
+    template<typename C>
+    struct is_string_map<C, std::enable_if_t<is_map_v<C>>> :
+        std::is_same<typename C::key_type, std::string>
     {
-        using type = const std::string&;
     };
 
-    template<>
-    struct decay_str<const char* const&>
+    template<typename C>
+    inline constexpr bool is_string_map_v = is_string_map<C>::value;
+
+    // Associative containers without a mapped_type (std::set, std::unordered_set, ...)
+    template<typename C, typename = void>
+    struct is_set : std::false_type {};
+
+    template<typename C>
+    struct is_set<C, std::void_t<typename C::key_type>> :
+        std::integral_constant<bool, is_container_v<C> && !is_map_v<C>>
     {
-        using type = const std::string&;
     };
 
-    template<size_t N>
-    struct decay_str<const char (&)[N]>
+    template<typename C>
+    inline constexpr bool is_set_v = is_set<C>::value;
+
+    // Containers whose extent is part of the type (std::array). These are decoded in place, never
+    // through reserve/push_back
+    template<typename>
+    struct is_fixed_extent : std::false_type {};
+
+    template<typename T, size_t N>
+    struct is_fixed_extent<std::array<T, N>> : std::true_type {};
+
+    template<typename C>
+    inline constexpr bool is_fixed_extent_v = is_fixed_extent<C>::value;
+
+    template<typename C>
+    void check_extent(const size_t size)
     {
-        using type = const std::string&;
+        if (size != std::tuple_size_v<C>)
+        {
+            throw function_mismatch("Fixed-extent container size mismatch");
+        }
+    }
+
+    template<typename C>
+    struct has_data
+    {
+    private:
+        template<typename T>
+        static constexpr auto check(T*) noexcept ->
+            typename std::is_same<decltype(std::declval<const T&>().data()),
+                const typename T::value_type*>::type;
+
+        template<typename>
+        static constexpr std::false_type check(...) noexcept;
+
+        using type = decltype(check<C>(nullptr));
+
+    public:
+        static constexpr bool value = type::value;
     };
 
-    template<typename T>
-    using decay_str_t = typename decay_str<T>::type;
+    // Contiguous containers of numbers or raw bytes, which binary-capable encodings can copy as a
+    // single block of memory
+    template<typename C, typename = void>
+    struct is_bulk_container : std::false_type {};
 
-    template<typename... Args, size_t... Is>
-    constexpr void tuple_bind(
-        const std::tuple<std::remove_cv_t<std::remove_reference_t<decay_str_t<Args>>>...>& src,
-        std::index_sequence<Is...>, Args&&... dest)
+    template<typename C>
+    struct is_bulk_container<C,
+        std::enable_if_t<
+            is_container_v<C> && has_data<C>::value && !std::is_same_v<C, std::string>>> :
+        std::integral_constant<bool,
+            sizeof(typename C::value_type) <= 8
+                && ((std::is_arithmetic_v<typename C::value_type>
+                        && !std::is_same_v<typename C::value_type, bool>)
+                    || std::is_same_v<typename C::value_type, std::byte>)>
     {
-        using expander = int[];
-        std::ignore = expander{ 0,
-            (
-                (void)[](auto&& x, auto&& y) {
-                    if constexpr (
-                        std::is_reference_v<
-                            decltype(x)> && !std::is_const_v<std::remove_reference_t<decltype(x)>> && !std::is_pointer_v<std::remove_reference_t<decltype(x)>>)
-                    {
-                        x = std::forward<decltype(y)>(y);
-                    }
-                }(dest, std::get<Is>(src)),
-                0)... };
-    }
+    };
 
-    template<typename... Args>
-    constexpr void tuple_bind(
-        const std::tuple<std::remove_cv_t<std::remove_reference_t<decay_str_t<Args>>>...>& src,
-        Args&&... dest)
+    template<typename C>
+    inline constexpr bool is_bulk_container_v = is_bulk_container<C>::value;
+
+    // Byte blobs have no per-element encoding, so they are always sent in bulk
+    template<typename C, typename = void>
+    struct is_byte_container : std::false_type {};
+
+    template<typename C>
+    struct is_byte_container<C, std::enable_if_t<is_bulk_container_v<C>>> :
+        std::is_same<typename C::value_type, std::byte>
     {
-        tuple_bind(src, std::make_index_sequence<sizeof...(Args)>(), std::forward<Args>(dest)...);
-    }
-#  endif
+    };
 
-    template<typename... Args>
-    class packed_func_base
+    template<typename C>
+    inline constexpr bool is_byte_container_v = is_byte_container<C>::value;
+
+    // Identifies the element type of a bulk container: kind in the high nibble, size in the low
+    template<typename T>
+    inline constexpr uint8_t bulk_type_tag_v = static_cast<uint8_t>(
+        ((std::is_floating_point_v<T> ? 2U : (std::is_signed_v<T> ? 1U : 0U)) << 4U) | sizeof(T));
+
+    ///@brief Sizes a bulk container to hold byte_size bytes and returns its storage
+    ///
+    ///@param container Container to resize (fixed extents are checked instead)
+    ///@param byte_size Size of the incoming data in bytes
+    ///@return void* Pointer to the container's contiguous storage
+    template<typename C>
+    [[nodiscard]] void* resize_bulk(C& container, const size_t byte_size)
     {
-    public:
-        using args_t = std::tuple<std::remove_cv_t<std::remove_reference_t<Args>>...>;
+        using value_t = typename C::value_type;
 
-        packed_func_base() = delete;
-        packed_func_base(std::string func_name, args_t args) noexcept
-            : m_func_name(std::move(func_name)), m_args(std::move(args))
+        if (byte_size % sizeof(value_t) != 0)
         {
+            throw function_mismatch("Bulk data size is not a multiple of the element size");
         }
 
-        explicit operator bool() const noexcept { return m_except_type == exception_type::none; }
-        const std::string& get_err_mesg() const noexcept { return m_err_mesg; }
-        const std::string& get_func_name() const noexcept { return m_func_name; }
-        exception_type get_except_type() const noexcept { return m_except_type; }
-
-        void set_exception(std::string&& mesg, const exception_type type) & noexcept
+        if constexpr (is_fixed_extent_v<C>)
         {
-            m_except_type = type;
-            m_err_mesg = std::move(mesg);
+            check_extent<C>(byte_size / sizeof(value_t));
+        }
+        else
+        {
+            container.resize(byte_size / sizeof(value_t));
         }
 
-        const args_t& get_args() const noexcept { return m_args; }
-        args_t& get_args() noexcept { return m_args; }
+        return container.data();
+    }
 
-    protected:
-        ~packed_func_base() noexcept = default;
-        packed_func_base(const packed_func_base&) = default;
-        packed_func_base(packed_func_base&&) noexcept = default;
-        packed_func_base& operator=(const packed_func_base&) & = default;
-        packed_func_base& operator=(packed_func_base&&) & noexcept = default;
+    inline constexpr char base64_alphabet[] =
+        "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
 
-        [[noreturn]] void throw_ex() const noexcept(false)
+    inline constexpr std::array<uint8_t, 256> base64_lookup = []() noexcept
+    {
+        std::array<uint8_t, 256> table{};
+
+        for (auto& entry : table)
         {
-            switch (m_except_type)
-            {
-                case exception_type::func_not_found:
-                    throw function_not_found(m_err_mesg);
+            entry = 0xFFU;
+        }
+
+        for (uint8_t i = 0; i < 64; ++i)
+        {
+            table[static_cast<uint8_t>(base64_alphabet[i])] = i;
+        }
 
-                case exception_type::remote_exec:
-                    throw remote_exec_error(m_err_mesg);
+        return table;
+    }();
 
-                case exception_type::serialization:
-                    throw serialization_error(m_err_mesg);
+    [[nodiscard]] constexpr size_t base64_encoded_size(const size_t size) noexcept
+    {
+        return (size + 2) / 3 * 4;
+    }
 
-                case exception_type::deserialization:
-                    throw deserialization_error(m_err_mesg);
+#  if defined(__SSSE3__)
+    // Vectorized base64 (Muła and Lemire, "Faster Base64 Encoding and Decoding Using AVX2
+    // Instructions"), which handles 12 bytes / 16 characters at a time
 
-                case exception_type::signature_mismatch:
-                    throw function_mismatch(m_err_mesg);
+    // Encodes the first 12 bytes of in as 16 characters
+    [[nodiscard]] inline __m128i base64_encode_block(__m128i in) noexcept
+    {
+        // Spread each 3 bytes over 4 bytes, then move each 6 bit index into its own byte
+        in = _mm_shuffle_epi8(in, _mm_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10));
+
+        const __m128i hi_bits = _mm_mulhi_epu16(
+            _mm_and_si128(in, _mm_set1_epi32(0x0FC0FC00)), _mm_set1_epi32(0x04000040));
+        const __m128i lo_bits = _mm_mullo_epi16(
+            _mm_and_si128(in, _mm_set1_epi32(0x003F03F0)), _mm_set1_epi32(0x01000010));
+        const __m128i indices = _mm_or_si128(hi_bits, lo_bits);
+
+        // Offset from each index to its character, looked up by index range
+        const __m128i offsets = _mm_setr_epi8(
+            'A', 'a' - 26, -4, -4, -4, -4, -4, -4, -4, -4, -4, -4, '+' - 62, '/' - 63, 0, 0);
+
+        __m128i ranges = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+        ranges = _mm_sub_epi8(ranges, _mm_cmpgt_epi8(indices, _mm_set1_epi8(25)));
+        return _mm_add_epi8(indices, _mm_shuffle_epi8(offsets, ranges));
+    }
 
-                case exception_type::client_send:
-                    throw client_send_error(m_err_mesg);
+    // Decodes 16 characters into the first 12 bytes of out (which must hold 16 bytes), returns
+    // false if any character is outside of the base64 alphabet
+    [[nodiscard]] inline bool base64_decode_block(const char* text, uint8_t* out) noexcept
+    {
+        const __m128i lut_lo = _mm_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+            0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+        const __m128i lut_hi = _mm_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10,
+            0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+        const __m128i lut_roll =
+            _mm_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+        const __m128i mask_2f = _mm_set1_epi8(0x2F);
 
-                case exception_type::client_receive:
-                    throw client_receive_error(m_err_mesg);
+        __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text));
 
-                case exception_type::server_send:
-                    throw server_send_error(m_err_mesg);
+        const __m128i hi_nibbles = _mm_and_si128(_mm_srli_epi32(chars, 4), mask_2f);
+        const __m128i lo_nibbles = _mm_and_si128(chars, mask_2f);
 
-                case exception_type::server_receive:
-                    throw server_receive_error(m_err_mesg);
+        // A character is valid if the classes of its two nibbles share no bit
+        const __m128i invalid = _mm_and_si128(
+            _mm_shuffle_epi8(lut_lo, lo_nibbles), _mm_shuffle_epi8(lut_hi, hi_nibbles));
 
-                case exception_type::none:
-                default:
-                    throw rpc_exception(m_err_mesg, exception_type::none);
-            }
+        if (_mm_movemask_epi8(_mm_cmpgt_epi8(invalid, _mm_setzero_si128())) != 0)
+        {
+            return false;
         }
 
-    private:
-        exception_type m_except_type{ exception_type::none };
-        std::string m_func_name;
-        std::string m_err_mesg{};
-        args_t m_args;
-    };
+        const __m128i roll =
+            _mm_shuffle_epi8(lut_roll, _mm_add_epi8(_mm_cmpeq_epi8(chars, mask_2f), hi_nibbles));
 
-    template<typename R, typename... Args>
-    class packed_func final : public packed_func_base<Args...>
+        chars = _mm_add_epi8(chars, roll);
+
+        // Merge each 4 indices into 3 bytes
+        const __m128i pairs = _mm_maddubs_epi16(chars, _mm_set1_epi32(0x01400140));
+        const __m128i quads = _mm_madd_epi16(pairs, _mm_set1_epi32(0x00011000));
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out),
+            _mm_shuffle_epi8(
+                quads, _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1)));
+
+        return true;
+    }
+#  endif
+
+    ///@brief Writes data as padded base64 (RFC 4648)
+    ///
+    ///@param data Bytes to encode
+    ///@param size Number of bytes to encode
+    ///@param out Destination, which must hold base64_encoded_size(size) characters
+    inline void base64_encode(const void* data, const size_t size, char* out) noexcept
     {
-    public:
-        using result_t = R;
-        using typename packed_func_base<Args...>::args_t;
+        const auto* bytes = static_cast<const uint8_t*>(data);
+        size_t i = 0;
 
-        packed_func(std::string func_name, std::optional<result_t> result, args_t args) noexcept
-            : packed_func_base<Args...>(std::move(func_name), std::move(args)),
-              m_result(std::move(result))
+#  if defined(__SSSE3__)
+        // Each block reads 16 bytes, but only encodes the first 12
+        for (; i + 16 <= size; i += 12, out += 16)
         {
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out),
+                base64_encode_block(_mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes + i))));
         }
+#  endif
 
-        explicit operator bool() const noexcept
+        for (; i + 3 <= size; i += 3, out += 4)
         {
-            return m_result.has_value() && packed_func_base<Args...>::operator bool();
+            const uint32_t triple = (uint32_t{ bytes[i] } << 16U)
+                | (uint32_t{ bytes[i + 1] } << 8U) | uint32_t{ bytes[i + 2] };
+
+            out[0] = base64_alphabet[(triple >> 18U) & 0x3FU];
+            out[1] = base64_alphabet[(triple >> 12U) & 0x3FU];
+            out[2] = base64_alphabet[(triple >> 6U) & 0x3FU];
+            out[3] = base64_alphabet[triple & 0x3FU];
         }
 
-        const R& get_result() const
+        if (const auto remaining = size - i; remaining != 0)
         {
-            if (!static_cast<bool>(*this))
+            uint32_t triple = uint32_t{ bytes[i] } << 16U;
+
+            if (remaining == 2)
             {
-                // throws exception based on except_type
-                this->throw_ex();
+                triple |= uint32_t{ bytes[i + 1] } << 8U;
             }
 
-            return m_result.value();
+            out[0] = base64_alphabet[(triple >> 18U) & 0x3FU];
+            out[1] = base64_alphabet[(triple >> 12U) & 0x3FU];
+            out[2] = (remaining == 2) ? base64_alphabet[(triple >> 6U) & 0x3FU] : '=';
+            out[3] = '=';
+        }
+    }
+
+    [[nodiscard]] inline size_t base64_padding(const std::string_view text) noexcept
+    {
+        const auto last = text.find_last_not_of('=');
+        return (last == std::string_view::npos) ? text.size() : text.size() - last - 1;
+    }
+
+    ///@brief Returns the number of bytes encoded by padded base64 text, or std::nullopt if the
+    ///text cannot be base64
+    [[nodiscard]] inline std::optional<size_t> base64_decoded_size(
+        const std::string_view text) noexcept
+    {
+        const auto padding = base64_padding(text);
+
+        if (text.size() % 4 != 0 || padding > 2)
+        {
+            return std::nullopt;
         }
 
-        void set_result(const R& value) & noexcept(std::is_nothrow_copy_assignable_v<R>)
+        return text.size() / 4 * 3 - padding;
+    }
+
+    ///@brief Decodes padded base64 text
+    ///
+    ///@param text Text to decode, already checked by base64_decoded_size
+    ///@param out Destination, which must hold base64_decoded_size(text) bytes
+    ///@return bool False if the text contains characters outside of the base64 alphabet
+    [[nodiscard]] inline bool base64_decode(const std::string_view text, void* out) noexcept
+    {
+        auto* bytes = static_cast<uint8_t*>(out);
+        const auto padding = base64_padding(text);
+        const auto full_size = text.size() - (padding == 0 ? 0 : 4);
+        size_t i = 0;
+
+#  if defined(__SSSE3__)
+        // Each block writes 16 bytes, but only decodes 12, so blocks stop while 16 bytes are left
+        for (; i + 24 <= full_size; i += 16, bytes += 12)
         {
-            m_result = value;
+            if (!base64_decode_block(text.data() + i, bytes))
+            {
+                return false;
+            }
         }
+#  endif
 
-        void set_result(R&& value) & noexcept(std::is_nothrow_move_assignable_v<R>)
+        for (; i < full_size; i += 4, bytes += 3)
         {
-            m_result = std::move(value);
+            const auto c0 = base64_lookup[static_cast<uint8_t>(text[i])];
+            const auto c1 = base64_lookup[static_cast<uint8_t>(text[i + 1])];
+            const auto c2 = base64_lookup[static_cast<uint8_t>(text[i + 2])];
+            const auto c3 = base64_lookup[static_cast<uint8_t>(text[i + 3])];
+
+            // Valid characters map to 0-63, so the high bit flags an invalid one
+            if (((c0 | c1 | c2 | c3) & 0x80U) != 0)
+            {
+                return false;
+            }
+
+            const auto quad = (uint32_t{ c0 } << 18U) | (uint32_t{ c1 } << 12U)
+                | (uint32_t{ c2 } << 6U) | uint32_t{ c3 };
+
+            bytes[0] = static_cast<uint8_t>(quad >> 16U);
+            bytes[1] = static_cast<uint8_t>(quad >> 8U);
+            bytes[2] = static_cast<uint8_t>(quad);
         }
 
-        void clear_result() & noexcept { m_result.reset(); }
+        if (padding != 0)
+        {
+            const auto tail = text.substr(full_size);
+            const auto c0 = base64_lookup[static_cast<uint8_t>(tail[0])];
+            const auto c1 = base64_lookup[static_cast<uint8_t>(tail[1])];
+            const uint8_t c2 = (padding == 1) ? base64_lookup[static_cast<uint8_t>(tail[2])] : 0U;
 
-    private:
-        std::optional<result_t> m_result{};
+            if (((c0 | c1 | c2) & 0x80U) != 0)
+            {
+                return false;
+            }
+
+            bytes[0] = static_cast<uint8_t>((c0 << 2U) | (c1 >> 4U));
+
+            if (padding == 1)
+            {
+                bytes[1] = static_cast<uint8_t>((c1 << 4U) | (c2 >> 2U));
+            }
+        }
+
+        return true;
+    }
+
+    template<typename C, typename = void>
+    struct has_reserve : std::false_type {};
+
+    template<typename C>
+    struct has_reserve<C, std::void_t<decltype(std::declval<C&>().reserve(size_t{}))>> :
+        std::true_type
+    {
     };
 
-    template<typename... Args>
-    class packed_func<void, Args...> final : public packed_func_base<Args...>
+    template<typename C>
+    void reserve_if_able(C& container, [[maybe_unused]] const size_t size)
     {
-    public:
-        using result_t = void;
-        using typename packed_func_base<Args...>::args_t;
-        using packed_func_base<Args...>::packed_func_base;
-        using packed_func_base<Args...>::operator bool;
+        if constexpr (has_reserve<C>::value)
+        {
+            container.reserve(size);
+        }
+    }
 
-        void get_result() const
+    // Inserting with an end() hint is amortized constant when elements arrive in sorted order,
+    // which is always the case for ordered containers serialized by rpc.hpp.
+    // A unique-key container that does not grow was sent a duplicate key, which a well-formed
+    // message never contains, so it is rejected rather than silently dropped
+    template<typename C, typename... Args>
+    void emplace_assoc(C& container, Args&&... args)
+    {
+        const auto prev_size = container.size();
+        container.emplace_hint(container.end(), std::forward<Args>(args)...);
+
+        if (container.size() == prev_size)
         {
-            if (!static_cast<bool>(*this))
+            throw deserialization_error("Duplicate key in associative container");
+        }
+    }
+
+    template<typename T>
+    struct type_tag
+    {
+        using type = T;
+    };
+
+    template<typename V, typename F, size_t... Is>
+    [[nodiscard]] V make_variant(
+        const size_t index, const F& make_alt, [[maybe_unused]] std::index_sequence<Is...> iseq)
+    {
+        std::optional<V> result{};
+
+        std::ignore = ((index == Is
+                               ? (result.emplace(std::in_place_index<Is>,
+                                      make_alt(type_tag<std::variant_alternative_t<Is, V>>{})),
+                                   true)
+                               : false)
+            || ...);
+
+        if (!result.has_value())
+        {
+            throw function_mismatch("Variant index out of range");
+        }
+
+        return std::move(result).value();
+    }
+
+    ///@brief Constructs the alternative of variant V at a runtime index
+    ///
+    ///@param index Index of the alternative to construct
+    ///@param make_alt Callable taking a type_tag<Alt> and returning the alternative's value
+    template<typename V, typename F>
+    [[nodiscard]] V make_variant(const size_t index, const F& make_alt)
+    {
+        return make_variant<V>(
+            index, make_alt, std::make_index_sequence<std::variant_size_v<V>>());
+    }
+
+    template<typename F, typename... Ts, size_t... Is>
+    constexpr void for_each_tuple(const std::tuple<Ts...>& tuple, const F& func,
+        [[maybe_unused]] std::index_sequence<Is...> iseq)
+    {
+        using expander = int[];
+        std::ignore = expander{ 0, ((void)func(std::get<Is>(tuple)), 0)... };
+    }
+
+    template<typename F, typename... Ts>
+    constexpr void for_each_tuple(const std::tuple<Ts...>& tuple, const F& func)
+    {
+        for_each_tuple(tuple, func, std::make_index_sequence<sizeof...(Ts)>());
+    }
+
+    template<typename F, typename... Ts, size_t... Is>
+    constexpr void for_each_tuple(std::tuple<Ts...>& tuple, const F& func,
+                                  [[maybe_unused]] std::index_sequence<Is...> iseq)
+    {
+        using expander = int[];
+        std::ignore = expander{ 0, ((void)func(std::get<Is>(tuple)), 0)... };
+    }
+
+    template<typename F, typename... Ts>
+    constexpr void for_each_tuple(std::tuple<Ts...>& tuple, const F& func)
+    {
+        for_each_tuple(tuple, func, std::make_index_sequence<sizeof...(Ts)>());
+    }
+
+    // Aggregates described by RPC_HPP_REFLECT
+    template<typename T, typename = void>
+    struct is_reflected : std::false_type {};
+
+    template<typename T>
+    struct is_reflected<T, std::void_t<decltype(rpc_hpp_fields(std::declval<T&>()))>> :
+        std::true_type
+    {
+    };
+
+    template<typename T>
+    inline constexpr bool is_reflected_v = is_reflected<T>::value;
+
+    template<size_t N>
+    [[nodiscard]] constexpr std::array<std::string_view, N> split_field_names(
+        std::string_view names) noexcept
+    {
+        std::array<std::string_view, N> result{};
+
+        for (auto& name : result)
+        {
+            const auto comma = names.find(',');
+            name = names.substr(0, comma);
+            names = (comma == std::string_view::npos) ? std::string_view{}
+                                                      : names.substr(comma + 1);
+
+            while (!name.empty() && name.front() == ' ')
             {
-                // throws exception based on except_type
-                this->throw_ex();
+                name.remove_prefix(1);
+            }
+
+            while (!name.empty() && name.back() == ' ')
+            {
+                name.remove_suffix(1);
             }
         }
-    };
 
-    template<typename Adapter>
-    struct serial_adapter_base
+        return result;
+    }
+
+    template<typename T>
+    inline constexpr size_t field_count_v =
+        std::tuple_size_v<decltype(rpc_hpp_fields(std::declval<T&>()))>;
+
+    template<typename T>
+    inline constexpr auto field_names_v =
+        split_field_names<field_count_v<T>>(rpc_hpp_field_names(static_cast<const T*>(nullptr)));
+
+    ///@brief Calls func(name, field) for each field of a reflected aggregate, in declaration order
+    template<typename T, typename F>
+    void for_each_field(T& val, const F& func)
     {
-        using serial_t = typename adapters::serial_traits<Adapter>::serial_t;
-        using bytes_t = typename adapters::serial_traits<Adapter>::bytes_t;
+        auto fields = rpc_hpp_fields(val);
+        size_t index = 0;
 
-        static std::optional<serial_t> from_bytes(bytes_t&& bytes) = delete;
-        static bytes_t to_bytes(serial_t&& serial_obj) = delete;
-        static serial_t empty_object() = delete;
+        for_each_tuple(fields,
+            [&func, &index](auto& field)
+            { func(field_names_v<std::remove_cv_t<T>>[index++], field); });
+    }
 
-        template<typename R, typename... Args>
-        static serial_t serialize_pack(const packed_func<R, Args...>& pack) = delete;
+#  if defined(RPC_HPP_CLIENT_IMPL)
+    // Allows passing in string literals
+    template<typename T>
+    struct decay_str
+    {
+        static_assert(!std::is_pointer_v<std::remove_cv_t<std::remove_reference_t<T>>>,
+            "Pointer parameters are not allowed");
 
-        template<typename R, typename... Args>
-        static packed_func<R, Args...> deserialize_pack(const serial_t& serial_obj) = delete;
+        static_assert(!std::is_array_v<std::remove_cv_t<std::remove_reference_t<T>>>,
+            "C-style array parameters are not allowed");
 
-        static std::string get_func_name(const serial_t& serial_obj) = delete;
-        static rpc_exception extract_exception(const serial_t& serial_obj) = delete;
-        static void set_exception(serial_t& serial_obj, const rpc_exception& ex) = delete;
+        using type = T;
     };
-#endif
-} // namespace detail
 
-#if defined(RPC_HPP_SERVER_IMPL) || defined(RPC_HPP_MODULE_IMPL)
-///@brief Namespace containing functions and classes only relevant to "server-side" implentations
-///
-///@note Is only compiled by defining either @ref RPC_HPP_SERVER_IMPL AND/OR @ref RPC_HPP_MODULE_IMPL
-inline namespace server
-{
-    ///@brief Class defining an interface for serving functions via RPC
-    ///
-    ///@tparam Serial serial_adapter type that controls how objects are serialized/deserialized
-    template<typename Serial>
-    class server_interface
+    template<>
+    struct decay_str<const char*>
     {
-    public:
-        using adapter_t = Serial;
+        using type = const std::string&;
+    };
 
-        server_interface() noexcept = default;
+    template<>
+    struct decay_str<const char*&>
+    {
+        using type = const std::string&;
+    };
 
-        // Prevent copying
-        server_interface(const server_interface&) = delete;
-        server_interface& operator=(const server_interface&) = delete;
+    template<>
+    struct decay_str<const char* const&>
+    {
+        using type = const std::string&;
+    };
+
+    template<size_t N>
+    struct decay_str<const char (&)[N]>
+    {
+        using type = const std::string&;
+    };
+
+    template<typename T>
+    using decay_str_t = typename decay_str<T>::type;
+
+    template<typename... Args, size_t... Is>
+    constexpr void tuple_bind(
+        const std::tuple<std::remove_cv_t<std::remove_reference_t<decay_str_t<Args>>>...>& src,
+        std::index_sequence<Is...>, Args&&... dest)
+    {
+        using expander = int[];
+        std::ignore = expander{ 0,
+            (
+                (void)[](auto&& x, auto&& y) {
+                    if constexpr (
+                        std::is_reference_v<
+                            decltype(x)> && !std::is_const_v<std::remove_reference_t<decltype(x)>> && !std::is_pointer_v<std::remove_reference_t<decltype(x)>>)
+                    {
+                        x = std::forward<decltype(y)>(y);
+                    }
+                }(dest, std::get<Is>(src)),
+                0)... };
+    }
+
+    template<typename... Args>
+    constexpr void tuple_bind(
+        const std::tuple<std::remove_cv_t<std::remove_reference_t<decay_str_t<Args>>>...>& src,
+        Args&&... dest)
+    {
+        tuple_bind(src, std::make_index_sequence<sizeof...(Args)>(), std::forward<Args>(dest)...);
+    }
+#  endif
+
+    // Throws the exception class matching type
+    [[noreturn]] inline void throw_exception(const exception_type type, const std::string& mesg)
+    {
+        switch (type)
+        {
+            case exception_type::func_not_found:
+                throw function_not_found(mesg);
+
+            case exception_type::remote_exec:
+                throw remote_exec_error(mesg);
+
+            case exception_type::serialization:
+                throw serialization_error(mesg);
+
+            case exception_type::deserialization:
+                throw deserialization_error(mesg);
+
+            case exception_type::signature_mismatch:
+                throw function_mismatch(mesg);
+
+            case exception_type::client_send:
+                throw client_send_error(mesg);
+
+            case exception_type::client_receive:
+                throw client_receive_error(mesg);
+
+            case exception_type::server_send:
+                throw server_send_error(mesg);
+
+            case exception_type::server_receive:
+                throw server_receive_error(mesg);
+
+            case exception_type::none:
+            default:
+                throw rpc_exception(mesg, exception_type::none);
+        }
+    }
+
+    template<typename... Args>
+    class packed_func_base
+    {
+    public:
+        using args_t = std::tuple<std::remove_cv_t<std::remove_reference_t<Args>>...>;
+
+        packed_func_base() = delete;
+        packed_func_base(std::string func_name, args_t args) noexcept
+            : m_func_name(std::move(func_name)), m_args(std::move(args))
+        {
+        }
+
+        explicit operator bool() const noexcept { return m_except_type == exception_type::none; }
+        const std::string& get_err_mesg() const noexcept { return m_err_mesg; }
+        const std::string& get_func_name() const noexcept { return m_func_name; }
+        exception_type get_except_type() const noexcept { return m_except_type; }
+
+        void set_exception(std::string&& mesg, const exception_type type) & noexcept
+        {
+            m_except_type = type;
+            m_err_mesg = std::move(mesg);
+        }
+
+        const args_t& get_args() const noexcept { return m_args; }
+        args_t& get_args() noexcept { return m_args; }
+
+    protected:
+        ~packed_func_base() noexcept = default;
+        packed_func_base(const packed_func_base&) = default;
+        packed_func_base(packed_func_base&&) noexcept = default;
+        packed_func_base& operator=(const packed_func_base&) & = default;
+        packed_func_base& operator=(packed_func_base&&) & noexcept = default;
+
+        [[noreturn]] void throw_ex() const noexcept(false)
+        {
+            throw_exception(m_except_type, m_err_mesg);
+        }
+
+    private:
+        exception_type m_except_type{ exception_type::none };
+        std::string m_func_name;
+        std::string m_err_mesg{};
+        args_t m_args;
+    };
+
+    template<typename R, typename... Args>
+    class packed_func final : public packed_func_base<Args...>
+    {
+    public:
+        using result_t = R;
+        using typename packed_func_base<Args...>::args_t;
+
+        packed_func(std::string func_name, std::optional<result_t> result, args_t args) noexcept
+            : packed_func_base<Args...>(std::move(func_name), std::move(args)),
+              m_result(std::move(result))
+        {
+        }
+
+        explicit operator bool() const noexcept
+        {
+            return m_result.has_value() && packed_func_base<Args...>::operator bool();
+        }
+
+        const R& get_result() const
+        {
+            if (!static_cast<bool>(*this))
+            {
+                // throws exception based on except_type
+                this->throw_ex();
+            }
+
+            return m_result.value();
+        }
+
+        void set_result(const R& value) & noexcept(std::is_nothrow_copy_assignable_v<R>)
+        {
+            m_result = value;
+        }
+
+        void set_result(R&& value) & noexcept(std::is_nothrow_move_assignable_v<R>)
+        {
+            m_result = std::move(value);
+        }
+
+        void clear_result() & noexcept { m_result.reset(); }
+
+    private:
+        std::optional<result_t> m_result{};
+    };
+
+    template<typename... Args>
+    class packed_func<void, Args...> final : public packed_func_base<Args...>
+    {
+    public:
+        using result_t = void;
+        using typename packed_func_base<Args...>::args_t;
+        using packed_func_base<Args...>::packed_func_base;
+        using packed_func_base<Args...>::operator bool;
+
+        void get_result() const
+        {
+            if (!static_cast<bool>(*this))
+            {
+                // throws exception based on except_type
+                this->throw_ex();
+            }
+        }
+    };
+
+    // Top-level fields of a message read straight from its bytes, which may arrive in any order
+    template<typename R, typename... Args>
+    struct streamed_pack
+    {
+        using args_t = typename packed_func<R, Args...>::args_t;
+        using result_t = std::conditional_t<std::is_void_v<R>, bool, R>;
+
+        [[nodiscard]] packed_func<R, Args...> finish() &&
+        {
+            if (!args.has_value())
+            {
+                // Only replies reporting an error can omit the arguments
+                if (except_type.has_value() && except_type.value() != exception_type::none)
+                {
+                    throw_exception(except_type.value(), err_mesg);
+                }
+
+                throw deserialization_error("Message does not contain any arguments");
+            }
+
+            if constexpr (std::is_void_v<R>)
+            {
+                packed_func<void, Args...> pack(std::move(func_name), std::move(args).value());
+
+                if (except_type.has_value())
+                {
+                    pack.set_exception(std::move(err_mesg), except_type.value());
+                }
+
+                return pack;
+            }
+            else
+            {
+                // A null result is a valid value for std::optional
+                if (result.has_value() && (!is_optional_v<R> || !except_type.has_value()))
+                {
+                    return packed_func<R, Args...>(
+                        std::move(func_name), std::move(result), std::move(args).value());
+                }
+
+                packed_func<R, Args...> pack(
+                    std::move(func_name), std::nullopt, std::move(args).value());
+
+                if (except_type.has_value())
+                {
+                    pack.set_exception(std::move(err_mesg), except_type.value());
+                }
+
+                return pack;
+            }
+        }
+
+        std::string func_name{};
+        std::optional<args_t> args{};
+        std::optional<result_t> result{};
+        std::optional<exception_type> except_type{};
+        std::string err_mesg{};
+    };
+
+    // Positional layout the JSON-family adapters can write instead of an object with named fields:
+    // [version, flags, func_name, result, args...]. If the error flag is set, the result slot holds
+    // [except_type, err_mesg] instead, and replies that only report an error may omit the arguments
+    struct compact_envelope
+    {
+        static constexpr int version = 1;
+        static constexpr unsigned error_flag = 1U;
+
+        static constexpr size_t version_index = 0;
+        static constexpr size_t flags_index = 1;
+        static constexpr size_t func_name_index = 2;
+        static constexpr size_t result_index = 3;
+        static constexpr size_t args_index = 4;
+
+        [[nodiscard]] static constexpr bool has_error(const unsigned flags) noexcept
+        {
+            return (flags & error_flag) != 0;
+        }
+    };
+
+    // Adapters may also provide peek_func_name(bytes_t&) -> std::optional<std::string> and
+    // parse_pack<R, Args...>(bytes_t&) to read messages straight from their bytes into the
+    // argument tuple (see has_typed_parse). Serial objects are then only built for replies. The
+    // bytes may be taken by const reference, or modified in place (e.g. padded) without changing
+    // the message
+    template<typename Adapter>
+    struct serial_adapter_base
+    {
+        using serial_t = typename adapters::serial_traits<Adapter>::serial_t;
+        using bytes_t = typename adapters::serial_traits<Adapter>::bytes_t;
+
+        ///@brief Guard held while a request is processed, allowing adapters to reuse per-thread storage
+        /// for the objects created in the meantime (does nothing unless the adapter overrides it)
+        struct request_scope
+        {
+        };
+
+        static std::optional<serial_t> from_bytes(bytes_t&& bytes) = delete;
+        static bytes_t to_bytes(serial_t&& serial_obj) = delete;
+        static serial_t empty_object() = delete;
+
+        template<typename R, typename... Args>
+        static serial_t serialize_pack(const packed_func<R, Args...>& pack) = delete;
+
+        template<typename R, typename... Args>
+        static packed_func<R, Args...> deserialize_pack(const serial_t& serial_obj) = delete;
+
+        static std::string get_func_name(const serial_t& serial_obj) = delete;
+        static rpc_exception extract_exception(const serial_t& serial_obj) = delete;
+        static void set_exception(serial_t& serial_obj, const rpc_exception& ex) = delete;
+    };
+
+    template<typename Adapter, typename = void>
+    struct has_typed_parse : std::false_type
+    {
+    };
+
+    template<typename Adapter>
+    struct has_typed_parse<Adapter,
+        std::void_t<decltype(Adapter::peek_func_name(
+            std::declval<typename Adapter::bytes_t&>()))>> : std::true_type
+    {
+    };
+
+    template<typename Adapter>
+    inline constexpr bool has_typed_parse_v = has_typed_parse<Adapter>::value;
+
+    // Adapters whose messages can be recognized by their first byte provide
+    // may_start_with(uint8_t) -> bool, letting multi_server pick the adapter for a request
+    template<typename Adapter, typename = void>
+    struct has_format_sniffing : std::false_type
+    {
+    };
+
+    template<typename Adapter>
+    struct has_format_sniffing<Adapter,
+        std::void_t<decltype(Adapter::may_start_with(std::declval<uint8_t>()))>> : std::true_type
+    {
+    };
+
+    template<typename Adapter>
+    [[nodiscard]] bool may_start_with(const uint8_t byte)
+    {
+        if constexpr (has_format_sniffing<Adapter>::value)
+        {
+            return Adapter::may_start_with(byte);
+        }
+        else
+        {
+            // Formats that cannot be recognized accept anything
+            return true;
+        }
+    }
+
+    // Adapters may also provide to_bytes(serial_t&&, bytes_t& out), writing the message into a
+    // caller-owned buffer so that its capacity is reused
+    template<typename Adapter, typename = void>
+    struct has_to_bytes_into : std::false_type
+    {
+    };
+
+    template<typename Adapter>
+    struct has_to_bytes_into<Adapter,
+        std::void_t<decltype(Adapter::to_bytes(std::declval<typename Adapter::serial_t&&>(),
+            std::declval<typename Adapter::bytes_t&>()))>> : std::true_type
+    {
+    };
+
+    template<typename Adapter>
+    void write_bytes(typename Adapter::serial_t&& serial_obj, typename Adapter::bytes_t& out)
+    {
+        if constexpr (has_to_bytes_into<Adapter>::value)
+        {
+            Adapter::to_bytes(std::move(serial_obj), out);
+        }
+        else
+        {
+            out = Adapter::to_bytes(std::move(serial_obj));
+        }
+    }
+
+    // Adapters whose serial objects own their message's buffer may also provide
+    // recycle(serial_t&&), giving the buffer back to the thread's buffer_pool once done with
+    template<typename Adapter, typename = void>
+    struct has_recycle : std::false_type
+    {
+    };
+
+    template<typename Adapter>
+    struct has_recycle<Adapter,
+        std::void_t<decltype(Adapter::recycle(std::declval<typename Adapter::serial_t&&>()))>> :
+        std::true_type
+    {
+    };
+
+    template<typename Adapter>
+    void recycle([[maybe_unused]] typename Adapter::serial_t&& serial_obj) noexcept
+    {
+        if constexpr (has_recycle<Adapter>::value)
+        {
+            Adapter::recycle(std::move(serial_obj));
+        }
+    }
+
+    // Initial capacity for the buffers of a function's messages, learned from the sizes of its
+    // previous messages on this thread. Hints grow to a larger size at once, but shrink slowly so
+    // that one small message does not make the next large one reallocate. They are keyed by a hash
+    // of the name, as a collision only costs a worse guess
+    class message_size_hints
+    {
+    public:
+        static constexpr size_t default_hint = 256;
+
+        [[nodiscard]] static size_t get(const std::string_view func_name)
+        {
+            const auto& hints = table();
+            const auto it = hints.find(std::hash<std::string_view>{}(func_name));
+            return it != hints.end() ? it->second : default_hint;
+        }
+
+        static void update(const std::string_view func_name, const size_t size)
+        {
+            auto& hint =
+                table().try_emplace(std::hash<std::string_view>{}(func_name), size).first->second;
+
+            const size_t decayed = hint - hint / 8;
+            hint = size > decayed ? size : decayed;
+        }
+
+    private:
+        [[nodiscard]] static std::unordered_map<size_t, size_t>& table() noexcept
+        {
+            thread_local std::unordered_map<size_t, size_t> hints{};
+            return hints;
+        }
+    };
+
+    // First byte of a JSON text message (an object or compact_envelope array, possibly preceded by
+    // whitespace)
+    [[nodiscard]] constexpr bool is_json_text_start(const uint8_t byte) noexcept
+    {
+        return byte == '{' || byte == '[' || byte == ' ' || byte == '\t' || byte == '\n'
+            || byte == '\r';
+    }
+
+#  if defined(RPC_HPP_SERVER_IMPL) && defined(RPC_HPP_ENABLE_SERVER_CACHE)
+
+    template<typename F, typename T>
+    struct has_fingerprint
+    {
+    private:
+        template<typename U>
+        static constexpr auto check(U*) noexcept -> decltype(
+            fingerprint(std::declval<F&>(), std::declval<const U&>()), std::true_type{});
+
+        template<typename>
+        static constexpr std::false_type check(...) noexcept;
+
+        using type = decltype(check<T>(nullptr));
+
+    public:
+        static constexpr bool value = type::value;
+    };
+
+    // Builds a canonical byte key from typed arguments so that the server cache does not depend
+    // on the wire format of any particular serial adapter
+    class arg_fingerprint
+    {
+    public:
+        template<typename T>
+        void write(const T& val)
+        {
+            using no_ref_t = std::remove_cv_t<std::remove_reference_t<T>>;
+
+            if constexpr (std::is_arithmetic_v<no_ref_t> || std::is_enum_v<no_ref_t>)
+            {
+                append(&val, sizeof(no_ref_t));
+            }
+            else if constexpr (std::is_same_v<no_ref_t, std::string>)
+            {
+                write_size(val.size());
+                append(val.data(), val.size());
+            }
+            else if constexpr (is_container_v<no_ref_t>)
+            {
+                using value_t = typename no_ref_t::value_type;
+
+                write_size(val.size());
+
+                if constexpr (std::is_arithmetic_v<value_t> && has_data<no_ref_t>::value)
+                {
+                    append(val.data(), val.size() * sizeof(value_t));
+                }
+                else
+                {
+                    for (const auto& elem : val)
+                    {
+                        write(elem);
+                    }
+                }
+            }
+            else if constexpr (is_tuple_v<no_ref_t>)
+            {
+                for_each_tuple(val, [this](const auto& elem) { write(elem); });
+            }
+            else if constexpr (is_pair_v<no_ref_t>)
+            {
+                write(val.first);
+                write(val.second);
+            }
+            else if constexpr (is_optional_v<no_ref_t>)
+            {
+                write(val.has_value());
+
+                if (val.has_value())
+                {
+                    write(*val);
+                }
+            }
+            else if constexpr (is_variant_v<no_ref_t>)
+            {
+                write_size(val.index());
+                std::visit([this](const auto& alt) { write(alt); }, val);
+            }
+            else if constexpr (is_reflected_v<no_ref_t>)
+            {
+                for_each_field(val, [this](std::string_view, const auto& field) { write(field); });
+            }
+            else
+            {
+                static_assert(has_fingerprint<arg_fingerprint, no_ref_t>::value,
+                    "Cached function arguments must be arithmetic, strings, containers, or provide "
+                    "a 'fingerprint(F&, const T&)' overload");
+
+                fingerprint(*this, val);
+            }
+        }
+
+        [[nodiscard]] std::string release() && noexcept { return std::move(m_bytes); }
+
+    private:
+        void append(const void* data, const size_t size)
+        {
+            const auto old_size = m_bytes.size();
+            m_bytes.resize(old_size + size);
+
+            if (size != 0)
+            {
+                memcpy(&m_bytes[old_size], data, size);
+            }
+        }
+
+        void write_size(const size_t size)
+        {
+            const auto size64 = static_cast<uint64_t>(size);
+            append(&size64, sizeof(size64));
+        }
+
+        std::string m_bytes{};
+    };
+
+    // FNV-1a hash of the argument types, so that bindings sharing a name and return type but taking
+    // different arguments never share keys (stable across runs, unlike std::type_info::hash_code)
+    template<typename... Args>
+    [[nodiscard]] uint64_t args_type_tag() noexcept
+    {
+        static const uint64_t tag = []() noexcept
+        {
+            uint64_t hash = 14'695'981'039'346'656'037ULL;
+
+            for (const char* name = typeid(std::tuple<Args...>).name(); *name != '\0'; ++name)
+            {
+                hash = (hash ^ static_cast<uint8_t>(*name)) * 1'099'511'628'211ULL;
+            }
+
+            return hash;
+        }();
+
+        return tag;
+    }
+
+    template<typename... Args>
+    [[nodiscard]] std::string make_fingerprint(const std::tuple<Args...>& args)
+    {
+        arg_fingerprint fp{};
+        fp.write(args_type_tag<Args...>());
+        fp.write(args);
+        return std::move(fp).release();
+    }
+
+    struct func_cache_stats
+    {
+        size_t hits{};
+        size_t misses{};
+        size_t inserts{};
+        size_t evictions{};
+        size_t entries{};
+        size_t mem_size{};
+    };
+
+    // Counters may be shared by several threads (see func_cache_base::local_counters), but are only
+    // read for statistics, so relaxed increments are enough. Each is kept on its own cache line
+    class alignas(64) cache_counters
+    {
+    public:
+        void add_hit() noexcept { m_hits.fetch_add(1, std::memory_order_relaxed); }
+        void add_miss() noexcept { m_misses.fetch_add(1, std::memory_order_relaxed); }
+        void add_insert() noexcept { m_inserts.fetch_add(1, std::memory_order_relaxed); }
+
+        void add_evictions(const size_t count) noexcept
+        {
+            m_evictions.fetch_add(count, std::memory_order_relaxed);
+        }
+
+        void sum_into(func_cache_stats& stats) const noexcept
+        {
+            stats.hits += m_hits.load(std::memory_order_relaxed);
+            stats.misses += m_misses.load(std::memory_order_relaxed);
+            stats.inserts += m_inserts.load(std::memory_order_relaxed);
+            stats.evictions += m_evictions.load(std::memory_order_relaxed);
+        }
+
+    private:
+        std::atomic<size_t> m_hits{ 0 };
+        std::atomic<size_t> m_misses{ 0 };
+        std::atomic<size_t> m_inserts{ 0 };
+        std::atomic<size_t> m_evictions{ 0 };
+    };
+
+    // Rough estimate of the heap and inline memory used by a cached value
+    template<typename T>
+    [[nodiscard]] size_t approx_mem_size(const T& val) noexcept
+    {
+        if constexpr (std::is_same_v<T, std::string>)
+        {
+            return sizeof(T) + val.capacity();
+        }
+        else if constexpr (is_container_v<T>)
+        {
+            using value_t = typename T::value_type;
+
+            if constexpr (std::is_arithmetic_v<value_t>)
+            {
+                return sizeof(T) + val.size() * sizeof(value_t);
+            }
+            else
+            {
+                size_t size = sizeof(T);
+
+                for (const auto& elem : val)
+                {
+                    size += approx_mem_size(elem);
+                }
+
+                return size;
+            }
+        }
+        else
+        {
+            return sizeof(T);
+        }
+    }
+
+    class func_cache_base
+    {
+    public:
+        func_cache_base() = default;
+        func_cache_base(const func_cache_base&) = delete;
+        func_cache_base& operator=(const func_cache_base&) = delete;
+        virtual ~func_cache_base() noexcept = default;
+
+        virtual void clear() = 0;
+        [[nodiscard]] virtual func_cache_stats stats() const = 0;
+
+        // Gets the counters for the calling thread. Threads are spread over a fixed number of
+        // stripes, so that counting neither allocates per thread nor contends on a single line
+        [[nodiscard]] cache_counters& local_counters() noexcept
+        {
+            return m_stripes[stripe_index()];
+        }
+
+    protected:
+        [[nodiscard]] func_cache_stats sum_counters() const noexcept
+        {
+            func_cache_stats stats{};
+
+            for (const auto& counters : m_stripes)
+            {
+                counters.sum_into(stats);
+            }
+
+            return stats;
+        }
+
+    private:
+        static constexpr size_t num_stripes = 16;
+
+        [[nodiscard]] static size_t stripe_index() noexcept
+        {
+            static std::atomic<size_t> next_index{ 0 };
+            thread_local const size_t index =
+                next_index.fetch_add(1, std::memory_order_relaxed) % num_stripes;
+
+            return index;
+        }
+
+        std::array<cache_counters, num_stripes> m_stripes{};
+    };
+
+    // The map may only be accessed while holding mtx. Entry count and memory size are kept up to
+    // date as the map changes, so that reading statistics never walks (or locks) the map
+    template<typename Val>
+    struct func_cache final : func_cache_base
+    {
+        func_cache() noexcept { recount(); }
+
+        void clear() override
+        {
+            std::lock_guard<std::mutex> lock{ mtx };
+            local_counters().add_evictions(map.size());
+            map.clear();
+            recount();
+        }
+
+        [[nodiscard]] func_cache_stats stats() const override
+        {
+            auto stats = sum_counters();
+            stats.entries = m_entries.load(std::memory_order_relaxed);
+            stats.mem_size = m_mem_size.load(std::memory_order_relaxed);
+            return stats;
+        }
+
+        // Stores val for key, replacing any cached value (mtx must be held)
+        void insert_or_assign(std::string&& key, const Val& val)
+        {
+            if (const auto it = map.find(key); it != map.end())
+            {
+                m_entries_mem_size -= entry_mem_size(*it);
+                it->second = val;
+                m_entries_mem_size += entry_mem_size(*it);
+            }
+            else
+            {
+                m_entries_mem_size += entry_mem_size(*map.emplace(std::move(key), val).first);
+            }
+
+            update_totals();
+        }
+
+        // Stores val for key unless a value is already cached (mtx must be held)
+        bool try_emplace(std::string&& key, Val&& val)
+        {
+            const auto [it, inserted] = map.try_emplace(std::move(key), std::move(val));
+
+            if (inserted)
+            {
+                m_entries_mem_size += entry_mem_size(*it);
+                update_totals();
+            }
+
+            return inserted;
+        }
+
+        // Calls func with the map while holding mtx, recounting afterwards as func may change it
+        template<typename F>
+        decltype(auto) with_map(F&& func)
+        {
+            class recount_guard
+            {
+            public:
+                explicit recount_guard(func_cache& cache) noexcept : m_cache(cache) {}
+                recount_guard(const recount_guard&) = delete;
+                recount_guard& operator=(const recount_guard&) = delete;
+                ~recount_guard() noexcept { m_cache.recount(); }
+
+            private:
+                func_cache& m_cache;
+            };
+
+            std::lock_guard<std::mutex> lock{ mtx };
+            const recount_guard guard{ *this };
+            return std::forward<F>(func)(map);
+        }
+
+        // Recomputes the entry count and memory size from the whole map (mtx must be held)
+        void recount() noexcept
+        {
+            m_entries_mem_size = 0;
+
+            for (const auto& entry : map)
+            {
+                m_entries_mem_size += entry_mem_size(entry);
+            }
+
+            update_totals();
+        }
+
+        std::mutex mtx{};
+        std::unordered_map<std::string, Val> map{};
+
+    private:
+        // Approximate per-node overhead: next pointer and cached hash
+        static constexpr size_t node_overhead = sizeof(void*) + sizeof(size_t);
+
+        [[nodiscard]] static size_t entry_mem_size(
+            const typename std::unordered_map<std::string, Val>::value_type& entry) noexcept
+        {
+            return node_overhead + approx_mem_size(entry.first) + approx_mem_size(entry.second);
+        }
+
+        void update_totals() noexcept
+        {
+            m_entries.store(map.size(), std::memory_order_relaxed);
+            m_mem_size.store(sizeof(map) + map.bucket_count() * sizeof(void*) + m_entries_mem_size,
+                std::memory_order_relaxed);
+        }
+
+        size_t m_entries_mem_size{ 0 };
+        std::atomic<size_t> m_entries{ 0 };
+        std::atomic<size_t> m_mem_size{ 0 };
+    };
+
+    // Types whose values can be carried from one call's result into the next call's argument
+    template<typename T>
+    inline constexpr bool is_prefetch_candidate_v =
+        std::is_arithmetic_v<T> || std::is_same_v<T, std::string>;
+
+    // Connection the current thread is dispatching for (if any), used to learn call sequences
+    [[nodiscard]] inline std::optional<size_t>& current_connection() noexcept
+    {
+        thread_local std::optional<size_t> connection_id{};
+        return connection_id;
+    }
+
+    class connection_scope
+    {
+    public:
+        explicit connection_scope(const size_t connection_id) noexcept
+        {
+            current_connection() = connection_id;
+        }
+
+        connection_scope(const connection_scope&) = delete;
+        connection_scope& operator=(const connection_scope&) = delete;
+
+        ~connection_scope() noexcept { current_connection().reset(); }
+    };
+
+    // Learns which function results feed the arguments of subsequent calls on the same connection
+    // and makes speculative calls on a single background worker, only while the server is idle
+    class call_predictor
+    {
+    public:
+        call_predictor(const double min_confidence, const size_t min_samples)
+            : m_min_confidence(min_confidence), m_min_samples(min_samples),
+              m_worker([this] { run_worker(); })
+        {
+        }
+
+        call_predictor(const call_predictor&) = delete;
+        call_predictor& operator=(const call_predictor&) = delete;
+
+        ~call_predictor() noexcept
+        {
+            {
+                std::lock_guard<std::mutex> lock{ m_worker_mtx };
+                m_stop = true;
+            }
+
+            m_worker_cv.notify_one();
+            m_worker.join();
+        }
+
+        void observe_call(
+            const size_t connection_id, const std::string& func_name, const std::string& arg_key)
+        {
+            std::lock_guard<std::mutex> lock{ m_mtx };
+
+            for (const auto& [source, candidates] : m_connections[connection_id])
+            {
+                auto& stats = m_stats[source][func_name];
+                ++stats.trials;
+
+                if (candidates.find(arg_key) != candidates.end())
+                {
+                    ++stats.hits;
+                }
+            }
+        }
+
+        // Returns the functions likely to be called next with values from this result
+        [[nodiscard]] std::vector<std::string> observe_result(const size_t connection_id,
+            const std::string& func_name, std::unordered_set<std::string> candidates)
+        {
+            std::vector<std::string> likely_next{};
+            std::lock_guard<std::mutex> lock{ m_mtx };
+
+            m_connections[connection_id].insert_or_assign(func_name, std::move(candidates));
+
+            if (const auto it = m_stats.find(func_name); it != m_stats.end())
+            {
+                for (const auto& [target, stats] : it->second)
+                {
+                    if (stats.trials >= m_min_samples
+                        && static_cast<double>(stats.hits) / static_cast<double>(stats.trials)
+                            >= m_min_confidence)
+                    {
+                        likely_next.push_back(target);
+                    }
+                }
+            }
+
+            return likely_next;
+        }
+
+        void forget_connection(const size_t connection_id)
+        {
+            std::lock_guard<std::mutex> lock{ m_mtx };
+            m_connections.erase(connection_id);
+        }
+
+        // Called around every request the server dispatches
+        void begin_request() noexcept { m_active_requests.fetch_add(1, std::memory_order_relaxed); }
+
+        void end_request()
+        {
+            if (m_active_requests.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            {
+                std::lock_guard<std::mutex> lock{ m_worker_mtx };
+
+                if (m_busy)
+                {
+                    m_worker_cv.notify_one();
+                }
+            }
+        }
+
+        [[nodiscard]] bool idle()
+        {
+            std::lock_guard<std::mutex> lock{ m_worker_mtx };
+            return m_calls.empty() && !m_busy;
+        }
+
+        // Blocks until every posted call has finished
+        void wait_idle()
+        {
+            std::unique_lock<std::mutex> lock{ m_worker_mtx };
+            m_idle_cv.wait(lock, [this] { return m_calls.empty() && !m_busy; });
+        }
+
+        // Returns false (dropping the calls) if the worker is busy
+        bool try_post(std::vector<std::function<void()>>&& calls)
+        {
+            {
+                std::lock_guard<std::mutex> lock{ m_worker_mtx };
+
+                if (!m_calls.empty() || m_busy)
+                {
+                    return false;
+                }
+
+                m_calls = std::move(calls);
+            }
+
+            m_worker_cv.notify_one();
+            return true;
+        }
+
+    private:
+        struct transition_stats
+        {
+            size_t trials{};
+            size_t hits{};
+        };
+
+        void run_worker()
+        {
+            std::unique_lock<std::mutex> lock{ m_worker_mtx };
+
+            while (true)
+            {
+                m_worker_cv.wait(lock, [this] { return m_stop || !m_calls.empty(); });
+
+                if (m_stop)
+                {
+                    return;
+                }
+
+                auto calls = std::move(m_calls);
+                m_calls.clear();
+                m_busy = true;
+
+                for (const auto& call : calls)
+                {
+                    // Each call only starts once no request is being dispatched, so speculation
+                    // never delays requests waiting to start
+                    m_worker_cv.wait(lock,
+                        [this]
+                        { return m_stop || m_active_requests.load(std::memory_order_acquire) == 0; });
+
+                    if (m_stop)
+                    {
+                        return;
+                    }
+
+                    lock.unlock();
+
+                    try
+                    {
+                        call();
+                    }
+                    catch (...)
+                    {
+                        // Speculative work must never take down the server
+                    }
+
+                    lock.lock();
+                }
+
+                m_busy = false;
+                m_idle_cv.notify_all();
+            }
+        }
+
+        const double m_min_confidence;
+        const size_t m_min_samples;
+
+        std::mutex m_mtx{};
+        std::unordered_map<size_t, std::unordered_map<std::string, std::unordered_set<std::string>>>
+            m_connections{};
+        std::unordered_map<std::string, std::unordered_map<std::string, transition_stats>>
+            m_stats{};
+
+        std::atomic<size_t> m_active_requests{ 0 };
+        std::mutex m_worker_mtx{};
+        std::condition_variable m_worker_cv{};
+        std::condition_variable m_idle_cv{};
+        std::vector<std::function<void()>> m_calls{};
+        bool m_busy{ false };
+        bool m_stop{ false };
+        std::thread m_worker;
+    };
+
+    // Marks a request as in flight for the duration of its dispatch (if prefetching is enabled)
+    class active_request_scope
+    {
+    public:
+        explicit active_request_scope(call_predictor* const predictor) noexcept
+            : m_predictor(predictor)
+        {
+            if (m_predictor != nullptr)
+            {
+                m_predictor->begin_request();
+            }
+        }
+
+        active_request_scope(const active_request_scope&) = delete;
+        active_request_scope& operator=(const active_request_scope&) = delete;
+
+        ~active_request_scope() noexcept
+        {
+            if (m_predictor != nullptr)
+            {
+                try
+                {
+                    m_predictor->end_request();
+                }
+                catch (...)
+                {
+                    // Only fails to lock the mutex, so the worker waits for the next request instead
+                }
+            }
+        }
+
+    private:
+        call_predictor* const m_predictor;
+    };
+#  endif
+#endif
+} // namespace detail
+
+///@brief Pool of reusable byte buffers, grouped by capacity into power-of-two size classes
+///
+///@details Used by the server, client, and adapters so that, once warmed up, handling a request does not allocate any
+/// message buffers: messages are written into buffers taken from the pool (with a capacity learned from the previous
+/// messages of the same function), and buffers are given back once done with. Transports may use it for the buffers
+/// they receive into as well. Each thread has its own pool (see @ref local), so no locking is needed
+///@tparam Bytes Byte container (e.g. the bytes_t of a serial adapter). Containers that cannot reserve capacity (such as
+/// fixed-size buffers) are not pooled, they are simply created when acquired
+template<typename Bytes>
+class buffer_pool
+{
+public:
+    ///@brief Capacity of the smallest size class (smaller buffers are not kept)
+    static constexpr size_t min_capacity = 256;
+
+    ///@brief Number of size classes, each twice the capacity of the last (larger buffers are not kept)
+    static constexpr size_t num_classes = 13;
+
+    ///@brief Capacity of the largest size class
+    static constexpr size_t max_capacity = min_capacity << (num_classes - 1);
+
+    ///@brief Number of buffers kept per size class
+    static constexpr size_t max_per_class = 4;
+
+    buffer_pool()
+    {
+        // Releasing a buffer then never allocates
+        for (auto& free_list : m_classes)
+        {
+            free_list.reserve(max_per_class);
+        }
+    }
+
+    ///@brief Gets the pool for the calling thread
+    [[nodiscard]] static buffer_pool& local()
+    {
+        thread_local buffer_pool pool{};
+        return pool;
+    }
+
+    ///@brief Takes an empty buffer with at least the given capacity from the pool, or creates one if none fits
+    ///
+    ///@param capacity Minimum capacity
+    ///@return Bytes Empty buffer
+    [[nodiscard]] Bytes acquire(const size_t capacity)
+    {
+        if constexpr (detail::has_reserve<Bytes>::value)
+        {
+            for (size_t i = class_of(capacity); i < num_classes; ++i)
+            {
+                if (auto& free_list = m_classes[i]; !free_list.empty())
+                {
+                    Bytes buffer = std::move(free_list.back());
+                    free_list.pop_back();
+                    return buffer;
+                }
+            }
+
+            Bytes buffer{};
+
+            // Rounded up to the size class, so that the buffer can be reused for as large a message
+            buffer.reserve(capacity <= max_capacity ? class_capacity(class_of(capacity)) : capacity);
+            return buffer;
+        }
+        else
+        {
+            return Bytes{};
+        }
+    }
+
+    ///@brief Takes a buffer from the pool holding a copy of the range [first, last)
+    template<typename InputIt>
+    [[nodiscard]] Bytes acquire(const InputIt first, const InputIt last)
+    {
+        if constexpr (detail::has_reserve<Bytes>::value)
+        {
+            Bytes buffer = acquire(static_cast<size_t>(std::distance(first, last)));
+            buffer.insert(buffer.end(), first, last);
+            return buffer;
+        }
+        else
+        {
+            return Bytes(first, last);
+        }
+    }
+
+    ///@brief Gives a buffer back to the pool
+    ///
+    ///@note The buffer is freed instead if it is smaller than @ref min_capacity, larger than @ref max_capacity, or its
+    /// size class is full
+    void release(Bytes&& buffer) noexcept
+    {
+        if constexpr (detail::has_reserve<Bytes>::value)
+        {
+            const size_t capacity = buffer.capacity();
+
+            if (capacity < min_capacity || capacity > max_capacity)
+            {
+                return;
+            }
+
+            // The largest class the buffer can serve
+            size_t idx = 0;
+
+            while (idx + 1 < num_classes && class_capacity(idx + 1) <= capacity)
+            {
+                ++idx;
+            }
+
+            if (auto& free_list = m_classes[idx]; free_list.size() < max_per_class)
+            {
+                buffer.clear();
+                free_list.push_back(std::move(buffer));
+            }
+        }
+    }
+
+private:
+    [[nodiscard]] static constexpr size_t class_capacity(const size_t idx) noexcept
+    {
+        return min_capacity << idx;
+    }
+
+    // The smallest class whose buffers all have at least capacity (num_classes if none do)
+    [[nodiscard]] static constexpr size_t class_of(const size_t capacity) noexcept
+    {
+        size_t idx = 0;
+
+        while (idx < num_classes && class_capacity(idx) < capacity)
+        {
+            ++idx;
+        }
+
+        return idx;
+    }
+
+    std::array<std::vector<Bytes>, num_classes> m_classes{};
+};
+
+#if defined(RPC_HPP_SERVER_IMPL) || defined(RPC_HPP_MODULE_IMPL)
+///@brief Namespace containing functions and classes only relevant to "server-side" implentations
+///
+///@note Is only compiled by defining either @ref RPC_HPP_SERVER_IMPL AND/OR @ref RPC_HPP_MODULE_IMPL
+inline namespace server
+{
+#  if defined(RPC_HPP_SERVER_IMPL) && defined(RPC_HPP_ENABLE_SERVER_CACHE)
+    ///@brief Function caches that can be shared by several servers (regardless of serial adapter)
+    ///
+    ///@details A server keeps its caches to itself unless it is given one of these with
+    /// @ref server_interface::share_cache. Servers given the same object share the cached results of functions bound
+    /// with the same name and return type
+    class shared_cache
+    {
+    public:
+        shared_cache() = default;
+
+        // Prevent copying and moving (servers refer to the caches)
+        shared_cache(const shared_cache&) = delete;
+        shared_cache(shared_cache&&) = delete;
+        shared_cache& operator=(const shared_cache&) = delete;
+        shared_cache& operator=(shared_cache&&) = delete;
+        ~shared_cache() noexcept = default;
+
+        ///@brief Gets the cache for a function, creating it if needed
+        ///
+        ///@tparam Val Type of the return value for the function
+        ///@param func_name Name of the function
+        ///@return detail::func_cache<Val>& Reference to the function's cache, valid for the lifetime of this object
+        template<typename Val>
+        [[nodiscard]] detail::func_cache<Val>& get(const std::string& func_name)
+        {
+            std::lock_guard<std::mutex> lock{ m_mtx };
+            auto& cache = m_caches[{ func_name, std::type_index{ typeid(Val) } }];
+
+            if (!cache)
+            {
+                cache = std::make_unique<detail::func_cache<Val>>();
+            }
+
+            return static_cast<detail::func_cache<Val>&>(*cache);
+        }
+
+        ///@brief Calls a function with a function's cache while holding its lock
+        ///
+        ///@note Calls to the cached function (from any server sharing this object) block until func returns, so func
+        /// must not dispatch it
+        ///@tparam Val Type of the return value for the function
+        ///@tparam F Type of the callable
+        ///@param func_name Name of the function to access the cached return value(s) for
+        ///@param func Callable taking a std::unordered_map<std::string, Val>& (the hashmap containing the return
+        /// values with the function arguments' fingerprint as the key)
+        ///@return Whatever func returns
+        template<typename Val, typename F>
+        decltype(auto) with_func_cache(const std::string& func_name, F&& func)
+        {
+            RPC_HPP_PRECONDITION(!func_name.empty());
+
+            return get<Val>(func_name).with_map(std::forward<F>(func));
+        }
+
+        ///@brief Gets statistics for each of the function caches, combining the activity of every server sharing
+        /// this object
+        ///
+        ///@return std::unordered_map<std::string, detail::func_cache_stats> Map of function name to its cache's hits, misses, inserts, evictions, entry count, and approximate memory size (in bytes)
+        [[nodiscard]] std::unordered_map<std::string, detail::func_cache_stats> cache_stats() const
+        {
+            std::lock_guard<std::mutex> lock{ m_mtx };
+            std::unordered_map<std::string, detail::func_cache_stats> stats{};
+            stats.reserve(m_caches.size());
+
+            for (const auto& [key, cache] : m_caches)
+            {
+                const auto cache_stats = cache->stats();
+                auto& func_stats = stats[key.first];
+
+                // A name may be cached with several return types
+                func_stats.hits += cache_stats.hits;
+                func_stats.misses += cache_stats.misses;
+                func_stats.inserts += cache_stats.inserts;
+                func_stats.evictions += cache_stats.evictions;
+                func_stats.entries += cache_stats.entries;
+                func_stats.mem_size += cache_stats.mem_size;
+            }
+
+            return stats;
+        }
+
+    private:
+        mutable std::mutex m_mtx{};
+        std::map<std::pair<std::string, std::type_index>, std::unique_ptr<detail::func_cache_base>>
+            m_caches{};
+    };
+#  endif
+
+    ///@brief Class defining an interface for serving functions via RPC
+    ///
+    ///@tparam Serial serial_adapter type that controls how objects are serialized/deserialized
+    template<typename Serial>
+    class server_interface
+    {
+    public:
+        using adapter_t = Serial;
+
+        server_interface() noexcept = default;
+
+        // Prevent copying
+        server_interface(const server_interface&) = delete;
+        server_interface& operator=(const server_interface&) = delete;
+
+        // Prevent moving (bound callbacks refer to the server and its caches)
+        server_interface(server_interface&&) = delete;
+        server_interface& operator=(server_interface&&) = delete;
+
+#  if defined(RPC_HPP_SERVER_IMPL) && defined(RPC_HPP_ENABLE_SERVER_CACHE)
+        ///@brief Shares the server's function caches with every other server given the same object
+        ///
+        ///@note Must be called before binding any cached function. The server keeps its own caches otherwise
+        ///@param cache Caches to use for the functions bound to this server
+        void share_cache(std::shared_ptr<shared_cache> cache) noexcept
+        {
+            RPC_HPP_PRECONDITION(cache != nullptr);
+            RPC_HPP_PRECONDITION(m_cache_map.empty());
+
+            m_shared_cache = std::move(cache);
+        }
+
+        ///@brief Gets a reference to the server's function cache
+        ///
+        ///@deprecated Access through the reference is not synchronized with dispatch, prefetching, or other servers
+        /// sharing the cache, use @ref with_func_cache instead
+        ///@tparam Val Type of the return value for a function
+        ///@param func_name Name of the function to get the cached return value(s) for
+        ///@return std::unordered_map<std::string, Val>& Reference to the hashmap containing the return values with the function arguments' fingerprint as the key
+        template<typename Val>
+        [[deprecated("not synchronized with dispatch, use with_func_cache")]] std::unordered_map<std::string, Val>&
+            get_func_cache(const std::string& func_name)
+        {
+            RPC_HPP_PRECONDITION(!func_name.empty());
+
+            return register_cache<Val>(func_name).map;
+        }
+
+        ///@brief Calls a function with the server's function cache while holding its lock
+        ///
+        ///@note Calls to the cached function (from this or any server sharing its cache) block until func returns, so func
+        /// must not dispatch it
+        ///@tparam Val Type of the return value for a function
+        ///@tparam F Type of the callable
+        ///@param func_name Name of the function to access the cached return value(s) for
+        ///@param func Callable taking a std::unordered_map<std::string, Val>& (the hashmap containing the return
+        /// values with the function arguments' fingerprint as the key)
+        ///@return Whatever func returns
+        template<typename Val, typename F>
+        decltype(auto) with_func_cache(const std::string& func_name, F&& func)
+        {
+            RPC_HPP_PRECONDITION(!func_name.empty());
+
+            return register_cache<Val>(func_name).with_map(std::forward<F>(func));
+        }
+
+        ///@brief Clears the server's function cache
+        ///
+        ///@note This also clears the caches for any other server given the same @ref shared_cache
+        void clear_all_cache()
+        {
+            for (auto& [func_name, cache] : m_cache_map)
+            {
+                cache->clear();
+            }
+        }
+
+        ///@brief Statistics for a single function's cache
+        using func_cache_stats = detail::func_cache_stats;
+
+        ///@brief Gets statistics for each of the server's function caches
+        ///
+        ///@note The statistics include activity from any other server given the same @ref shared_cache
+        ///@return std::unordered_map<std::string, func_cache_stats> Map of function name to its cache's hits, misses, inserts, evictions, entry count, and approximate memory size (in bytes)
+        [[nodiscard]] std::unordered_map<std::string, func_cache_stats> cache_stats() const
+        {
+            std::unordered_map<std::string, func_cache_stats> stats{};
+            stats.reserve(m_cache_map.size());
+
+            for (const auto& [func_name, cache] : m_cache_map)
+            {
+                stats.emplace(func_name, cache->stats());
+            }
+
+            return stats;
+        }
+
+        ///@brief Appends a serialized request to a trace that can later be replayed by @ref warm_cache
+        ///
+        ///@param trace Output stream (opened in binary mode) to write the request to
+        ///@param bytes Serialized request, as received by @ref dispatch
+        static void record_request(std::ostream& trace, const typename Serial::bytes_t& bytes)
+        {
+            const auto len = static_cast<uint64_t>(bytes.size());
+            trace.write(reinterpret_cast<const char*>(&len), sizeof(len));
+            trace.write(reinterpret_cast<const char*>(bytes.data()),
+                static_cast<std::streamsize>(bytes.size()));
+        }
+
+        ///@brief Largest request read from a trace by @ref warm_cache
+        static constexpr uint64_t max_trace_request_size = uint64_t{ 64 } * 1'024 * 1'024;
+
+        ///@brief Primes the function cache by replaying a trace of recorded requests
+        ///
+        ///@details Records are read from the trace one at a time, as the threads replaying them get to them, so the
+        /// trace is never held in memory as a whole
+        ///@param trace Input stream (opened in binary mode) containing requests written by @ref record_request
+        ///@param num_threads Number of threads to replay the requests on
+        ///@param max_per_sec Maximum number of requests to replay per second (0 for no limit)
+        ///@return size_t Number of requests replayed
+        ///@note Only requests for functions bound with @ref bind_cached are replayed, others are skipped so that
+        /// functions with side effects (or that stop the server) are not run again. Reading stops at the first record
+        /// larger than @ref max_trace_request_size, as the trace must be corrupt
+        size_t warm_cache(std::istream& trace, unsigned num_threads = 1, size_t max_per_sec = 0)
+        {
+            const auto start = std::chrono::steady_clock::now();
+            std::mutex trace_mtx{};
+            bool trace_done = false;
+            size_t num_replayed = 0;
+
+            // Reads up to the next request for a cached function, along with its position among
+            // the replayed requests
+            const auto next_request =
+                [this, &trace, &trace_mtx, &trace_done, &num_replayed]()
+                -> std::optional<std::pair<size_t, typename Serial::bytes_t>>
+            {
+                std::lock_guard<std::mutex> lock{ trace_mtx };
+
+                while (!trace_done)
+                {
+                    auto bytes = read_trace_record(trace);
+
+                    if (!bytes.has_value())
+                    {
+                        trace_done = true;
+                        break;
+                    }
+
+                    if (const auto func_name = request_func_name(bytes.value());
+                        func_name.has_value() && m_cached_funcs.count(func_name.value()) != 0)
+                    {
+                        return std::make_pair(num_replayed++, std::move(bytes).value());
+                    }
+                }
+
+                return std::nullopt;
+            };
+
+            const auto replay = [this, &next_request, start, max_per_sec]
+            {
+                while (auto request = next_request())
+                {
+                    if (max_per_sec != 0)
+                    {
+                        std::this_thread::sleep_until(start
+                            + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                                std::chrono::duration<double>(static_cast<double>(request->first)
+                                    / static_cast<double>(max_per_sec))));
+                    }
+
+                    std::ignore = dispatch(std::move(request->second));
+                }
+            };
+
+            if (num_threads <= 1)
+            {
+                replay();
+            }
+            else
+            {
+                std::vector<std::thread> workers{};
+                workers.reserve(num_threads);
+
+                for (unsigned i = 0; i < num_threads; ++i)
+                {
+                    workers.emplace_back(replay);
+                }
+
+                for (auto& worker : workers)
+                {
+                    worker.join();
+                }
+            }
+
+            return num_replayed;
+        }
+#  endif
+
+        ///@brief Binds a string to a callback, utilizing the server's cache
+        ///
+        ///@tparam R Return type of the callback function
+        ///@tparam Args Variadic argument type(s) for the function
+        ///@param func_name Name to bind the callback to
+        ///@param func_ptr Pointer to callback that runs when dispatch is called with bound name
+        template<typename R, typename... Args>
+        void bind_cached(std::string func_name, std::function<R(Args...)> &&func)
+        {
+#  if defined(RPC_HPP_SERVER_IMPL) && defined(RPC_HPP_ENABLE_SERVER_CACHE)
+            if constexpr (!std::is_void_v<R>)
+            {
+                // Captured by the dispatcher, so the cache is never looked up by a name from a request
+                auto& cache = register_cache<R>(func_name);
+                m_cached_funcs.insert(func_name);
+
+                if constexpr (sizeof...(Args) == 1)
+                {
+                    using param_t = std::tuple_element_t<0, std::tuple<Args...>>;
+                    using arg_t = std::remove_cv_t<std::remove_reference_t<param_t>>;
+
+                    if constexpr (detail::is_prefetch_candidate_v<arg_t>
+                        && (!std::is_lvalue_reference_v<param_t>
+                            || std::is_const_v<std::remove_reference_t<param_t>>))
+                    {
+                        m_speculators.insert_or_assign(func_name,
+                            [func, &cache](const std::type_info& type, const void* val)
+                            {
+                                if (type != typeid(arg_t))
+                                {
+                                    return;
+                                }
+
+                                const auto& arg = *static_cast<const arg_t*>(val);
+                                auto key = detail::make_fingerprint(std::tuple<arg_t>{ arg });
+
+                                {
+                                    std::lock_guard<std::mutex> lock{ cache.mtx };
+
+                                    if (cache.map.find(key) != cache.map.end())
+                                    {
+                                        return;
+                                    }
+                                }
+
+                                auto result = func(arg);
+
+                                std::lock_guard<std::mutex> lock{ cache.mtx };
+
+                                if (cache.try_emplace(std::move(key), std::move(result)))
+                                {
+                                    cache.local_counters().add_insert();
+                                }
+                            });
+                    }
+                }
+
+                auto dispatcher = make_dispatcher<R, Args...>(func_name,
+                    [this, &cache, func = std::forward<decltype(func)>(func)](
+                        detail::packed_func<R, Args...>& pack)
+                    { dispatch_cached_func(std::forward<decltype(func)>(func), cache, pack); });
+
+                m_dispatch_table.emplace(std::move(func_name), std::move(dispatcher));
+
+                return;
+            }
+#  endif
+
+            // Nothing to cache
+            bind(std::move(func_name), std::forward<decltype(func)>(func));
+        }
+
+        ///@brief Binds a string to a callback, utilizing the server's cache
+        ///
+        ///@tparam R Return type of the callback function
+        ///@tparam Args Variadic argument type(s) for the function
+        ///@tparam F Callback type (could be function or lambda or functor)
+        ///@param func_name Name to bind the callback to
+        ///@param func Callback to run when dispatch is called with bound name
+        template<typename R, typename... Args>
+        RPC_HPP_INLINE void bind_cached(std::string func_name, R (*func_ptr)(Args...))
+        {
+            using fptr_t = std::function<R(Args...)>;
+
+            bind_cached(std::move(func_name), fptr_t{ func_ptr });
+        }
+
+        ///@brief Binds a string to a callback
+        ///
+        ///@tparam R Return type of the callback function
+        ///@tparam Args Variadic argument type(s) for the function
+        ///@param func_name Name to bind the callback to
+        ///@param func_ptr Pointer to callback that runs when dispatch is called with bound name
+        template<typename R, typename... Args>
+        void bind(std::string func_name, std::function<R(Args...)> &&func)
+        {
+            auto dispatcher = make_dispatcher<R, Args...>(func_name,
+                [this, func = std::forward<decltype(func)>(func)](
+                    detail::packed_func<R, Args...>& pack)
+                { dispatch_func(std::forward<decltype(func)>(func), pack); });
+
+            m_dispatch_table.emplace(std::move(func_name), std::move(dispatcher));
+        }
+
+        ///@brief Binds a string to a callback
+        ///
+        ///@tparam R Return type of the callback function
+        ///@tparam Args Variadic argument type(s) for the function
+        ///@tparam F Callback type (could be function or lambda or functor)
+        ///@param func_name Name to bind the callback to
+        ///@param func Callback to run when dispatch is called with bound name
+        template<typename R, typename... Args>
+        RPC_HPP_INLINE void bind(std::string func_name, R (*func_ptr)(Args...))
+        {
+            using fptr_t = std::function<R(Args...)>;
+
+            bind(std::move(func_name), fptr_t{ func_ptr });
+        }
+
+        ///@brief Parses the received serialized data and determines which function to call
+        ///
+        ///@param bytes Data to be parsed into a serial object
+        ///@return Serial::bytes_t Data parsed out of a serial object after dispatching the callback
+        ///@note nodiscard because original bytes are consumed
+        [[nodiscard]] typename Serial::bytes_t dispatch(typename Serial::bytes_t&& bytes) const
+        {
+            typename Serial::bytes_t reply{};
+            dispatch(std::move(bytes), reply);
+            return reply;
+        }
+
+        ///@brief Parses the received serialized data and determines which function to call, writing the reply into a
+        /// caller-owned buffer
+        ///
+        ///@details Reusing the same reply buffer for every request (and taking the received data from
+        /// @ref buffer_pool, when possible) avoids allocating message buffers once the server is warmed up
+        ///@param bytes Data to be parsed into a serial object
+        ///@param reply Buffer to write the reply into, replacing its contents
+        void dispatch(typename Serial::bytes_t&& bytes, typename Serial::bytes_t& reply) const
+        {
+#  if defined(RPC_HPP_SERVER_IMPL) && defined(RPC_HPP_ENABLE_SERVER_CACHE)
+            // Lets speculative prefetching wait for the server to be idle
+            const detail::active_request_scope active{ m_predictor.get() };
+#  endif
+
+#  if defined(RPC_HPP_ENABLE_MESSAGE_HEADER)
+            // Routed by the name in the header, without parsing the body first
+            auto header = message_header::read(bytes);
+
+            if (!header.has_value() || header->is_response() || header->func_name.empty()
+                || header->size() + header->body_size != bytes.size())
+            {
+                // Request ID 0 tells the client that the request could not be matched to it
+                message_header reply_header{};
+                reply_header.flags = message_header::response_flag;
+                reply_header.request_id = message_header::read_request_id(bytes).value_or(0);
+
+                detail::write_bytes<Serial>(
+                    request_error({}, server_receive_error("Invalid RPC object received")), reply);
+
+                reply_header.prepend(reply);
+                return;
+            }
+
+            header->remove_from(bytes);
+            header->flags = message_header::response_flag;
+            dispatch_body(std::move(bytes), header->func_name, reply);
+            header->prepend(reply);
+#  else
+            dispatch_body(std::move(bytes), std::nullopt, reply);
+#  endif
+        }
+
+#  if defined(RPC_HPP_SERVER_IMPL) && defined(RPC_HPP_ENABLE_SERVER_CACHE)
+        ///@brief Options controlling when the server speculatively prefetches results into the cache
+        struct prefetch_config
+        {
+            ///@brief Fraction of observed calls that must use a value from the previous result
+            double min_confidence{ 0.95 };
+
+            ///@brief Number of observed calls required before speculating
+            size_t min_samples{ 32 };
+
+            ///@brief Results with more elements than this are not tracked
+            size_t max_candidates{ 4'096 };
+        };
+
+        ///@brief Enables learning of call sequences and speculative prefetching into the cache
+        ///
+        ///@details Learning only occurs for requests dispatched with a connection ID. When calls to a
+        /// cached function taking a single argument are found to consistently use a value (or element) from
+        /// the previous result of another function on the same connection, that function is speculatively
+        /// computed for the values of new results, and its results inserted into the cache.
+        ///
+        /// Threading: speculative calls run on a single background thread owned by this server (joined when prefetching
+        /// is re-enabled or the server is destroyed). Each one only starts while this server is not dispatching any
+        /// request, and new results are dropped while earlier ones are still being speculated on, but a request arriving
+        /// during a speculative call runs concurrently with it. Callbacks bound with @ref bind_cached that take a
+        /// single argument must therefore be safe to call from another thread, and should have no side effects, as
+        /// their result may never be requested. Exceptions thrown by speculative calls are discarded
+        ///@note Must be called before binding any function (and therefore before dispatching), as the prefetcher is
+        /// not synchronized with running requests
+        ///@param config Options controlling when to prefetch
+        void enable_prefetch(const prefetch_config& config)
+        {
+            RPC_HPP_PRECONDITION(m_dispatch_table.empty());
+
+            m_prefetch_config = config;
+            m_predictor = std::make_unique<detail::call_predictor>(
+                config.min_confidence, config.min_samples);
+        }
+
+        ///@brief Blocks until the speculative calls started by previous requests have finished
+        ///
+        ///@details Returns immediately if prefetching is not enabled
+        void wait_for_prefetch()
+        {
+            if (m_predictor)
+            {
+                m_predictor->wait_idle();
+            }
+        }
+
+        ///@brief Parses the received serialized data for a given connection and determines which function to call
+        ///
+        ///@param bytes Data to be parsed into a serial object
+        ///@param connection_id Identifier of the connection the data was received on, used to learn call sequences
+        ///@return Serial::bytes_t Data parsed out of a serial object after dispatching the callback
+        ///@note nodiscard because original bytes are consumed
+        [[nodiscard]] typename Serial::bytes_t dispatch(
+            typename Serial::bytes_t&& bytes, const size_t connection_id) const
+        {
+            const detail::connection_scope scope{ connection_id };
+            return dispatch(std::move(bytes));
+        }
+
+        ///@brief Parses the received serialized data for a given connection and determines which function to call,
+        /// writing the reply into a caller-owned buffer
+        ///
+        ///@param bytes Data to be parsed into a serial object
+        ///@param connection_id Identifier of the connection the data was received on, used to learn call sequences
+        ///@param reply Buffer to write the reply into, replacing its contents
+        void dispatch(typename Serial::bytes_t&& bytes, const size_t connection_id,
+            typename Serial::bytes_t& reply) const
+        {
+            const detail::connection_scope scope{ connection_id };
+            dispatch(std::move(bytes), reply);
+        }
+
+        ///@brief Discards the call sequence state for a closed connection
+        ///
+        ///@param connection_id Identifier of the connection passed to @ref dispatch
+        void forget_connection(const size_t connection_id)
+        {
+            if (m_predictor)
+            {
+                m_predictor->forget_connection(connection_id);
+            }
+        }
+#  endif
+
+    protected:
+        ~server_interface() noexcept = default;
+
+#  if defined(RPC_HPP_SERVER_IMPL) && defined(RPC_HPP_ENABLE_SERVER_CACHE)
+        template<typename R, typename... Args>
+        void dispatch_cached_func(const std::function<R(Args...)>&& func,
+            detail::func_cache<R>& result_cache, detail::packed_func<R, Args...>& pack) const
+        {
+            RPC_HPP_PRECONDITION(func != nullptr);
+
+            observe_call(pack);
+            auto key = detail::make_fingerprint(pack.get_args());
+
+            {
+                std::lock_guard<std::mutex> lock{ result_cache.mtx };
+
+                if (const auto it = result_cache.map.find(key); it != result_cache.map.end())
+                {
+                    pack.set_result(it->second);
+                }
+            }
+
+            auto& counters = result_cache.local_counters();
+
+            if (pack)
+            {
+                counters.add_hit();
+            }
+            else
+            {
+                counters.add_miss();
+                run_callback(std::forward<decltype(func)>(func), pack);
+
+                std::lock_guard<std::mutex> lock{ result_cache.mtx };
+                result_cache.insert_or_assign(std::move(key), pack.get_result());
+                counters.add_insert();
+            }
+
+            observe_result(pack);
+        }
+#  endif
+
+        template<typename R, typename... Args>
+        void dispatch_func(
+            const std::function<R(Args...)>&& func, detail::packed_func<R, Args...>& pack) const
+        {
+            RPC_HPP_PRECONDITION(func != nullptr);
+
+            observe_call(pack);
+            run_callback(std::forward<decltype(func)>(func), pack);
+            observe_result(pack);
+        }
+
+    private:
+#  if defined(RPC_HPP_SERVER_IMPL) && defined(RPC_HPP_ENABLE_SERVER_CACHE)
+        // Gets the cache for func_name, remembering it for clear_all_cache and cache_stats
+        template<typename Val>
+        [[nodiscard]] detail::func_cache<Val>& register_cache(const std::string& func_name)
+        {
+            if (!m_shared_cache)
+            {
+                m_shared_cache = std::make_shared<shared_cache>();
+            }
+
+            auto& cache = m_shared_cache->get<Val>(func_name);
+            m_cache_map.insert_or_assign(func_name, &cache);
+            return cache;
+        }
+#  endif
+
+#  if defined(RPC_HPP_SERVER_IMPL) && defined(RPC_HPP_ENABLE_SERVER_CACHE)
+        // Reads the next record written by record_request (std::nullopt at the end of the trace,
+        // or at a truncated or oversized record)
+        [[nodiscard]] static std::optional<typename Serial::bytes_t> read_trace_record(
+            std::istream& trace)
+        {
+            uint64_t len = 0;
+
+            if (!trace.read(reinterpret_cast<char*>(&len), sizeof(len))
+                || len > max_trace_request_size)
+            {
+                return std::nullopt;
+            }
+
+            typename Serial::bytes_t bytes{};
+            bytes.resize(len);
+
+            if (!trace.read(reinterpret_cast<char*>(bytes.data()), static_cast<std::streamsize>(len)))
+            {
+                // Truncated record, likely from a trace that was cut off mid-write
+                return std::nullopt;
+            }
+
+            return bytes;
+        }
+
+        // Name of the function that dispatch would route the request to (std::nullopt if invalid)
+        [[nodiscard]] static std::optional<std::string> request_func_name(
+            typename Serial::bytes_t& bytes)
+        {
+#    if defined(RPC_HPP_ENABLE_MESSAGE_HEADER)
+            if (auto header = message_header::read(bytes); header.has_value())
+            {
+                return std::move(header->func_name);
+            }
+
+            return std::nullopt;
+#    else
+            if constexpr (detail::has_typed_parse_v<Serial>)
+            {
+                return Serial::peek_func_name(bytes);
+            }
+            else
+            {
+                [[maybe_unused]] const typename Serial::request_scope scope{};
+
+                // Parsed from a copy, as the request is still to be dispatched
+                const auto serial_obj = Serial::from_bytes(typename Serial::bytes_t{ bytes });
+
+                if (!serial_obj.has_value())
+                {
+                    return std::nullopt;
+                }
+
+                return std::string{ Serial::get_func_name(serial_obj.value()) };
+            }
+#    endif
+        }
+#  endif
+
+        // Adapters that read packs straight from bytes get the request, others its serial object
+        using dispatch_fn_t = std::conditional_t<detail::has_typed_parse_v<Serial>,
+            std::function<typename Serial::serial_t(typename Serial::bytes_t&)>,
+            std::function<void(typename Serial::serial_t&)>>;
+
+        // Wraps a function running a deserialized pack into the dispatch table entry for func_name
+        template<typename R, typename... Args, typename F>
+        static dispatch_fn_t make_dispatcher(std::string func_name, F&& dispatch_pack)
+        {
+            if constexpr (detail::has_typed_parse_v<Serial>)
+            {
+                return [func_name = std::move(func_name),
+                           dispatch_pack = std::forward<F>(dispatch_pack)](
+                           typename Serial::bytes_t& bytes) -> typename Serial::serial_t
+                {
+                    try
+                    {
+                        auto pack = translate_errors<deserialization_error>(
+                            [&bytes] { return Serial::template parse_pack<R, Args...>(bytes); });
+
+                        check_routed_name(pack, func_name);
+                        dispatch_pack(pack);
+
+                        return translate_errors<serialization_error>(
+                            [&pack] { return Serial::template serialize_pack<R, Args...>(pack); });
+                    }
+                    catch (const rpc_exception& ex)
+                    {
+                        return request_error(std::move(bytes), ex);
+                    }
+                };
+            }
+            else
+            {
+                return [func_name = std::move(func_name),
+                           dispatch_pack = std::forward<F>(dispatch_pack)](
+                           typename Serial::serial_t& serial_obj)
+                {
+                    try
+                    {
+                        auto pack = translate_errors<deserialization_error>(
+                            [&serial_obj]
+                            { return Serial::template deserialize_pack<R, Args...>(serial_obj); });
+
+                        check_routed_name(pack, func_name);
+                        dispatch_pack(pack);
+
+                        auto reply_obj = translate_errors<serialization_error>(
+                            [&pack] { return Serial::template serialize_pack<R, Args...>(pack); });
+
+                        // The request's buffer can serve a later message
+                        std::swap(serial_obj, reply_obj);
+                        detail::recycle<Serial>(std::move(reply_obj));
+                    }
+                    catch (const rpc_exception& ex)
+                    {
+                        Serial::set_exception(serial_obj, ex);
+                    }
+                };
+            }
+        }
+
+        // Requests may be routed by a name outside their body (e.g. in a message_header), which must
+        // not run a function with the arguments meant for another
+        template<typename R, typename... Args>
+        static void check_routed_name(
+            const detail::packed_func<R, Args...>& pack, const std::string& func_name)
+        {
+            if (pack.get_func_name() != func_name)
+            {
+                throw function_mismatch("RPC error: Request for function: \"" + pack.get_func_name()
+                    + "\" was routed to function: \"" + func_name + "\"");
+            }
+        }
+
+        // Dispatches the body of a request, to the function named routed_name if given (instead of
+        // the name in the body), and writes the reply into reply
+        void dispatch_body(typename Serial::bytes_t&& bytes, std::optional<std::string> routed_name,
+            typename Serial::bytes_t& reply) const
+        {
+            // Declared first so that every serial object is destroyed before the scope ends
+            [[maybe_unused]] const typename Serial::request_scope scope{};
+
+            if constexpr (detail::has_typed_parse_v<Serial>)
+            {
+                const auto func_name =
+                    routed_name.has_value() ? std::move(routed_name) : Serial::peek_func_name(bytes);
+
+                if (!func_name.has_value())
+                {
+                    detail::write_bytes<Serial>(request_error(std::move(bytes),
+                                                    server_receive_error("Invalid RPC object received")),
+                        reply);
+
+                    return;
+                }
+
+                if (const auto it = m_dispatch_table.find(func_name.value());
+                    it != m_dispatch_table.end())
+                {
+                    detail::write_bytes<Serial>(it->second(bytes), reply);
+
+                    // The request was only read, so its buffer can serve a later message
+                    buffer_pool<typename Serial::bytes_t>::local().release(std::move(bytes));
+                    detail::message_size_hints::update(func_name.value(), reply.size());
+                    return;
+                }
+
+                detail::write_bytes<Serial>(request_error(std::move(bytes),
+                                                function_not_found("RPC error: Called function: \""
+                                                    + func_name.value() + "\" not found")),
+                    reply);
+            }
+            else
+            {
+                auto serial_obj = Serial::from_bytes(std::move(bytes));
+
+                if (!serial_obj.has_value())
+                {
+                    auto err_obj = Serial::empty_object();
+                    Serial::set_exception(
+                        err_obj, server_receive_error("Invalid RPC object received"));
+
+                    detail::write_bytes<Serial>(std::move(err_obj), reply);
+                    return;
+                }
+
+                // Adapters may return a view of the name
+                const std::string func_name = routed_name.has_value()
+                    ? std::move(routed_name).value()
+                    : std::string{ adapter_t::get_func_name(serial_obj.value()) };
+
+                if (const auto it = m_dispatch_table.find(func_name); it != m_dispatch_table.end())
+                {
+                    it->second(serial_obj.value());
+                    detail::write_bytes<Serial>(std::move(serial_obj).value(), reply);
+                    detail::message_size_hints::update(func_name, reply.size());
+                    return;
+                }
+
+                Serial::set_exception(serial_obj.value(),
+                    function_not_found(
+                        "RPC error: Called function: \"" + func_name + "\" not found"));
+
+                detail::write_bytes<Serial>(std::move(serial_obj).value(), reply);
+            }
+        }
+
+        // Reports ex on the request (which is only parsed into a serial object now), or on an empty
+        // object if the request is invalid
+        [[nodiscard]] static typename Serial::serial_t request_error(
+            typename Serial::bytes_t&& bytes, const rpc_exception& ex)
+        {
+            auto serial_obj = Serial::from_bytes(std::move(bytes));
+
+            if (!serial_obj.has_value())
+            {
+                auto err_obj = Serial::empty_object();
+                Serial::set_exception(
+                    err_obj, server_receive_error("Invalid RPC object received"));
+
+                return err_obj;
+            }
+
+            Serial::set_exception(serial_obj.value(), ex);
+            return std::move(serial_obj).value();
+        }
+
+        // Rethrows non-RPC exceptions thrown by func as Ex
+        template<typename Ex, typename F>
+        static auto translate_errors(const F& func)
+        {
+            try
+            {
+                return func();
+            }
+            catch (const rpc_exception&)
+            {
+                throw;
+            }
+            catch (const std::exception& ex)
+            {
+                throw Ex(ex.what());
+            }
+        }
+
+        template<typename R, typename... Args>
+        void observe_call([[maybe_unused]] const detail::packed_func<R, Args...>& pack) const
+        {
+#  if defined(RPC_HPP_SERVER_IMPL) && defined(RPC_HPP_ENABLE_SERVER_CACHE)
+            if constexpr (sizeof...(Args) == 1)
+            {
+                if constexpr (detail::is_prefetch_candidate_v<std::remove_cv_t<
+                                  std::remove_reference_t<std::tuple_element_t<0, std::tuple<Args...>>>>>)
+                {
+                    if (const auto& connection_id = detail::current_connection();
+                        m_predictor && connection_id.has_value())
+                    {
+                        m_predictor->observe_call(connection_id.value(), pack.get_func_name(),
+                            detail::make_fingerprint(pack.get_args()));
+                    }
+                }
+            }
+#  endif
+        }
+
+        template<typename R, typename... Args>
+        void observe_result([[maybe_unused]] const detail::packed_func<R, Args...>& pack) const
+        {
+#  if defined(RPC_HPP_SERVER_IMPL) && defined(RPC_HPP_ENABLE_SERVER_CACHE)
+            if constexpr (!std::is_void_v<R>)
+            {
+                const auto& connection_id = detail::current_connection();
+
+                if (!m_predictor || !connection_id.has_value() || !pack)
+                {
+                    return;
+                }
+
+                const auto& result = pack.get_result();
+                std::unordered_set<std::string> candidates{};
+
+                if constexpr (detail::is_prefetch_candidate_v<R>)
+                {
+                    candidates.insert(detail::make_fingerprint(std::tuple<R>{ result }));
+                }
+                else if constexpr (detail::is_container_v<R>)
+                {
+                    using value_t = typename R::value_type;
+
+                    if constexpr (detail::is_prefetch_candidate_v<value_t>)
+                    {
+                        if (result.size() > m_prefetch_config.max_candidates)
+                        {
+                            return;
+                        }
+
+                        candidates.reserve(result.size());
+
+                        for (const auto& val : result)
+                        {
+                            candidates.insert(detail::make_fingerprint(std::tuple<value_t>{ val }));
+                        }
+                    }
+                    else
+                    {
+                        return;
+                    }
+                }
+                else
+                {
+                    return;
+                }
+
+                const auto likely_next = m_predictor->observe_result(
+                    connection_id.value(), pack.get_func_name(), std::move(candidates));
+
+                std::vector<speculator_t> speculators{};
+
+                for (const auto& func_name : likely_next)
+                {
+                    if (const auto it = m_speculators.find(func_name); it != m_speculators.end())
+                    {
+                        speculators.push_back(it->second);
+                    }
+                }
+
+                if (speculators.empty() || !m_predictor->idle())
+                {
+                    return;
+                }
+
+                std::vector<std::function<void()>> calls{};
+
+                for (const auto& speculate : speculators)
+                {
+                    if constexpr (detail::is_prefetch_candidate_v<R>)
+                    {
+                        calls.emplace_back([speculate, result = result]
+                            { speculate(typeid(R), &result); });
+                    }
+                    else if constexpr (detail::is_container_v<R>)
+                    {
+                        for (const auto& val : result)
+                        {
+                            calls.emplace_back([speculate, val = val]
+                                { speculate(typeid(typename R::value_type), &val); });
+                        }
+                    }
+                }
+
+                std::ignore = m_predictor->try_post(std::move(calls));
+            }
+#  endif
+        }
+
+        template<typename R, typename... Args>
+        static void run_callback(const std::function<R(Args...)> &&func, detail::packed_func<R, Args...>& pack)
+        {
+            RPC_HPP_PRECONDITION(func != nullptr);
+
+            auto& args = pack.get_args();
+
+            if constexpr (std::is_void_v<R>)
+            {
+                try
+                {
+                    std::apply(func, args);
+                }
+                catch (const std::exception& ex)
+                {
+                    throw remote_exec_error(ex.what());
+                }
+            }
+            else
+            {
+                try
+                {
+                    auto result = std::apply(func, args);
+                    pack.set_result(std::move(result));
+                }
+                catch (const std::exception& ex)
+                {
+                    throw remote_exec_error(ex.what());
+                }
+            }
+        }
+
+#  if defined(RPC_HPP_SERVER_IMPL) && defined(RPC_HPP_ENABLE_SERVER_CACHE)
+        using speculator_t = std::function<void(const std::type_info&, const void*)>;
+
+        std::shared_ptr<shared_cache> m_shared_cache{};
+        std::unordered_map<std::string, detail::func_cache_base*> m_cache_map{};
+        std::unordered_set<std::string> m_cached_funcs{};
+        std::unordered_map<std::string, speculator_t> m_speculators{};
+        std::unique_ptr<detail::call_predictor> m_predictor{};
+        prefetch_config m_prefetch_config{};
+#  endif
+
+        std::unordered_map<std::string, dispatch_fn_t> m_dispatch_table{};
+    };
+
+    ///@brief Class serving functions via RPC to clients using any of several serial adapters
+    ///
+    ///@details Each adapter keeps its own server_interface and dispatch table, so every bind registers the
+    /// function once per adapter (sharing a single callback and any state it holds) and lookups stay typed for that
+    /// adapter. Function caches are shared by the adapters (see @ref share_cache). The adapter for a request is picked from the first byte of its
+    /// body (after the @ref message_header, if enabled): it is the first of Serials whose may_start_with accepts that
+    /// byte, or that does not define may_start_with. Adapters that cannot be recognized this way (e.g. bitsery or
+    /// raw) must be listed last, so at most one of them can be used per multi_server; combining bitsery and raw
+    /// needs separate servers. Every adapter but the last must accept first bytes that no other adapter accepts,
+    /// which is checked on construction
+    ///@tparam Serials serial_adapter types to accept requests from
+    template<typename... Serials>
+    class multi_server
+    {
+    public:
+        static_assert(sizeof...(Serials) != 0, "multi_server requires at least one serial adapter");
+
+        ///@throws std::logic_error Thrown if the adapters cannot be told apart by the first byte of a request
+        multi_server()
+        {
+            if (!has_distinct_formats(std::make_index_sequence<sizeof...(Serials) - 1>{}))
+            {
+                throw std::logic_error("multi_server adapters accept the same first bytes, so some "
+                                       "requests would be dispatched to the wrong adapter");
+            }
+
+#  if defined(RPC_HPP_SERVER_IMPL) && defined(RPC_HPP_ENABLE_SERVER_CACHE)
+            // A function's results are cached once for all of the adapters
+            share_cache(std::make_shared<shared_cache>());
+#  endif
+        }
 
-        server_interface(server_interface&&) noexcept = default;
-        server_interface& operator=(server_interface&&) noexcept = default;
+        // Prevent copying and moving (bound callbacks refer to the servers)
+        multi_server(const multi_server&) = delete;
+        multi_server(multi_server&&) = delete;
+        multi_server& operator=(const multi_server&) = delete;
+        multi_server& operator=(multi_server&&) = delete;
 
-#  if defined(RPC_HPP_SERVER_IMPL) && defined(RPC_HPP_ENABLE_SERVER_CACHE)
-        ///@brief Gets a reference to the server's function cache
+        ///@brief Gets the server for one of the adapters (e.g. to bind a function it alone supports)
         ///
-        ///@tparam Val Type of the return value for a function
-        ///@param func_name Name of the function to get the cached return value(s) for
-        ///@return std::unordered_map<typename Serial::bytes_t, Val>& Reference to the hashmap containing the return values with the serialized function call as the key
-        template<typename Val>
-        std::unordered_map<typename Serial::bytes_t, Val>& get_func_cache(
-            const std::string& func_name)
+        ///@tparam Serial One of Serials
+        ///@return server_interface<Serial>& Reference to the server for Serial
+        template<typename Serial>
+        [[nodiscard]] server_interface<Serial>& get() noexcept
         {
-            RPC_HPP_PRECONDITION(!func_name.empty());
-
-            update_all_cache<Val>(func_name);
-            return *static_cast<std::unordered_map<typename Serial::bytes_t, Val>*>(
-                m_cache_map.at(func_name));
+            return std::get<adapter_server<Serial>>(m_servers);
         }
 
-        ///@brief Clears the server's function cache
-        RPC_HPP_INLINE void clear_all_cache() noexcept { m_cache_map.clear(); }
-#  endif
-
-        ///@brief Binds a string to a callback, utilizing the server's cache
+        ///@brief Binds a string to a callback for every adapter, utilizing the servers' cache
         ///
         ///@tparam R Return type of the callback function
         ///@tparam Args Variadic argument type(s) for the function
         ///@param func_name Name to bind the callback to
-        ///@param func_ptr Pointer to callback that runs when dispatch is called with bound name
+        ///@param func Callback that runs when dispatch is called with bound name
         template<typename R, typename... Args>
-        void bind_cached(std::string func_name, std::function<R(Args...)> &&func)
+        void bind_cached(const std::string& func_name, std::function<R(Args...)>&& func)
         {
-            m_dispatch_table.emplace(std::move(func_name),
-                [this, func = std::forward<decltype(func)>(func)](typename Serial::serial_t& serial_obj)
-                {
-                    try
-                    {
-                        dispatch_cached_func(std::forward<decltype(func)>(func), serial_obj);
-                    }
-                    catch (const rpc_exception& ex)
-                    {
-                        Serial::set_exception(serial_obj, ex);
-                    }
-                });
+            const auto shared_func = std::make_shared<const std::function<R(Args...)>>(std::move(func));
+            (get<Serials>().template bind_cached<R, Args...>(func_name, share_func(shared_func)), ...);
         }
 
-        ///@brief Binds a string to a callback, utilizing the server's cache
+        ///@brief Binds a string to a callback for every adapter, utilizing the servers' cache
         ///
         ///@tparam R Return type of the callback function
         ///@tparam Args Variadic argument type(s) for the function
-        ///@tparam F Callback type (could be function or lambda or functor)
         ///@param func_name Name to bind the callback to
-        ///@param func Callback to run when dispatch is called with bound name
+        ///@param func_ptr Pointer to callback that runs when dispatch is called with bound name
         template<typename R, typename... Args>
-        RPC_HPP_INLINE void bind_cached(std::string func_name, R (*func_ptr)(Args...))
+        RPC_HPP_INLINE void bind_cached(const std::string& func_name, R (*func_ptr)(Args...))
         {
             using fptr_t = std::function<R(Args...)>;
 
-            bind_cached(std::move(func_name), fptr_t{ func_ptr });
+            bind_cached(func_name, fptr_t{ func_ptr });
         }
 
-        ///@brief Binds a string to a callback
+        ///@brief Binds a string to a callback for every adapter
         ///
         ///@tparam R Return type of the callback function
         ///@tparam Args Variadic argument type(s) for the function
         ///@param func_name Name to bind the callback to
-        ///@param func_ptr Pointer to callback that runs when dispatch is called with bound name
+        ///@param func Callback that runs when dispatch is called with bound name
         template<typename R, typename... Args>
-        void bind(std::string func_name, std::function<R(Args...)> &&func)
+        void bind(const std::string& func_name, std::function<R(Args...)>&& func)
         {
-            m_dispatch_table.emplace(std::move(func_name),
-                [func = std::forward<decltype(func)>(func)](typename Serial::serial_t& serial_obj)
-                {
-                    try
-                    {
-                        dispatch_func(std::forward<decltype(func)>(func), serial_obj);
-                    }
-                    catch (const rpc_exception& ex)
-                    {
-                        Serial::set_exception(serial_obj, ex);
-                    }
-                });
+            const auto shared_func = std::make_shared<const std::function<R(Args...)>>(std::move(func));
+            (get<Serials>().template bind<R, Args...>(func_name, share_func(shared_func)), ...);
         }
 
-        ///@brief Binds a string to a callback
+        ///@brief Binds a string to a callback for every adapter
         ///
         ///@tparam R Return type of the callback function
         ///@tparam Args Variadic argument type(s) for the function
-        ///@tparam F Callback type (could be function or lambda or functor)
         ///@param func_name Name to bind the callback to
-        ///@param func Callback to run when dispatch is called with bound name
+        ///@param func_ptr Pointer to callback that runs when dispatch is called with bound name
         template<typename R, typename... Args>
-        RPC_HPP_INLINE void bind(std::string func_name, R (*func_ptr)(Args...))
+        RPC_HPP_INLINE void bind(const std::string& func_name, R (*func_ptr)(Args...))
         {
             using fptr_t = std::function<R(Args...)>;
 
-            bind(std::move(func_name), fptr_t{ func_ptr });
+            bind(func_name, fptr_t{ func_ptr });
         }
 
-        ///@brief Parses the received serialized data and determines which function to call
+        ///@brief Determines the format of the received data and dispatches it to the matching adapter's server
         ///
-        ///@param bytes Data to be parsed into a serial object
-        ///@return Serial::bytes_t Data parsed out of a serial object after dispatching the callback
-        ///@note nodiscard because original bytes are consumed
-        [[nodiscard]] typename Serial::bytes_t dispatch(typename Serial::bytes_t&& bytes) const
+        ///@tparam F Callable taking the reply (as the bytes_t of the matching adapter)
+        ///@param bytes Data received
+        ///@param on_reply Called with the reply, if an adapter accepted the request. The reply's buffer is reused
+        /// for later requests, so it must not be kept
+        ///@return bool Whether an adapter accepted the request
+        template<typename F>
+        bool dispatch(const std::string_view bytes, F&& on_reply) const
         {
-            auto serial_obj = Serial::from_bytes(std::move(bytes));
+            size_t body_start = 0;
 
-            if (!serial_obj.has_value())
+#  if defined(RPC_HPP_ENABLE_MESSAGE_HEADER)
+            if (const auto header = message_header::read(bytes); header.has_value())
             {
-                auto err_obj = Serial::empty_object();
-                Serial::set_exception(err_obj, server_receive_error("Invalid RPC object received"));
-                return Serial::to_bytes(std::move(err_obj));
+                body_start = header->size();
             }
+#  endif
 
-            const auto func_name = adapter_t::get_func_name(serial_obj.value());
-
-            if (const auto it = m_dispatch_table.find(func_name); it != m_dispatch_table.end())
+            if (body_start >= bytes.size())
             {
-                it->second(serial_obj.value());
-                return Serial::to_bytes(std::move(serial_obj).value());
+                return false;
             }
 
-            Serial::set_exception(serial_obj.value(),
-                function_not_found("RPC error: Called function: \"" + func_name + "\" not found"));
-
-            return Serial::to_bytes(std::move(serial_obj).value());
+            const auto first_byte = static_cast<uint8_t>(bytes[body_start]);
+            return (try_dispatch<Serials>(bytes, first_byte, on_reply) || ...);
         }
 
-    protected:
-        ~server_interface() noexcept = default;
-
 #  if defined(RPC_HPP_SERVER_IMPL) && defined(RPC_HPP_ENABLE_SERVER_CACHE)
-        template<typename R, typename... Args>
-        void dispatch_cached_func(std::function<R(Args...)> &func, typename Serial::serial_t& serial_obj)
+        ///@brief Shares the function caches of every adapter's server with every other server given the same object
+        ///
+        ///@note Must be called before binding any cached function
+        ///@param cache Caches to use for the functions bound to this server
+        void share_cache(const std::shared_ptr<shared_cache>& cache) noexcept
         {
-            RPC_HPP_PRECONDITION(func != nullptr);
-
-            auto pack = [&serial_obj]
-            {
-                try
-                {
-                    return Serial::template deserialize_pack<R, Args...>(serial_obj);
-                }
-                catch (const rpc_exception&)
-                {
-                    throw;
-                }
-                catch (const std::exception& ex)
-                {
-                    throw deserialization_error(ex.what());
-                }
-            }();
-
-            auto& result_cache = get_func_cache<R>(pack.get_func_name());
-
-            if constexpr (!std::is_void_v<R>)
-            {
-                auto bytes = Serial::to_bytes(std::move(serial_obj));
+            (get<Serials>().share_cache(cache), ...);
+        }
 
-                if (const auto it = result_cache.find(bytes); it != result_cache.end())
-                {
-                    pack.set_result(it->second);
+        ///@brief Determines the format of the data received on a given connection and dispatches it to the matching adapter's server
+        ///
+        ///@tparam F Callable taking the reply (as the bytes_t of the matching adapter)
+        ///@param bytes Data received
+        ///@param connection_id Identifier of the connection the data was received on, used to learn call sequences
+        ///@param on_reply Called with the reply, if an adapter accepted the request
+        ///@return bool Whether an adapter accepted the request
+        template<typename F>
+        bool dispatch(const std::string_view bytes, const size_t connection_id, F&& on_reply) const
+        {
+            const detail::connection_scope scope{ connection_id };
+            return dispatch(bytes, std::forward<F>(on_reply));
+        }
 
-                    try
-                    {
-                        serial_obj = Serial::template serialize_pack<R, Args...>(pack);
-                        return;
-                    }
-                    catch (const rpc_exception&)
-                    {
-                        throw;
-                    }
-                    catch (const std::exception& ex)
-                    {
-                        throw serialization_error(ex.what());
-                    }
-                }
+        ///@brief Discards the call sequence state for a closed connection
+        ///
+        ///@param connection_id Identifier of the connection passed to @ref dispatch
+        void forget_connection(const size_t connection_id)
+        {
+            (get<Serials>().forget_connection(connection_id), ...);
+        }
+#  endif
 
-                run_callback(std::forward<decltype(func)>(func), pack);
-                result_cache[std::move(bytes)] = pack.get_result();
-            }
-            else
-            {
-                run_callback(std::forward<decltype(func)>(func), pack);
-            }
+    private:
+        template<typename Serial>
+        class adapter_server final : public server_interface<Serial>
+        {
+        };
 
-            try
-            {
-                serial_obj = Serial::template serialize_pack<R, Args...>(pack);
-            }
-            catch (const rpc_exception&)
-            {
-                throw;
-            }
-            catch (const std::exception& ex)
-            {
-                throw serialization_error(ex.what());
-            }
-        }
-#  else
         template<typename R, typename... Args>
-        RPC_HPP_INLINE void dispatch_cached_func(
-            const std::function<R(Args...)> &&func, typename Serial::serial_t& serial_obj) const
+        [[nodiscard]] static std::function<R(Args...)> share_func(
+            const std::shared_ptr<const std::function<R(Args...)>>& shared_func)
         {
-            dispatch_func(std::forward<decltype(func)>(func), serial_obj);
+            return [shared_func](Args... args) -> R
+            { return (*shared_func)(std::forward<Args>(args)...); };
         }
-#  endif
 
-        template<typename R, typename... Args>
-        static void dispatch_func(const std::function<R(Args...)> &&func, typename Serial::serial_t& serial_obj)
+        // Whether no first byte is accepted by two of the adapters at Is (all but the last), and the last
+        // accepts at least one byte none of them accept
+        template<size_t... Is>
+        [[nodiscard]] static bool has_distinct_formats(std::index_sequence<Is...> /*unused*/) noexcept
         {
-            RPC_HPP_PRECONDITION(func != nullptr);
+            using last_t = std::tuple_element_t<sizeof...(Serials) - 1, std::tuple<Serials...>>;
+            bool last_reachable = false;
 
-            auto pack = [&serial_obj]
+            for (unsigned byte = 0; byte <= UINT8_MAX; ++byte)
             {
-                try
-                {
-                    return Serial::template deserialize_pack<R, Args...>(serial_obj);
-                }
-                catch (const rpc_exception&)
-                {
-                    throw;
-                }
-                catch (const std::exception& ex)
+                const auto first_byte = static_cast<uint8_t>(byte);
+                const size_t num_accepting = (size_t{ 0 } + ...
+                    + static_cast<size_t>(detail::may_start_with<
+                        std::tuple_element_t<Is, std::tuple<Serials...>>>(first_byte)));
+
+                if (num_accepting > 1)
                 {
-                    throw deserialization_error(ex.what());
+                    return false;
                 }
-            }();
-
-            run_callback(std::forward<decltype(func)>(func), pack);
 
-            try
-            {
-                serial_obj = Serial::template serialize_pack<R, Args...>(pack);
-            }
-            catch (const rpc_exception&)
-            {
-                throw;
-            }
-            catch (const std::exception& ex)
-            {
-                throw serialization_error(ex.what());
+                last_reachable =
+                    last_reachable || (num_accepting == 0 && detail::may_start_with<last_t>(first_byte));
             }
+
+            return last_reachable;
         }
 
-    private:
-        template<typename R, typename... Args>
-        static void run_callback(const std::function<R(Args...)> &&func, detail::packed_func<R, Args...>& pack)
+        template<typename Serial, typename F>
+        bool try_dispatch(const std::string_view bytes, const uint8_t first_byte, F& on_reply) const
         {
-            RPC_HPP_PRECONDITION(func != nullptr);
-
-            auto& args = pack.get_args();
-
-            if constexpr (std::is_void_v<R>)
-            {
-                try
-                {
-                    std::apply(func, args);
-                }
-                catch (const std::exception& ex)
-                {
-                    throw remote_exec_error(ex.what());
-                }
-            }
-            else
+            if (!detail::may_start_with<Serial>(first_byte))
             {
-                try
-                {
-                    auto result = std::apply(func, args);
-                    pack.set_result(std::move(result));
-                }
-                catch (const std::exception& ex)
-                {
-                    throw remote_exec_error(ex.what());
-                }
+                return false;
             }
-        }
-
-#  if defined(RPC_HPP_SERVER_IMPL) && defined(RPC_HPP_ENABLE_SERVER_CACHE)
-        template<typename Val>
-        static void* get_func_cache_impl(const std::string& func_name)
-        {
-            static std::unordered_map<std::string,
-                std::unordered_map<typename Serial::bytes_t, Val>>
-                cache{};
-
-            return &cache[func_name];
-        }
 
-        template<typename Val>
-        void update_all_cache(const std::string& func_name)
-        {
-            RPC_HPP_PRECONDITION(!func_name.empty());
+            // Both buffers are reused for later requests on this thread
+            thread_local typename Serial::bytes_t reply{};
+            auto request = buffer_pool<typename Serial::bytes_t>::local().acquire(
+                bytes.begin(), bytes.end());
 
-            m_cache_map.insert_or_assign(func_name, get_func_cache_impl<Val>(func_name));
+            std::get<adapter_server<Serial>>(m_servers).dispatch(std::move(request), reply);
+            on_reply(std::as_const(reply));
+            return true;
         }
 
-        std::unordered_map<std::string, void*> m_cache_map{};
-#  endif
-
-        std::unordered_map<std::string, std::function<void(typename Serial::serial_t&)>>
-            m_dispatch_table{};
+        std::tuple<adapter_server<Serials>...> m_servers{};
     };
 } // namespace server
 #endif
@@ -1013,23 +3752,36 @@ inline namespace client
         ///@throws client_send_error Thrown if error occurs during the @ref send function
         ///@throws client_receive_error Thrown if error occurs during the @ref receive function
         ///@note nodiscard because an expensive remote procedure call is being performed
+        ///@note May be called from several threads at once if @ref send and @ref receive may be
         template<typename R = void, typename... Args>
         [[nodiscard]] R call_func(std::string func_name, Args&&... args)
         {
             RPC_HPP_PRECONDITION(!func_name.empty());
 
-            auto bytes =
-                serialize_call<R, Args...>(std::move(func_name), std::forward<Args>(args)...);
+#  if defined(RPC_HPP_ENABLE_MESSAGE_HEADER)
+            message_header header{};
+            header.request_id = m_next_request_id.fetch_add(1, std::memory_order_relaxed);
+            header.func_name = func_name;
+#  endif
+
+            auto& request = request_buffer();
+            serialize_call<R, Args...>(request, std::move(func_name), std::forward<Args>(args)...);
+
+#  if defined(RPC_HPP_ENABLE_MESSAGE_HEADER)
+            header.prepend(request);
+#  endif
 
             try
             {
-                send(std::move(bytes));
+                send(request);
             }
             catch (const std::exception& ex)
             {
                 throw client_send_error(ex.what());
             }
 
+            typename Serial::bytes_t bytes{};
+
             try
             {
                 bytes = receive();
@@ -1039,6 +3791,10 @@ inline namespace client
                 throw client_receive_error(ex.what());
             }
 
+#  if defined(RPC_HPP_ENABLE_MESSAGE_HEADER)
+            strip_reply_header(bytes, header.request_id);
+#  endif
+
             const auto pack = deserialize_call<R, Args...>(std::move(bytes));
 
             // Assign values back to any (non-const) reference members
@@ -1065,7 +3821,12 @@ inline namespace client
         }
 
     protected:
-        client_interface(client_interface&&) noexcept = default;
+        client_interface([[maybe_unused]] client_interface&& other) noexcept
+#  if defined(RPC_HPP_ENABLE_MESSAGE_HEADER)
+            : m_next_request_id{ other.m_next_request_id.load(std::memory_order_relaxed) }
+#  endif
+        {
+        }
 
         ///@brief Sends serialized data to a server or module
         ///
@@ -1078,10 +3839,54 @@ inline namespace client
         virtual typename Serial::bytes_t receive() = 0;
 
     private:
+        // Requests are written into the same buffer for every call on a thread, so its capacity is reused
+        [[nodiscard]] static typename Serial::bytes_t& request_buffer() noexcept
+        {
+            thread_local typename Serial::bytes_t request{};
+            return request;
+        }
+
+#  if defined(RPC_HPP_ENABLE_MESSAGE_HEADER)
+        // Checks that the reply answers the request sent, and turns it into its body in place
+        static void strip_reply_header(typename Serial::bytes_t& bytes, const uint64_t request_id)
+        {
+            const auto header = message_header::read(bytes);
+
+            if (!header.has_value() || !header->is_response()
+                || header->size() + header->body_size != bytes.size())
+            {
+                throw client_receive_error("Client received invalid RPC object");
+            }
+
+            if (header->request_id == 0)
+            {
+                // The server could not read the request's header, so the body holds its error
+                header->remove_from(bytes);
+                const auto err_obj = Serial::from_bytes(std::move(bytes));
+
+                if (!err_obj.has_value())
+                {
+                    throw client_receive_error("Client received invalid RPC object");
+                }
+
+                const auto ex = Serial::extract_exception(err_obj.value());
+                detail::throw_exception(ex.get_type(), ex.what());
+            }
+
+            if (header->request_id != request_id)
+            {
+                throw client_receive_error("Client received the reply to another request");
+            }
+
+            header->remove_from(bytes);
+        }
+#  endif
+
         template<typename R, typename... Args>
-        static RPC_HPP_INLINE typename Serial::bytes_t serialize_call(
-            std::string func_name, Args&&... args)
+        static RPC_HPP_INLINE void serialize_call(
+            typename Serial::bytes_t& out, std::string func_name, Args&&... args)
         {
+            [[maybe_unused]] const typename Serial::request_scope scope{};
             detail::packed_func<R, detail::decay_str_t<Args>...> pack = [&]() noexcept
             {
                 if constexpr (std::is_void_v<R>)
@@ -1114,33 +3919,65 @@ inline namespace client
                 }
             }();
 
-            return Serial::to_bytes(std::move(serial_obj));
+            detail::write_bytes<Serial>(std::move(serial_obj), out);
+            detail::message_size_hints::update(pack.get_func_name(), out.size());
         }
 
         template<typename R, typename... Args>
         static RPC_HPP_INLINE auto deserialize_call(typename Serial::bytes_t&& bytes)
         {
-            const auto ret_obj = Serial::from_bytes(std::move(bytes));
+            [[maybe_unused]] const typename Serial::request_scope scope{};
 
-            if (!ret_obj.has_value())
+            if constexpr (detail::has_typed_parse_v<Serial>)
             {
-                throw client_receive_error("Client received invalid RPC object");
-            }
+                try
+                {
+                    auto pack = Serial::template parse_pack<R, detail::decay_str_t<Args>...>(bytes);
 
-            try
-            {
-                return Serial::template deserialize_pack<R, detail::decay_str_t<Args>...>(
-                    ret_obj.value());
-            }
-            catch (const rpc_exception&)
-            {
-                throw;
+                    // The reply was only read, so its buffer can serve a later message
+                    buffer_pool<typename Serial::bytes_t>::local().release(std::move(bytes));
+                    return pack;
+                }
+                catch (const rpc_exception&)
+                {
+                    throw;
+                }
+                catch (const std::exception& ex)
+                {
+                    throw deserialization_error(ex.what());
+                }
             }
-            catch (const std::exception& ex)
+            else
             {
-                throw deserialization_error(ex.what());
+                auto ret_obj = Serial::from_bytes(std::move(bytes));
+
+                if (!ret_obj.has_value())
+                {
+                    throw client_receive_error("Client received invalid RPC object");
+                }
+
+                try
+                {
+                    auto pack = Serial::template deserialize_pack<R, detail::decay_str_t<Args>...>(
+                        ret_obj.value());
+
+                    detail::recycle<Serial>(std::move(ret_obj).value());
+                    return pack;
+                }
+                catch (const rpc_exception&)
+                {
+                    throw;
+                }
+                catch (const std::exception& ex)
+                {
+                    throw deserialization_error(ex.what());
+                }
             }
         }
+
+#  if defined(RPC_HPP_ENABLE_MESSAGE_HEADER)
+        std::atomic<uint64_t> m_next_request_id{ 1 };
+#  endif
     };
 } // namespace client
 #endif
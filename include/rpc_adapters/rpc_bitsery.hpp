@@ -40,35 +40,90 @@
 
 #include <bitsery/bitsery.h>
 #include <bitsery/adapter/buffer.h>
+#include <bitsery/adapter/measure_size.h>
+#include <bitsery/ext/compact_value.h>
+#include <bitsery/ext/std_map.h>
+#include <bitsery/ext/std_optional.h>
+#include <bitsery/ext/std_set.h>
 #include <bitsery/ext/std_tuple.h>
+#include <bitsery/ext/std_variant.h>
 #include <bitsery/traits/array.h>
 #include <bitsery/traits/string.h>
 #include <bitsery/traits/vector.h>
 
+#include <array>
 #include <cassert>
+#include <cstring>
 #include <vector>
 
-#if defined(RPC_HPP_ENABLE_SERVER_CACHE)
-#    include <numeric>
+#if defined(RPC_HPP_BITSERY_EXACT_SZ) && defined(RPC_HPP_BITSERY_COMPACT)
+#  error RPC_HPP_BITSERY_EXACT_SZ and RPC_HPP_BITSERY_COMPACT cannot both be defined
+#endif
+
+#if defined(RPC_HPP_BITSERY_CHECKSUM) && defined(__SSE4_2__)
+#  include <nmmintrin.h>
+#endif
 
-template<>
-struct std::hash<std::vector<uint8_t>>
+namespace rpc_hpp
+{
+namespace detail
 {
-    [[nodiscard]] inline size_t operator()(const std::vector<uint8_t>& vec) const noexcept
+#if defined(RPC_HPP_BITSERY_CHECKSUM)
+    ///@brief Computes the CRC32C (Castagnoli) checksum of a byte range
+    ///
+    ///@details Uses the SSE4.2 crc32 instruction when compiled with support for it, otherwise
+    ///falls back to a lookup table
+    [[nodiscard]] inline uint32_t crc32c(const uint8_t* data, size_t size) noexcept
     {
-        static constexpr auto seed_hash = [](size_t seed, size_t val) noexcept
+        uint32_t crc = ~0U;
+
+#  if defined(__SSE4_2__)
+        uint64_t crc64 = crc;
+
+        for (; size >= sizeof(uint64_t); size -= sizeof(uint64_t), data += sizeof(uint64_t))
         {
-            static constexpr size_t magic_hash_val = 0x9E3779B9UL;
-            return seed ^ (val + magic_hash_val + (seed << 6) + (seed >> 2));
-        };
+            uint64_t chunk{};
+            memcpy(&chunk, data, sizeof(uint64_t));
+            crc64 = _mm_crc32_u64(crc64, chunk);
+        }
+
+        crc = static_cast<uint32_t>(crc64);
+
+        for (; size != 0; --size, ++data)
+        {
+            crc = _mm_crc32_u8(crc, *data);
+        }
+#  else
+        static constexpr auto table = []() noexcept
+        {
+            std::array<uint32_t, 256> arr{};
+
+            for (uint32_t i = 0; i < arr.size(); ++i)
+            {
+                uint32_t val = i;
+
+                for (int bit = 0; bit < 8; ++bit)
+                {
+                    val = (val >> 1U) ^ (0x82F63B78U & (0U - (val & 1U)));
+                }
+
+                arr[i] = val;
+            }
+
+            return arr;
+        }();
+
+        for (; size != 0; --size, ++data)
+        {
+            crc = (crc >> 8U) ^ table[(crc ^ *data) & 0xFFU];
+        }
+#  endif
 
-        return std::accumulate(vec.begin(), vec.end(), vec.size(), seed_hash);
+        return ~crc;
     }
-};
 #endif
+} // namespace detail
 
-namespace rpc_hpp
-{
 namespace adapters
 {
     class bitsery_adapter;
@@ -91,6 +146,12 @@ namespace adapters
             static constexpr bool use_exact_size = false;
 #endif
 
+#if defined(RPC_HPP_BITSERY_COMPACT)
+            static constexpr bool use_compact = true;
+#else
+            static constexpr bool use_compact = false;
+#endif
+
             static const uint64_t max_func_name_size;
             static const uint64_t max_string_size;
             static const uint64_t max_container_size;
@@ -98,19 +159,56 @@ namespace adapters
 
         [[nodiscard]] static std::vector<uint8_t> to_bytes(std::vector<uint8_t>&& serial_obj)
         {
+            write_frame_header(serial_obj);
             return std::move(serial_obj);
         }
 
+        ///@brief Hands the message's buffer over to out, giving out's previous buffer to the thread's buffer_pool
+        static void to_bytes(std::vector<uint8_t>&& serial_obj, std::vector<uint8_t>& out)
+        {
+            write_frame_header(serial_obj);
+            out.swap(serial_obj);
+            recycle(std::move(serial_obj));
+        }
+
+        ///@brief Gives the message's buffer back to the thread's buffer_pool
+        static void recycle(std::vector<uint8_t>&& serial_obj) noexcept
+        {
+            buffer_pool<std::vector<uint8_t>>::local().release(std::move(serial_obj));
+        }
+
         [[nodiscard]] static std::optional<std::vector<uint8_t>> from_bytes(
             std::vector<uint8_t>&& bytes)
         {
-            // TODO: Verify bitsery data somehow
+#if defined(RPC_HPP_BITSERY_CHECKSUM)
+            if (bytes.size() < frame_header_size)
+            {
+                return std::nullopt;
+            }
+
+            uint32_t payload_sz{};
+            uint32_t crc{};
+            memcpy(&payload_sz, bytes.data(), sizeof(uint32_t));
+            memcpy(&crc, bytes.data() + sizeof(uint32_t), sizeof(uint32_t));
+
+            if (payload_sz != bytes.size() - frame_header_size
+                || crc != detail::crc32c(bytes.data() + frame_header_size, payload_sz))
+            {
+                return std::nullopt;
+            }
+#endif
+
+            if (!validate_header(bytes))
+            {
+                return std::nullopt;
+            }
+
             return std::make_optional(std::move(bytes));
         }
 
         static std::vector<uint8_t> empty_object()
         {
-            std::vector<uint8_t> buffer(sizeof(int) + 2);
+            std::vector<uint8_t> buffer(frame_header_size + sizeof(int) + 2);
             bitsery::quickSerialization<output_adapter>(buffer, pack_helper<void>{});
             return buffer;
         }
@@ -119,15 +217,31 @@ namespace adapters
         [[nodiscard]] static std::vector<uint8_t> serialize_pack(
             const detail::packed_func<R, Args...>& pack)
         {
-            const auto helper = to_helper(pack);
-            std::vector<uint8_t> buffer{};
-            buffer.reserve(64);
+            auto buffer = buffer_pool<std::vector<uint8_t>>::local().acquire(
+                detail::message_size_hints::get(pack.get_func_name()));
 
-            const auto bytes_written = bitsery::quickSerialization<output_adapter>(buffer, helper);
-            buffer.resize(bytes_written);
+            serialize_pack(pack, buffer);
             return buffer;
         }
 
+        ///@brief Serializes a packed_func into a caller-provided buffer
+        ///
+        ///@details The exact size is measured first so the buffer is resized at most once and
+        ///its existing capacity is reused when large enough
+        template<typename R, typename... Args>
+        static void serialize_pack(
+            const detail::packed_func<R, Args...>& pack, std::vector<uint8_t>& buffer)
+        {
+            const auto helper = to_helper(pack);
+            const auto bytes_needed = bitsery::quickSerialization(bitsery::MeasureSize{}, helper);
+            buffer.resize(bytes_needed);
+
+            [[maybe_unused]] const auto bytes_written =
+                bitsery::quickSerialization<output_adapter>(buffer, helper);
+
+            assert(bytes_written == bytes_needed);
+        }
+
         template<typename R, typename... Args>
         [[nodiscard]] static detail::packed_func<R, Args...> deserialize_pack(
             const std::vector<uint8_t>& serial_obj)
@@ -169,7 +283,7 @@ namespace adapters
 
         [[nodiscard]] static std::string get_func_name(const std::vector<uint8_t>& serial_obj)
         {
-            size_t index = sizeof(int);
+            size_t index = frame_header_size + sizeof(int);
             const auto len = extract_length(serial_obj, index);
 
             assert(index < serial_obj.size());
@@ -187,41 +301,62 @@ namespace adapters
 
         static void set_exception(std::vector<uint8_t>& serial_obj, const rpc_exception& ex)
         {
-            // copy except_type into buffer
             const int ex_type = static_cast<int>(ex.get_type());
-            memcpy(&serial_obj[0], &ex_type, sizeof(int));
             const std::string_view mesg = ex.what();
-            const auto new_err_len = static_cast<unsigned>(mesg.size());
 
-            size_t index = sizeof(int);
-            const auto name_len = extract_length(serial_obj, index);
-            const size_t name_sz_len = index;
+            std::array<uint8_t, max_length_bytes> len_bytes{};
+            const size_t len_sz = encode_length(mesg.size(), len_bytes);
 
-            index += name_len;
+            size_t index = frame_header_size + sizeof(int);
+            size_t err_pos = 0;
+            size_t tail_pos = 0;
 
-            if (const auto err_len = extract_length(serial_obj, index); new_err_len != err_len)
+            if (serial_obj.size() >= frame_header_size + sizeof(int) + 2)
             {
-                if (err_len != 0)
-                {
-                    assert(index < serial_obj.size());
-                    assert(index <= std::numeric_limits<ptrdiff_t>::max());
+                const auto name_len = extract_length(serial_obj, index);
+                err_pos = index + name_len;
+                index = err_pos;
 
-                    serial_obj.erase(std::next(serial_obj.begin(), name_sz_len + name_len),
-                        std::next(serial_obj.begin(), index + err_len));
+                if (err_pos < serial_obj.size())
+                {
+                    const auto err_len = extract_length(serial_obj, index);
+                    tail_pos = index + err_len;
                 }
-
-                index = name_sz_len + name_len;
-                write_length(serial_obj, new_err_len, index);
             }
 
-            for (unsigned i = 0; i < new_err_len; ++i)
+            // Malformed buffer, replace it with an otherwise empty object
+            if (tail_pos == 0 || tail_pos > serial_obj.size())
             {
-                assert(index < serial_obj.size());
-                assert(index <= std::numeric_limits<ptrdiff_t>::max());
+                serial_obj = empty_object();
+                err_pos = frame_header_size + sizeof(int) + 1;
+                index = err_pos + 1;
+                tail_pos = index;
+            }
 
-                serial_obj.insert(
-                    std::next(serial_obj.begin(), index++), static_cast<unsigned char>(mesg[i]));
+            // Same sized message can be overwritten in place
+            if (index - err_pos == len_sz && tail_pos - index == mesg.size())
+            {
+                memcpy(serial_obj.data() + frame_header_size, &ex_type, sizeof(int));
+                memcpy(&serial_obj[index], mesg.data(), mesg.size());
+                return;
             }
+
+            // Otherwise rebuild the buffer in one pass: header + name, new error, then the
+            // result and arguments
+            std::vector<uint8_t> rebuilt{};
+            rebuilt.reserve(err_pos + len_sz + mesg.size() + (serial_obj.size() - tail_pos));
+            rebuilt.insert(rebuilt.end(), serial_obj.begin(),
+                std::next(serial_obj.begin(), static_cast<ptrdiff_t>(err_pos)));
+
+            rebuilt.insert(rebuilt.end(), len_bytes.begin(),
+                std::next(len_bytes.begin(), static_cast<ptrdiff_t>(len_sz)));
+
+            rebuilt.insert(rebuilt.end(), mesg.begin(), mesg.end());
+            rebuilt.insert(rebuilt.end(),
+                std::next(serial_obj.begin(), static_cast<ptrdiff_t>(tail_pos)), serial_obj.end());
+
+            memcpy(rebuilt.data() + frame_header_size, &ex_type, sizeof(int));
+            serial_obj = std::move(rebuilt);
         }
 
     private:
@@ -263,6 +398,114 @@ namespace adapters
         template<typename T>
         using largest_t = typename largest<T>::type;
 
+        // Integers of more than one byte are written as zigzag varints in compact mode
+        template<typename T>
+        static constexpr bool is_compact_v =
+            config::use_compact && std::is_integral_v<T> && (sizeof(T) > 1);
+
+        template<typename S, typename T>
+        static void serialize_value(S& s, T& val)
+        {
+            if constexpr (is_compact_v<T>)
+            {
+                s.ext(val, bitsery::ext::CompactValue{});
+            }
+            else
+            {
+                s.template value<sizeof(T)>(val);
+            }
+        }
+
+        template<typename S, typename T>
+        static void serialize_container(S& s, T& container)
+        {
+            using value_t = typename T::value_type;
+
+            // Fixed extents carry no length prefix and arithmetic ones are copied as one block
+            if constexpr (rpc_hpp::detail::is_fixed_extent_v<T>)
+            {
+                if constexpr (is_compact_v<value_t>)
+                {
+                    s.container(container,
+                        [](S& s2, value_t& val) { s2.ext(val, bitsery::ext::CompactValue{}); });
+                }
+                else if constexpr (std::is_arithmetic_v<value_t>)
+                {
+                    s.template container<sizeof(value_t)>(container);
+                }
+                else
+                {
+                    s.container(container, [](S& s2, value_t& val) { serialize_any(s2, val); });
+                }
+            }
+            else if constexpr (is_compact_v<value_t>)
+            {
+                s.container(container, config::max_container_size,
+                    [](S& s2, value_t& val) { s2.ext(val, bitsery::ext::CompactValue{}); });
+            }
+            else if constexpr (std::is_arithmetic_v<value_t>)
+            {
+                s.template container<sizeof(value_t)>(container, config::max_container_size);
+            }
+            else
+            {
+                s.container(container, config::max_container_size,
+                    [](S& s2, value_t& val) { serialize_any(s2, val); });
+            }
+        }
+
+        template<typename S, typename T>
+        static void serialize_any(S& s, T& val)
+        {
+            if constexpr (std::is_same_v<T, std::string>)
+            {
+                s.text1b(val, config::max_string_size);
+            }
+            else if constexpr (std::is_arithmetic_v<T>)
+            {
+                // Without exact sizes, arguments have already been widened to 8 bytes
+                serialize_value(s, val);
+            }
+            else if constexpr (rpc_hpp::detail::is_optional_v<T>)
+            {
+                s.ext(val, bitsery::ext::StdOptional{},
+                    [](S& s2, typename T::value_type& elem) { serialize_any(s2, elem); });
+            }
+            else if constexpr (rpc_hpp::detail::is_variant_v<T>)
+            {
+                s.ext(val,
+                    bitsery::ext::StdVariant{ [](auto& s2, auto& alt) { serialize_any(s2, alt); } });
+            }
+            else if constexpr (rpc_hpp::detail::is_map_v<T>)
+            {
+                s.ext(val, bitsery::ext::StdMap{ config::max_container_size },
+                    [](S& s2, typename T::key_type& key, typename T::mapped_type& mapped)
+                    {
+                        serialize_any(s2, key);
+                        serialize_any(s2, mapped);
+                    });
+            }
+            else if constexpr (rpc_hpp::detail::is_set_v<T>)
+            {
+                s.ext(val, bitsery::ext::StdSet{ config::max_container_size },
+                    [](S& s2, typename T::key_type& key) { serialize_any(s2, key); });
+            }
+            else if constexpr (rpc_hpp::detail::is_container_v<T>)
+            {
+                serialize_container(s, val);
+            }
+            else if constexpr (rpc_hpp::detail::is_reflected_v<T>)
+            {
+                auto fields = rpc_hpp_fields(val);
+                rpc_hpp::detail::for_each_tuple(
+                    fields, [&s](auto& field) { serialize_any(s, field); });
+            }
+            else
+            {
+                s.object(val);
+            }
+        }
+
         template<typename R, typename... Args>
         struct pack_helper
         {
@@ -278,6 +521,11 @@ namespace adapters
 
             pack_helper() = default;
 
+#if defined(RPC_HPP_BITSERY_CHECKSUM)
+            // Placeholder for the frame header, filled in by to_bytes
+            uint32_t frame_size{};
+            uint32_t frame_crc{};
+#endif
             int except_type{};
             std::string func_name{};
             std::string err_mesg{};
@@ -287,67 +535,18 @@ namespace adapters
             template<typename S>
             void serialize(S& s)
             {
+#if defined(RPC_HPP_BITSERY_CHECKSUM)
+                s.template value<sizeof(uint32_t)>(frame_size);
+                s.template value<sizeof(uint32_t)>(frame_crc);
+#endif
                 s.template value<sizeof(int)>(except_type);
                 s.text1b(func_name, config::max_func_name_size);
                 s.text1b(err_mesg, config::max_string_size);
 
-                if constexpr (std::is_arithmetic_v<R>)
-                {
-                    s.template value<sizeof(R)>(result);
-                }
-                else if constexpr (rpc_hpp::detail::is_container_v<R>)
-                {
-                    if constexpr (std::is_arithmetic_v<typename R::value_type>)
-                    {
-                        s.template container<sizeof(typename R::value_type)>(
-                            result, config::max_container_size);
-                    }
-                    else
-                    {
-                        s.container(result, config::max_container_size);
-                    }
-                }
-                else
-                {
-                    s.object(result);
-                }
+                serialize_any(s, result);
 
                 s.ext(args,
-                    ::bitsery::ext::StdTuple{ [](S& s2, std::string& str)
-                        { s2.text1b(str, config::max_string_size); },
-                        // Fallback serializer for integers, floats, and enums
-                        [](auto& s2, auto& val)
-                        {
-                            using T = std::remove_cv_t<std::remove_reference_t<decltype(val)>>;
-
-                            if constexpr (std::is_arithmetic_v<T>)
-                            {
-                                if constexpr (config::use_exact_size)
-                                {
-                                    s2.template value<sizeof(val)>(val);
-                                }
-                                else
-                                {
-                                    s2.value8b(val);
-                                }
-                            }
-                            else if constexpr (rpc_hpp::detail::is_container_v<T>)
-                            {
-                                if constexpr (std::is_arithmetic_v<typename T::value_type>)
-                                {
-                                    s2.template container<sizeof(typename T::value_type)>(
-                                        val, config::max_container_size);
-                                }
-                                else
-                                {
-                                    s2.container(val, config::max_container_size);
-                                }
-                            }
-                            else
-                            {
-                                s2.object(val);
-                            }
-                        } });
+                    bitsery::ext::StdTuple{ [](S& s2, auto& val) { serialize_any(s2, val); } });
             }
         };
 
@@ -363,6 +562,11 @@ namespace adapters
 
             pack_helper() = default;
 
+#if defined(RPC_HPP_BITSERY_CHECKSUM)
+            // Placeholder for the frame header, filled in by to_bytes
+            uint32_t frame_size{};
+            uint32_t frame_crc{};
+#endif
             int except_type{};
             std::string func_name{};
             std::string err_mesg{};
@@ -371,46 +575,16 @@ namespace adapters
             template<typename S>
             void serialize(S& s)
             {
+#if defined(RPC_HPP_BITSERY_CHECKSUM)
+                s.template value<sizeof(uint32_t)>(frame_size);
+                s.template value<sizeof(uint32_t)>(frame_crc);
+#endif
                 s.template value<sizeof(int)>(except_type);
                 s.text1b(func_name, config::max_func_name_size);
                 s.text1b(err_mesg, config::max_string_size);
 
                 s.ext(args,
-                    bitsery::ext::StdTuple{ [](S& s2, std::string& str)
-                        { s2.text1b(str, config::max_string_size); },
-                        // Fallback serializer for integers, floats, and enums
-                        [](auto& s2, auto& val)
-                        {
-                            using T = std::remove_cv_t<std::remove_reference_t<decltype(val)>>;
-
-                            if constexpr (std::is_arithmetic_v<T>)
-                            {
-                                if constexpr (config::use_exact_size)
-                                {
-                                    s2.template value<sizeof(val)>(val);
-                                }
-                                else
-                                {
-                                    s2.value8b(val);
-                                }
-                            }
-                            else if constexpr (rpc_hpp::detail::is_container_v<T>)
-                            {
-                                if constexpr (std::is_arithmetic_v<typename T::value_type>)
-                                {
-                                    s2.template container<sizeof(typename T::value_type)>(
-                                        val, config::max_container_size);
-                                }
-                                else
-                                {
-                                    s2.container(val, config::max_container_size);
-                                }
-                            }
-                            else
-                            {
-                                s2.object(val);
-                            }
-                        } });
+                    bitsery::ext::StdTuple{ [](S& s2, auto& val) { serialize_any(s2, val); } });
             }
         };
 
@@ -477,6 +651,89 @@ namespace adapters
             }
         }
 
+        static constexpr size_t max_length_bytes = 4;
+
+        // Serial objects reserve room for the frame header up front so to_bytes can fill it in
+        // without moving the payload
+#if defined(RPC_HPP_BITSERY_CHECKSUM)
+        static constexpr size_t frame_header_size = 2 * sizeof(uint32_t);
+#else
+        static constexpr size_t frame_header_size = 0;
+#endif
+
+        // Fills in the frame header reserved by serialize_pack: payload size followed by the CRC32C
+        // of the payload
+        static void write_frame_header([[maybe_unused]] std::vector<uint8_t>& serial_obj) noexcept
+        {
+#if defined(RPC_HPP_BITSERY_CHECKSUM)
+            RPC_HPP_PRECONDITION(serial_obj.size() >= frame_header_size);
+
+            const auto payload_sz = static_cast<uint32_t>(serial_obj.size() - frame_header_size);
+            const uint32_t crc = detail::crc32c(serial_obj.data() + frame_header_size, payload_sz);
+
+            memcpy(serial_obj.data(), &payload_sz, sizeof(uint32_t));
+            memcpy(serial_obj.data() + sizeof(uint32_t), &crc, sizeof(uint32_t));
+#endif
+        }
+
+        // Bounds-checked version of extract_length, returns false if the length is truncated
+        // or runs past the end of the buffer
+        [[nodiscard]] static bool scan_length(
+            const bit_buffer& bytes, size_t& index, size_t& length) noexcept
+        {
+            if (index >= bytes.size())
+            {
+                return false;
+            }
+
+            const uint8_t hb = bytes[index];
+            const size_t len_sz = hb < 0x80U ? 1 : ((hb & 0x40U) != 0U ? 4 : 2);
+
+            if (len_sz > bytes.size() - index)
+            {
+                return false;
+            }
+
+            length = extract_length(bytes, index);
+            return length <= bytes.size() - index;
+        }
+
+        // Checks the fixed fields of a message before any allocating decode is attempted
+        [[nodiscard]] static bool validate_header(const bit_buffer& bytes) noexcept
+        {
+            if (bytes.size() < frame_header_size + sizeof(int) + 2)
+            {
+                return false;
+            }
+
+            int ex_type{};
+            memcpy(&ex_type, bytes.data() + frame_header_size, sizeof(int));
+
+            if (ex_type < 0 || ex_type > static_cast<int>(exception_type::server_receive))
+            {
+                return false;
+            }
+
+            size_t index = frame_header_size + sizeof(int);
+            size_t name_len{};
+
+            if (!scan_length(bytes, index, name_len) || name_len > config::max_func_name_size)
+            {
+                return false;
+            }
+
+            index += name_len;
+            size_t err_len{};
+
+            if (!scan_length(bytes, index, err_len) || err_len > config::max_string_size)
+            {
+                return false;
+            }
+
+            // Objects with exceptions can be otherwise empty
+            return ex_type == 0 ? name_len != 0 : err_len != 0;
+        }
+
         // Borrowed from Bitsery library for compatibility
         static unsigned extract_length(const bit_buffer& bytes, size_t& index) noexcept
         {
@@ -489,13 +746,22 @@ namespace adapters
                 return hb;
             }
 
-            assert(index < bytes.size());
+            if (index >= bytes.size())
+            {
+                return 0;
+            }
+
             const uint8_t lb = bytes[index++];
 
             if ((hb & 0x40U) != 0U)
             {
-                assert(index < bytes.size());
-                const uint16_t lw = *reinterpret_cast<const uint16_t*>(&bytes[index++]);
+                if (index + 1 >= bytes.size())
+                {
+                    return 0;
+                }
+
+                const auto lw = static_cast<unsigned>(bytes[index] | (bytes[index + 1] << 8));
+                index += 2;
                 return ((((hb & 0x3FU) << 8) | lb) << 16) | lw;
             }
 
@@ -503,38 +769,28 @@ namespace adapters
         }
 
         // Borrowed from Bitsery library for compatibility
-        static void write_length(bit_buffer& bytes, size_t size, size_t& index)
+        static size_t encode_length(size_t size, std::array<uint8_t, max_length_bytes>& bytes)
         {
             RPC_HPP_PRECONDITION(size < 0x40000000U);
 
             if (size < 0x80U)
             {
-                assert(index < size);
-                assert(index <= std::numeric_limits<ptrdiff_t>::max());
-
-                bytes.insert(std::next(bytes.begin(), index++), static_cast<uint8_t>(size));
-                return;
+                bytes[0] = static_cast<uint8_t>(size);
+                return 1;
             }
 
             if (size < 0x4000U)
             {
-                bytes.insert(
-                    std::next(bytes.begin(), index++), static_cast<uint8_t>((size >> 8) | 0x80U));
-
-                bytes.insert(std::next(bytes.begin(), index++), static_cast<uint8_t>(size));
-                return;
+                bytes[0] = static_cast<uint8_t>((size >> 8) | 0x80U);
+                bytes[1] = static_cast<uint8_t>(size);
+                return 2;
             }
 
-            bytes.insert(
-                std::next(bytes.begin(), index++), static_cast<uint8_t>((size >> 24) | 0xC0U));
-
-            bytes.insert(std::next(bytes.begin(), index++), static_cast<uint8_t>(size >> 16));
-
-            bytes.insert(
-                std::next(bytes.begin(), index++), *reinterpret_cast<const uint8_t*>(&size));
-
-            bytes.insert(
-                std::next(bytes.begin(), index++), *reinterpret_cast<const uint8_t*>(&size) + 1);
+            bytes[0] = static_cast<uint8_t>((size >> 24) | 0xC0U);
+            bytes[1] = static_cast<uint8_t>(size >> 16);
+            bytes[2] = static_cast<uint8_t>(size);
+            bytes[3] = static_cast<uint8_t>(size >> 8);
+            return 4;
         }
     };
 } // namespace adapters
@@ -37,11 +37,69 @@
 #pragma once
 
 #include "../rpc.hpp"
+#include "rpc_json_reader.hpp"
 
 #include <boost/json.hpp>
 
+#include <array>
+
+#if !defined(RPC_HPP_BOOST_JSON_ARENA_SIZE)
+#  define RPC_HPP_BOOST_JSON_ARENA_SIZE 65536
+#endif
+
 namespace rpc_hpp
 {
+namespace detail
+{
+    // Per-thread monotonic resource shared by the values of a request, released when the outermost
+    // request scope ends so that its buffer is reused instead of allocating from the heap
+    class boost_json_arena
+    {
+    public:
+        class scope
+        {
+        public:
+            scope() noexcept { ++get_state().depth; }
+
+            scope(const scope&) = delete;
+            scope& operator=(const scope&) = delete;
+
+            ~scope() noexcept
+            {
+                auto& state = get_state();
+
+                if (--state.depth == 0)
+                {
+                    state.resource.release();
+                }
+            }
+        };
+
+        // Outside of a request scope values use the default heap, as they may outlive the request
+        [[nodiscard]] static boost::json::storage_ptr storage() noexcept
+        {
+            auto& state = get_state();
+            return state.depth == 0 ? boost::json::storage_ptr{}
+                                    : boost::json::storage_ptr{ &state.resource };
+        }
+
+    private:
+        struct state_t
+        {
+            alignas(std::max_align_t)
+                std::array<unsigned char, RPC_HPP_BOOST_JSON_ARENA_SIZE> buffer{};
+            boost::json::monotonic_resource resource{ buffer.data(), buffer.size() };
+            unsigned depth{ 0 };
+        };
+
+        [[nodiscard]] static state_t& get_state() noexcept
+        {
+            thread_local state_t state{};
+            return state;
+        }
+    };
+} // namespace detail
+
 namespace adapters
 {
     class boost_json_adapter;
@@ -56,62 +114,133 @@ namespace adapters
     class boost_json_adapter : public detail::serial_adapter_base<boost_json_adapter>
     {
     public:
+        ///@brief While alive, values on this thread allocate from a reused per-thread arena
+        using request_scope = detail::boost_json_arena::scope;
+
         [[nodiscard]] static std::string to_bytes(boost::json::value&& serial_obj)
         {
             return boost::json::serialize(serial_obj);
         }
 
+        ///@brief Writes the object into out (replacing its contents), reusing its capacity
+        static void to_bytes(boost::json::value&& serial_obj, std::string& out)
+        {
+            boost::json::serializer serializer{};
+            serializer.reset(&serial_obj);
+
+            // Serialized in chunks straight into out, growing it only once its capacity is used up
+            out.resize(out.capacity());
+            size_t used = 0;
+
+            while (!serializer.done())
+            {
+                if (used == out.size())
+                {
+                    out.resize(2 * out.size());
+                }
+
+                used += serializer.read(&out[used], out.size() - used).size();
+            }
+
+            out.resize(used);
+        }
+
+        ///@brief Whether a message in this format can start with byte (lets multi_server recognize the format)
+        [[nodiscard]] static constexpr bool may_start_with(const uint8_t byte) noexcept
+        {
+            return detail::is_json_text_start(byte);
+        }
+
         [[nodiscard]] static std::optional<boost::json::object> from_bytes(std::string&& bytes)
         {
+            // The per-thread parser keeps its internal buffers between messages
+            auto& parser = thread_parser();
+            parser.reset(detail::boost_json_arena::storage());
+
             boost::system::error_code ec;
-            boost::json::value val = boost::json::parse(bytes, ec);
+            parser.write(bytes.data(), bytes.size(), ec);
 
-            if (ec)
+            if (!ec)
             {
-                return std::nullopt;
+                parser.finish(ec);
             }
 
-            if (!val.is_object())
+            if (ec)
             {
                 return std::nullopt;
             }
 
-            const auto& obj = val.get_object();
+            // The object holds copies of the strings, so the buffer can serve a later message
+            buffer_pool<std::string>::local().release(std::move(bytes));
+            return validate(parser.release());
+        }
 
-            if (const auto ex_it = obj.find("except_type"); ex_it != obj.end())
+        ///@brief Parses a message that arrives in several parts, e.g. from partial socket reads
+        class message_stream
+        {
+        public:
+            message_stream() { m_parser.reset(detail::boost_json_arena::storage()); }
+
+            ///@brief Feeds the next part of the message
+            ///
+            ///@param chunk Bytes received
+            ///@return size_t Number of bytes consumed, less than chunk.size() if the message ended
+            /// within it
+            size_t write(const std::string_view chunk)
             {
-                if (const auto& ex_val = ex_it->value();
-                    !ex_val.is_int64() || (ex_val.get_int64() != 0 && !obj.contains("err_mesg")))
+                if (m_failed)
                 {
-                    return std::nullopt;
+                    return chunk.size();
                 }
 
-                // Objects with exceptions can be otherwise empty
-                return std::make_optional(std::move(obj));
-            }
+                boost::system::error_code ec;
+                const auto consumed = m_parser.write_some(chunk.data(), chunk.size(), ec);
 
-            if (const auto fname_it = obj.find("func_name"); fname_it == obj.end()
-                || !fname_it->value().is_string() || fname_it->value().get_string().empty())
-            {
-                return std::nullopt;
+                if (ec)
+                {
+                    m_failed = true;
+                    return chunk.size();
+                }
+
+                return consumed;
             }
 
-            if (const auto args_it = obj.find("args");
-                args_it == obj.end() || !args_it->value().is_array())
+            ///@brief Whether a full message (or invalid input) has been read
+            [[nodiscard]] bool done() const noexcept { return m_failed || m_parser.done(); }
+
+            ///@brief Returns the message read so far and resets the stream for the next one
+            ///
+            ///@return std::optional<boost::json::object> The message (std::nullopt if it is
+            /// incomplete or invalid)
+            [[nodiscard]] std::optional<boost::json::object> release()
             {
-                return std::nullopt;
+                std::optional<boost::json::object> obj{};
+
+                if (!m_failed && m_parser.done())
+                {
+                    obj = validate(m_parser.release());
+                }
+
+                m_failed = false;
+                m_parser.reset(detail::boost_json_arena::storage());
+                return obj;
             }
 
-            return std::make_optional(std::move(obj));
-        }
+        private:
+            boost::json::stream_parser m_parser{};
+            bool m_failed{ false };
+        };
 
-        static boost::json::object empty_object() { return boost::json::object{}; }
+        static boost::json::object empty_object()
+        {
+            return boost::json::object(detail::boost_json_arena::storage());
+        }
 
         template<typename R, typename... Args>
         [[nodiscard]] static boost::json::object serialize_pack(
             const detail::packed_func<R, Args...>& pack)
         {
-            boost::json::object obj{};
+            boost::json::object obj(detail::boost_json_arena::storage());
             obj["func_name"] = pack.get_func_name();
             auto& args = obj["args"].emplace_array();
             args.reserve(sizeof...(Args));
@@ -143,56 +272,75 @@ namespace adapters
             typename detail::packed_func<R, Args...>::args_t args{ parse_args<Args>(
                 args_val, arg_counter)... };
 
+            std::string func_name{ as_view(serial_obj.at("func_name")) };
+            const auto* const except_val = serial_obj.if_contains("except_type");
+
             if constexpr (std::is_void_v<R>)
             {
-                detail::packed_func<void, Args...> pack(
-                    serial_obj.at("func_name").get_string().c_str(), std::move(args));
+                detail::packed_func<void, Args...> pack(std::move(func_name), std::move(args));
 
-                if (serial_obj.contains("except_type"))
+                if (except_val != nullptr)
                 {
-                    pack.set_exception(serial_obj.at("err_mesg").get_string().c_str(),
-                        static_cast<exception_type>(serial_obj.at("except_type").get_int64()));
+                    pack.set_exception(std::string{ as_view(serial_obj.at("err_mesg")) },
+                        static_cast<exception_type>(except_val->get_int64()));
                 }
 
                 return pack;
             }
             else
             {
-                if (serial_obj.contains("result") && !serial_obj.at("result").is_null())
+                const auto* const result_val = serial_obj.if_contains("result");
+
+                // A null result is a valid value for std::optional
+                if (result_val != nullptr
+                    && (detail::is_optional_v<R> ? except_val == nullptr : !result_val->is_null()))
                 {
                     return detail::packed_func<R, Args...>(
-                        serial_obj.at("func_name").get_string().c_str(),
-                        parse_arg<R>(serial_obj.at("result")), std::move(args));
+                        std::move(func_name), parse_arg<R>(*result_val), std::move(args));
                 }
 
                 detail::packed_func<R, Args...> pack(
-                    serial_obj.at("func_name").get_string().c_str(), std::nullopt, std::move(args));
+                    std::move(func_name), std::nullopt, std::move(args));
 
-                if (serial_obj.contains("except_type"))
+                if (except_val != nullptr)
                 {
-                    pack.set_exception(serial_obj.at("err_mesg").get_string().c_str(),
-                        static_cast<exception_type>(serial_obj.at("except_type").get_int64()));
+                    pack.set_exception(std::string{ as_view(serial_obj.at("err_mesg")) },
+                        static_cast<exception_type>(except_val->get_int64()));
                 }
 
                 return pack;
             }
         }
 
-        [[nodiscard]] static std::string get_func_name(const boost::json::object& serial_obj)
+        [[nodiscard]] static std::optional<std::string> peek_func_name(const std::string& bytes)
+        {
+            return detail::json_text_parser<boost_json_adapter>::peek_func_name(bytes);
+        }
+
+        ///@brief Parses a message straight into a packed_func, without building a document
+        template<typename R, typename... Args>
+        [[nodiscard]] static detail::packed_func<R, Args...> parse_pack(const std::string& bytes)
+        {
+            return detail::json_text_parser<boost_json_adapter>::template parse_pack<R, Args...>(
+                bytes);
+        }
+
+        ///@brief Returns a view of the function name, valid while serial_obj is alive
+        [[nodiscard]] static std::string_view get_func_name(const boost::json::object& serial_obj)
         {
-            return  serial_obj.at("func_name").get_string().c_str();
+            return as_view(serial_obj.at("func_name"));
         }
 
         [[nodiscard]] static rpc_exception extract_exception(const boost::json::object& serial_obj)
         {
-            return rpc_exception{ serial_obj.at("err_mesg").as_string().c_str(),
+            return rpc_exception{ std::string{ as_view(serial_obj.at("err_mesg")) },
                 static_cast<exception_type>(serial_obj.at("except_type").as_int64()) };
         }
 
         static void set_exception(boost::json::object& serial_obj, const rpc_exception& ex)
         {
             serial_obj["except_type"] = static_cast<int>(ex.get_type());
-            serial_obj["err_mesg"] = boost::json::string{ ex.what() };
+            serial_obj["err_mesg"].emplace_string().assign(ex.what());
         }
 
         template<typename T>
@@ -202,6 +350,133 @@ namespace adapters
         static T deserialize(const boost::json::object& serial_obj) = delete;
 
     private:
+        friend class detail::json_text_parser<boost_json_adapter>;
+
+        // Checks that a parsed value is a well-formed message
+        [[nodiscard]] static std::optional<boost::json::object> validate(boost::json::value&& val)
+        {
+            if (val.is_array())
+            {
+                return from_compact(val.get_array());
+            }
+
+            if (!val.is_object())
+            {
+                return std::nullopt;
+            }
+
+            auto& obj = val.get_object();
+
+            if (const auto ex_it = obj.find("except_type"); ex_it != obj.end())
+            {
+                if (const auto& ex_val = ex_it->value();
+                    !ex_val.is_int64() || (ex_val.get_int64() != 0 && !obj.contains("err_mesg")))
+                {
+                    return std::nullopt;
+                }
+
+                // Objects with exceptions can be otherwise empty
+                return std::make_optional(std::move(obj));
+            }
+
+            if (const auto fname_it = obj.find("func_name"); fname_it == obj.end()
+                || !fname_it->value().is_string() || fname_it->value().get_string().empty())
+            {
+                return std::nullopt;
+            }
+
+            if (const auto args_it = obj.find("args");
+                args_it == obj.end() || !args_it->value().is_array())
+            {
+                return std::nullopt;
+            }
+
+            return std::make_optional(std::move(obj));
+        }
+
+        // Messages are always written as objects, since serial_t cannot hold an array. A compact
+        // envelope (see detail::compact_envelope) from another adapter is rebuilt with named fields
+        [[nodiscard]] static std::optional<boost::json::object> from_compact(
+            boost::json::array& arr)
+        {
+            using envelope = detail::compact_envelope;
+
+            if (arr.size() < envelope::args_index || !arr[envelope::version_index].is_int64()
+                || arr[envelope::version_index].get_int64() != envelope::version
+                || !arr[envelope::flags_index].is_int64()
+                || arr[envelope::flags_index].get_int64() < 0
+                || !arr[envelope::func_name_index].is_string())
+            {
+                return std::nullopt;
+            }
+
+            const bool has_error = envelope::has_error(
+                static_cast<unsigned>(arr[envelope::flags_index].get_int64()));
+
+            auto& slot = arr[envelope::result_index];
+            boost::json::object obj(arr.storage());
+            obj["func_name"] = std::move(arr[envelope::func_name_index]);
+
+            if (has_error)
+            {
+                auto* const err_arr = slot.if_array();
+
+                if (err_arr == nullptr || err_arr->size() != 2 || !(*err_arr)[0].is_int64()
+                    || !(*err_arr)[1].is_string())
+                {
+                    return std::nullopt;
+                }
+
+                obj["except_type"] = (*err_arr)[0].get_int64();
+                obj["err_mesg"] = std::move((*err_arr)[1]);
+
+                // Replies that only report an error can omit the arguments
+                if (arr.size() == envelope::args_index)
+                {
+                    return std::make_optional(std::move(obj));
+                }
+            }
+            else if (obj.at("func_name").get_string().empty())
+            {
+                return std::nullopt;
+            }
+            else
+            {
+                obj["result"] = std::move(slot);
+            }
+
+            auto& args = obj["args"].emplace_array();
+            args.reserve(arr.size() - envelope::args_index);
+
+            for (size_t i = envelope::args_index; i < arr.size(); ++i)
+            {
+                args.push_back(std::move(arr[i]));
+            }
+
+            return std::make_optional(std::move(obj));
+        }
+
+        [[nodiscard]] static boost::json::stream_parser& thread_parser()
+        {
+            thread_local boost::json::stream_parser parser{};
+            return parser;
+        }
+
+        // Boost.JSON strings know their size, so they can be viewed without a strlen
+        [[nodiscard]] static std::string_view as_view(const boost::json::value& val)
+        {
+            const auto& str = val.as_string();
+            return { str.data(), str.size() };
+        }
+
+        // Numeric containers are sent as base64 strings holding their raw (host order) bytes.
+        // Decoding accepts both forms regardless of this setting
+#if defined(RPC_HPP_BOOST_JSON_BINARY_ARRAYS)
+        static constexpr bool use_binary_arrays = true;
+#else
+        static constexpr bool use_binary_arrays = false;
+#endif
+
         template<typename T>
         [[nodiscard]] static constexpr bool validate_arg(const boost::json::value& arg) noexcept
         {
@@ -221,10 +496,38 @@ namespace adapters
             {
                 return arg.is_string();
             }
+            else if constexpr (rpc_hpp::detail::is_optional_v<T>)
+            {
+                // null or the contained value, which is validated when parsed
+                return true;
+            }
+            else if constexpr (rpc_hpp::detail::is_variant_v<T>)
+            {
+                return arg.is_array() && arg.get_array().size() == 2
+                    && (arg.get_array()[0].is_int64() || arg.get_array()[0].is_uint64());
+            }
+            else if constexpr (rpc_hpp::detail::is_string_map_v<T>)
+            {
+                return arg.is_object();
+            }
+            else if constexpr (rpc_hpp::detail::is_byte_container_v<T>)
+            {
+                return arg.is_string();
+            }
+            else if constexpr (rpc_hpp::detail::is_bulk_container_v<T>)
+            {
+                return arg.is_array() || arg.is_string();
+            }
             else if constexpr (rpc_hpp::detail::is_container_v<T>)
             {
                 return arg.is_array();
             }
+            else if constexpr (!rpc_hpp::detail::is_serializable_v<boost_json_adapter, T>
+                && !rpc_hpp::detail::is_reflected_v<T> && boost::json::has_value_to<T>::value)
+            {
+                // Checked by the type's own conversion
+                return true;
+            }
             else
             {
                 return arg.is_object();
@@ -280,12 +583,63 @@ namespace adapters
             }
             else if constexpr (std::is_same_v<no_ref_t, std::string>)
             {
-                obj = boost::json::string{ arg.c_str() };
+                obj.emplace_string().assign(arg.data(), arg.size());
+            }
+            else if constexpr (rpc_hpp::detail::is_optional_v<no_ref_t>)
+            {
+                if (arg.has_value())
+                {
+                    push_arg(*arg, obj);
+                }
+                else
+                {
+                    obj = nullptr;
+                }
+            }
+            else if constexpr (rpc_hpp::detail::is_variant_v<no_ref_t>)
+            {
+                // Encoded as [index, value]
+                auto& arr = obj.emplace_array();
+                arr.reserve(2);
+                arr.emplace_back(arg.index());
+                std::visit([&arr](const auto& val) { push_args(val, arr); }, arg);
+            }
+            else if constexpr (rpc_hpp::detail::is_string_map_v<no_ref_t>)
+            {
+                auto& map_obj = obj.emplace_object();
+                map_obj.reserve(arg.size());
+
+                for (const auto& [key, val] : arg)
+                {
+                    push_arg(val, map_obj[key]);
+                }
+            }
+            else if constexpr (rpc_hpp::detail::is_map_v<no_ref_t>)
+            {
+                // Non-string keys are encoded as an array of [key, value] pairs
+                auto& arr = obj.emplace_array();
+                arr.reserve(arg.size());
+
+                for (const auto& [key, val] : arg)
+                {
+                    boost::json::array pair(arr.storage());
+                    pair.reserve(2);
+                    push_args(key, pair);
+                    push_args(val, pair);
+                    arr.emplace_back(std::move(pair));
+                }
+            }
+            else if constexpr ((use_binary_arrays && rpc_hpp::detail::is_bulk_container_v<no_ref_t>)
+                || rpc_hpp::detail::is_byte_container_v<no_ref_t>)
+            {
+                const auto byte_size = arg.size() * sizeof(typename no_ref_t::value_type);
+                auto& text = obj.emplace_string();
+                text.resize(rpc_hpp::detail::base64_encoded_size(byte_size));
+                rpc_hpp::detail::base64_encode(arg.data(), byte_size, text.data());
             }
             else if constexpr (rpc_hpp::detail::is_container_v<no_ref_t>)
             {
-                obj = boost::json::array{};
-                auto& arr = obj.get_array();
+                auto& arr = obj.emplace_array();
                 arr.reserve(arg.size());
 
                 for (auto&& val : arg)
@@ -297,6 +651,20 @@ namespace adapters
             {
                 obj = no_ref_t::template serialize<boost_json_adapter>(std::forward<T>(arg));
             }
+            else if constexpr (rpc_hpp::detail::is_reflected_v<no_ref_t>)
+            {
+                auto& fields_obj = obj.emplace_object();
+                fields_obj.reserve(rpc_hpp::detail::field_count_v<no_ref_t>);
+
+                rpc_hpp::detail::for_each_field(arg,
+                    [&fields_obj](const std::string_view name, const auto& field)
+                    { push_arg(field, fields_obj[name]); });
+            }
+            else if constexpr (boost::json::has_value_from<no_ref_t>::value)
+            {
+                // Types with a tag_invoke overload write straight into the value (and its storage)
+                boost::json::value_from(std::forward<T>(arg), obj);
+            }
             else
             {
                 obj = serialize<no_ref_t>(std::forward<T>(arg));
@@ -322,10 +690,105 @@ namespace adapters
                 throw function_mismatch(mismatch_string(typeid(no_ref_t).name(), arg));
             }
 
+            if constexpr (rpc_hpp::detail::is_bulk_container_v<no_ref_t>)
+            {
+                if (arg.is_string())
+                {
+                    return parse_bulk<no_ref_t>(arg);
+                }
+            }
+
             if constexpr (std::is_arithmetic_v<no_ref_t> || std::is_same_v<no_ref_t, std::string>)
             {
                 return boost::json::value_to<no_ref_t>(arg);
             }
+            else if constexpr (rpc_hpp::detail::is_optional_v<no_ref_t>)
+            {
+                if (arg.is_null())
+                {
+                    return std::nullopt;
+                }
+
+                return parse_arg<typename no_ref_t::value_type>(arg);
+            }
+            else if constexpr (rpc_hpp::detail::is_variant_v<no_ref_t>)
+            {
+                const auto& arr = arg.get_array();
+                const auto& val = arr[1];
+
+                return rpc_hpp::detail::make_variant<no_ref_t>(
+                    boost::json::value_to<size_t>(arr[0]),
+                    [&val](auto tag) { return parse_arg<typename decltype(tag)::type>(val); });
+            }
+            else if constexpr (rpc_hpp::detail::is_string_map_v<no_ref_t>)
+            {
+                const auto& map_obj = arg.get_object();
+                no_ref_t container{};
+                rpc_hpp::detail::reserve_if_able(container, map_obj.size());
+
+                for (const auto& member : map_obj)
+                {
+                    rpc_hpp::detail::emplace_assoc(container, std::string{ member.key() },
+                        parse_arg<typename no_ref_t::mapped_type>(member.value()));
+                }
+
+                return container;
+            }
+            else if constexpr (rpc_hpp::detail::is_map_v<no_ref_t>)
+            {
+                const auto& arr = arg.get_array();
+                no_ref_t container{};
+                rpc_hpp::detail::reserve_if_able(container, arr.size());
+
+                for (const auto& pair : arr)
+                {
+                    if (!pair.is_array() || pair.get_array().size() != 2)
+                    {
+                        throw function_mismatch(mismatch_string("[key, value]", pair));
+                    }
+
+                    const auto& key_val = pair.get_array();
+
+                    rpc_hpp::detail::emplace_assoc(container,
+                        parse_arg<typename no_ref_t::key_type>(key_val[0]),
+                        parse_arg<typename no_ref_t::mapped_type>(key_val[1]));
+                }
+
+                return container;
+            }
+            else if constexpr (rpc_hpp::detail::is_set_v<no_ref_t>)
+            {
+                const auto& arr = arg.get_array();
+                no_ref_t container{};
+                rpc_hpp::detail::reserve_if_able(container, arr.size());
+
+                for (const auto& val : arr)
+                {
+                    rpc_hpp::detail::emplace_assoc(
+                        container, parse_arg<typename no_ref_t::value_type>(val));
+                }
+
+                return container;
+            }
+            else if constexpr (rpc_hpp::detail::is_byte_container_v<no_ref_t>)
+            {
+                return parse_bulk<no_ref_t>(arg);
+            }
+            else if constexpr (rpc_hpp::detail::is_fixed_extent_v<no_ref_t>)
+            {
+                using subvalue_t = typename no_ref_t::value_type;
+
+                const auto& arr = arg.get_array();
+                rpc_hpp::detail::check_extent<no_ref_t>(arr.size());
+                no_ref_t container{};
+
+                for (size_t i = 0; i < container.size(); ++i)
+                {
+                    container[i] = parse_arg<subvalue_t>(arr[i]);
+                }
+
+                return container;
+            }
             else if constexpr (rpc_hpp::detail::is_container_v<no_ref_t>)
             {
                 using subvalue_t = typename no_ref_t::value_type;
@@ -333,11 +796,10 @@ namespace adapters
                 auto& arr = arg.get_array();
                 no_ref_t container{};
                 container.reserve(arr.size());
-                unsigned arg_counter = 0;
 
                 for (const auto& val : arr)
                 {
-                    container.push_back(parse_args<subvalue_t>(val, arg_counter));
+                    container.push_back(parse_arg<subvalue_t>(val));
                 }
 
                 return container;
@@ -346,12 +808,72 @@ namespace adapters
             {
                 return no_ref_t::template deserialize<boost_json_adapter>(arg.get_object());
             }
+            else if constexpr (rpc_hpp::detail::is_reflected_v<no_ref_t>)
+            {
+                const auto& fields_obj = arg.get_object();
+                no_ref_t val{};
+
+                rpc_hpp::detail::for_each_field(val,
+                    [&fields_obj](const std::string_view name, auto& field)
+                    {
+                        const auto* const field_val = fields_obj.if_contains(name);
+
+                        if (field_val == nullptr)
+                        {
+                            throw function_mismatch(
+                                "Boost.JSON missing field: " + std::string{ name });
+                        }
+
+                        field = parse_arg<std::remove_reference_t<decltype(field)>>(*field_val);
+                    });
+
+                return val;
+            }
+            else if constexpr (boost::json::has_value_to<no_ref_t>::value)
+            {
+                try
+                {
+                    return boost::json::value_to<no_ref_t>(arg);
+                }
+                catch (const rpc_exception&)
+                {
+                    throw;
+                }
+                catch (const std::exception& ex)
+                {
+                    throw function_mismatch(
+                        std::string{ "Boost.JSON could not convert value: " } + ex.what());
+                }
+            }
             else
             {
                 return deserialize<no_ref_t>(arg.get_object());
             }
         }
 
+        template<typename C>
+        [[nodiscard]] static C parse_bulk(const boost::json::value& arg)
+        {
+            const auto& str = arg.get_string();
+            const std::string_view text{ str.data(), str.size() };
+            const auto byte_size = rpc_hpp::detail::base64_decoded_size(text);
+
+            if (!byte_size.has_value())
+            {
+                throw function_mismatch(mismatch_string(typeid(C).name(), arg));
+            }
+
+            C container{};
+
+            if (!rpc_hpp::detail::base64_decode(
+                    text, rpc_hpp::detail::resize_bulk(container, *byte_size)))
+            {
+                throw function_mismatch(mismatch_string(typeid(C).name(), arg));
+            }
+
+            return container;
+        }
+
         template<typename T>
         [[nodiscard]] static std::remove_cv_t<std::remove_reference_t<T>> parse_args(
             const boost::json::value& arg_arr, unsigned& index)
@@ -370,6 +892,22 @@ namespace adapters
 
             return parse_arg<T>(arr[index++]);
         }
+
+        // Parses the text of a single value, for types only readable from a document
+        template<typename T>
+        [[nodiscard]] static T parse_text(const std::string_view text)
+        {
+            boost::system::error_code ec;
+            const boost::json::value val =
+                boost::json::parse(text, ec, detail::boost_json_arena::storage());
+
+            if (ec)
+            {
+                throw deserialization_error("Boost.JSON: could not parse value");
+            }
+
+            return parse_arg<T>(val);
+        }
     };
 } // namespace adapters
 } // namespace rpc_hpp
@@ -0,0 +1,1140 @@
+///@file rpc_adapters/rpc_json_reader.hpp
+///@author Jackson Harmer (jharmer95@gmail.com)
+///@brief Reading of JSON text straight into packed functions, shared by the rapidjson and Boost.JSON adapters
+///
+///@copyright
+///BSD 3-Clause License
+///
+///Copyright (c) 2020-2022, Jackson Harmer
+///All rights reserved.
+///
+///Redistribution and use in source and binary forms, with or without
+///modification, are permitted provided that the following conditions are met:
+///
+///1. Redistributions of source code must retain the above copyright notice, this
+///   list of conditions and the following disclaimer.
+///
+///2. Redistributions in binary form must reproduce the above copyright notice,
+///   this list of conditions and the following disclaimer in the documentation
+///   and/or other materials provided with the distribution.
+///
+///3. Neither the name of the copyright holder nor the names of its
+///   contributors may be used to endorse or promote products derived from
+///   this software without specific prior written permission.
+///
+///THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+///AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+///IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+///DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+///FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+///DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+///SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+///CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+///OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+///OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+///
+
+#pragma once
+
+#include "../rpc.hpp"
+
+#include <array>
+#include <charconv>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <string_view>
+
+namespace rpc_hpp
+{
+namespace adapters
+{
+    ///@brief Reads JSON values directly from text, without building a document
+    ///
+    ///@note Throws @ref deserialization_error on malformed text and @ref function_mismatch on unexpected types
+    class json_reader
+    {
+    public:
+        enum class value_type
+        {
+            null,
+            boolean,
+            integer,
+            floating,
+            string,
+            array,
+            object,
+            invalid,
+        };
+
+        explicit json_reader(const std::string_view text) noexcept : m_text(text) {}
+
+        [[nodiscard]] bool at_end() noexcept
+        {
+            skip_whitespace();
+            return m_pos >= m_text.size();
+        }
+
+        [[nodiscard]] value_type peek_type()
+        {
+            switch (peek())
+            {
+                case 'n':
+                    return value_type::null;
+
+                case 't':
+                case 'f':
+                    return value_type::boolean;
+
+                case '"':
+                    return value_type::string;
+
+                case '[':
+                    return value_type::array;
+
+                case '{':
+                    return value_type::object;
+
+                case '-':
+                case '0':
+                case '1':
+                case '2':
+                case '3':
+                case '4':
+                case '5':
+                case '6':
+                case '7':
+                case '8':
+                case '9':
+                {
+                    const auto token = number_token();
+                    return token.find_first_of(".eE") == std::string_view::npos
+                        ? value_type::integer
+                        : value_type::floating;
+                }
+
+                default:
+                    return value_type::invalid;
+            }
+        }
+
+        void read_null()
+        {
+            expect(value_type::null, "null");
+            consume_literal("null");
+        }
+
+        [[nodiscard]] bool read_bool()
+        {
+            expect(value_type::boolean, "bool");
+
+            if (peek() == 't')
+            {
+                consume_literal("true");
+                return true;
+            }
+
+            consume_literal("false");
+            return false;
+        }
+
+        template<typename T>
+        [[nodiscard]] T read_int()
+        {
+            static_assert(std::is_integral_v<T>, "read_int requires an integral type");
+            expect(value_type::integer, "integer");
+
+            const auto token = number_token();
+            T val{};
+            const auto [end, ec] = std::from_chars(token.data(), token.data() + token.size(), val);
+
+            if (ec != std::errc{} || end != token.data() + token.size())
+            {
+                throw function_mismatch(
+                    "JSON integer out of range: " + std::string{ token });
+            }
+
+            m_pos += token.size();
+            return val;
+        }
+
+        [[nodiscard]] double read_float()
+        {
+            expect(value_type::floating, "float");
+
+            const auto token = number_token();
+            double val{};
+
+#if defined(__cpp_lib_to_chars)
+            const auto [end, ec] = std::from_chars(token.data(), token.data() + token.size(), val);
+
+            if (ec == std::errc::invalid_argument || end != token.data() + token.size())
+            {
+                throw deserialization_error("JSON: invalid number: " + std::string{ token });
+            }
+#else
+            const std::string copy{ token };
+            char* end = nullptr;
+            val = std::strtod(copy.c_str(), &end);
+
+            if (end != copy.c_str() + copy.size())
+            {
+                throw deserialization_error("JSON: invalid number: " + copy);
+            }
+#endif
+
+            m_pos += token.size();
+            return val;
+        }
+
+        ///@brief Reads a string, unescaping it into buffer if needed
+        ///
+        ///@return std::string_view The string, referring to either the text or buffer
+        [[nodiscard]] std::string_view read_string(std::string& buffer)
+        {
+            expect(value_type::string, "string");
+
+            const auto start = ++m_pos;
+            const auto end = m_text.find_first_of("\"\\", start);
+
+            if (end == std::string_view::npos)
+            {
+                throw deserialization_error("JSON: unterminated string");
+            }
+
+            if (m_text[end] == '"')
+            {
+                m_pos = end + 1;
+                return check_control(m_text.substr(start, end - start));
+            }
+
+            buffer.assign(check_control(m_text.substr(start, end - start)));
+            m_pos = end;
+
+            while (true)
+            {
+                const auto next = m_text.find_first_of("\"\\", m_pos);
+
+                if (next == std::string_view::npos)
+                {
+                    throw deserialization_error("JSON: unterminated string");
+                }
+
+                buffer.append(check_control(m_text.substr(m_pos, next - m_pos)));
+                m_pos = next + 1;
+
+                if (m_text[next] == '"')
+                {
+                    return buffer;
+                }
+
+                append_escape(buffer);
+            }
+        }
+
+        ///@brief Reads the key of an object member, along with the following ':'
+        [[nodiscard]] std::string_view read_key(std::string& buffer)
+        {
+            const auto key = read_string(buffer);
+            consume(':');
+            return key;
+        }
+
+        ///@brief Enters an array
+        ///
+        ///@return bool true if the array has any elements
+        [[nodiscard]] bool begin_array()
+        {
+            expect(value_type::array, "array");
+            ++m_pos;
+            return !try_consume(']');
+        }
+
+        ///@brief Moves past an array element
+        ///
+        ///@return bool true if another element follows, false at the end of the array
+        [[nodiscard]] bool next_element() { return next(']'); }
+
+        ///@brief Enters an object
+        ///
+        ///@return bool true if the object has any members
+        [[nodiscard]] bool begin_object()
+        {
+            expect(value_type::object, "object");
+            ++m_pos;
+            return !try_consume('}');
+        }
+
+        ///@brief Moves past an object member
+        ///
+        ///@return bool true if another member follows, false at the end of the object
+        [[nodiscard]] bool next_member() { return next('}'); }
+
+        ///@brief Skips over the next value (including any nested values)
+        ///
+        ///@note Separators and strings are checked as strictly as when reading, so skipped text is
+        ///never accepted when a document parser would reject it
+        void skip()
+        {
+            // Closing brackets of the containers entered so far, innermost last
+            std::string closers{};
+            std::string buffer{};
+
+            while (true)
+            {
+                switch (peek())
+                {
+                    case '"':
+                        std::ignore = read_string(buffer);
+                        break;
+
+                    case '[':
+                        ++m_pos;
+
+                        if (!try_consume(']'))
+                        {
+                            closers.push_back(']');
+                            continue;
+                        }
+
+                        break;
+
+                    case '{':
+                        ++m_pos;
+
+                        if (!try_consume('}'))
+                        {
+                            closers.push_back('}');
+                            skip_key(buffer);
+                            continue;
+                        }
+
+                        break;
+
+                    case 'n':
+                        read_null();
+                        break;
+
+                    case 't':
+                    case 'f':
+                        std::ignore = read_bool();
+                        break;
+
+                    default:
+                        if (peek_type() == value_type::invalid)
+                        {
+                            throw deserialization_error("JSON: expected a value");
+                        }
+
+                        m_pos += number_token().size();
+                        break;
+                }
+
+                // A value was completed, so it must be followed by a ',' or by closing brackets
+                while (true)
+                {
+                    if (closers.empty())
+                    {
+                        return;
+                    }
+
+                    if (try_consume(','))
+                    {
+                        if (closers.back() == '}')
+                        {
+                            skip_key(buffer);
+                        }
+
+                        break;
+                    }
+
+                    consume(closers.back());
+                    closers.pop_back();
+                }
+            }
+        }
+
+        ///@brief Skips over the next value, returning its text
+        [[nodiscard]] std::string_view read_raw()
+        {
+            skip_whitespace();
+            const auto start = m_pos;
+            skip();
+            return m_text.substr(start, m_pos - start);
+        }
+
+        [[nodiscard]] static const char* type_name(const value_type type) noexcept
+        {
+            switch (type)
+            {
+                case value_type::null:
+                    return "null";
+
+                case value_type::boolean:
+                    return "bool";
+
+                case value_type::integer:
+                    return "integer";
+
+                case value_type::floating:
+                    return "float";
+
+                case value_type::string:
+                    return "string";
+
+                case value_type::array:
+                    return "array";
+
+                case value_type::object:
+                    return "object";
+
+                case value_type::invalid:
+                default:
+                    return "invalid";
+            }
+        }
+
+    private:
+        void skip_whitespace() noexcept
+        {
+            while (m_pos < m_text.size()
+                && (m_text[m_pos] == ' ' || m_text[m_pos] == '\n' || m_text[m_pos] == '\r'
+                    || m_text[m_pos] == '\t'))
+            {
+                ++m_pos;
+            }
+        }
+
+        // Returns the next significant character
+        [[nodiscard]] char peek()
+        {
+            skip_whitespace();
+
+            if (m_pos >= m_text.size())
+            {
+                throw deserialization_error("JSON: unexpected end of data");
+            }
+
+            return m_text[m_pos];
+        }
+
+        [[nodiscard]] bool try_consume(const char c)
+        {
+            if (peek() != c)
+            {
+                return false;
+            }
+
+            ++m_pos;
+            return true;
+        }
+
+        void consume(const char c)
+        {
+            if (!try_consume(c))
+            {
+                throw deserialization_error(std::string{ "JSON: expected '" } + c + "'");
+            }
+        }
+
+        void skip_key(std::string& buffer)
+        {
+            if (peek() != '"')
+            {
+                throw deserialization_error("JSON: expected a key");
+            }
+
+            std::ignore = read_key(buffer);
+        }
+
+        [[nodiscard]] bool next(const char close)
+        {
+            if (try_consume(','))
+            {
+                return true;
+            }
+
+            consume(close);
+            return false;
+        }
+
+        void consume_literal(const std::string_view literal)
+        {
+            if (m_text.substr(m_pos, literal.size()) != literal)
+            {
+                throw deserialization_error("JSON: invalid literal");
+            }
+
+            m_pos += literal.size();
+        }
+
+        [[nodiscard]] std::string_view number_token() const noexcept
+        {
+            auto end = m_pos;
+
+            while (end < m_text.size()
+                && ((m_text[end] >= '0' && m_text[end] <= '9') || m_text[end] == '-'
+                    || m_text[end] == '+' || m_text[end] == '.' || m_text[end] == 'e'
+                    || m_text[end] == 'E'))
+            {
+                ++end;
+            }
+
+            return m_text.substr(m_pos, end - m_pos);
+        }
+
+        [[nodiscard]] static std::string_view check_control(const std::string_view str)
+        {
+            for (const auto c : str)
+            {
+                if (static_cast<unsigned char>(c) < 0x20U)
+                {
+                    throw deserialization_error("JSON: unescaped control character in string");
+                }
+            }
+
+            return str;
+        }
+
+        [[nodiscard]] uint32_t read_hex4()
+        {
+            if (m_pos + 4 > m_text.size())
+            {
+                throw deserialization_error("JSON: unexpected end of data");
+            }
+
+            uint32_t val = 0;
+            const auto [end, ec] =
+                std::from_chars(m_text.data() + m_pos, m_text.data() + m_pos + 4, val, 16);
+
+            if (ec != std::errc{} || end != m_text.data() + m_pos + 4)
+            {
+                throw deserialization_error("JSON: invalid unicode escape");
+            }
+
+            m_pos += 4;
+            return val;
+        }
+
+        // Appends the character for the escape sequence following a '\' to buffer
+        void append_escape(std::string& buffer)
+        {
+            if (m_pos >= m_text.size())
+            {
+                throw deserialization_error("JSON: unterminated string");
+            }
+
+            switch (m_text[m_pos++])
+            {
+                case '"':
+                    buffer.push_back('"');
+                    return;
+
+                case '\\':
+                    buffer.push_back('\\');
+                    return;
+
+                case '/':
+                    buffer.push_back('/');
+                    return;
+
+                case 'b':
+                    buffer.push_back('\b');
+                    return;
+
+                case 'f':
+                    buffer.push_back('\f');
+                    return;
+
+                case 'n':
+                    buffer.push_back('\n');
+                    return;
+
+                case 'r':
+                    buffer.push_back('\r');
+                    return;
+
+                case 't':
+                    buffer.push_back('\t');
+                    return;
+
+                case 'u':
+                    break;
+
+                default:
+                    throw deserialization_error("JSON: invalid escape sequence");
+            }
+
+            auto code = read_hex4();
+
+            if (code >= 0xD800U && code <= 0xDBFFU)
+            {
+                // High surrogate, must be followed by an escaped low surrogate
+                if (m_text.substr(m_pos, 2) != "\\u")
+                {
+                    throw deserialization_error("JSON: invalid unicode escape");
+                }
+
+                m_pos += 2;
+                const auto low = read_hex4();
+
+                if (low < 0xDC00U || low > 0xDFFFU)
+                {
+                    throw deserialization_error("JSON: invalid unicode escape");
+                }
+
+                code = 0x10000U + ((code - 0xD800U) << 10U) + (low - 0xDC00U);
+            }
+            else if (code >= 0xDC00U && code <= 0xDFFFU)
+            {
+                // Low surrogate without a preceding high surrogate
+                throw deserialization_error("JSON: invalid unicode escape");
+            }
+
+            // Encode as UTF-8
+            if (code < 0x80U)
+            {
+                buffer.push_back(static_cast<char>(code));
+            }
+            else if (code < 0x800U)
+            {
+                buffer.push_back(static_cast<char>(0xC0U | (code >> 6U)));
+                buffer.push_back(static_cast<char>(0x80U | (code & 0x3FU)));
+            }
+            else if (code < 0x10000U)
+            {
+                buffer.push_back(static_cast<char>(0xE0U | (code >> 12U)));
+                buffer.push_back(static_cast<char>(0x80U | ((code >> 6U) & 0x3FU)));
+                buffer.push_back(static_cast<char>(0x80U | (code & 0x3FU)));
+            }
+            else
+            {
+                buffer.push_back(static_cast<char>(0xF0U | (code >> 18U)));
+                buffer.push_back(static_cast<char>(0x80U | ((code >> 12U) & 0x3FU)));
+                buffer.push_back(static_cast<char>(0x80U | ((code >> 6U) & 0x3FU)));
+                buffer.push_back(static_cast<char>(0x80U | (code & 0x3FU)));
+            }
+        }
+
+        void expect(const value_type type, const char* expect_name)
+        {
+            if (const auto actual = peek_type(); actual != type)
+            {
+                if (actual == value_type::invalid)
+                {
+                    throw deserialization_error("JSON: invalid value");
+                }
+
+                throw function_mismatch(std::string{ "JSON expected type: " } + expect_name
+                    + ", got type: " + type_name(actual));
+            }
+        }
+
+        std::string_view m_text;
+        size_t m_pos{ 0 };
+    };
+} // namespace adapters
+
+namespace detail
+{
+    // Reads messages written by the JSON text adapters (rapidjson and Boost.JSON) straight into a
+    // packed_func. Values without a native encoding are parsed by Adapter::parse_text from the
+    // text of the value
+    template<typename Adapter>
+    class json_text_parser
+    {
+    public:
+        [[nodiscard]] static std::optional<std::string> peek_func_name(
+            const std::string_view bytes)
+        {
+            try
+            {
+                adapters::json_reader reader{ bytes };
+                std::string buffer{};
+
+                if (reader.peek_type() == adapters::json_reader::value_type::array)
+                {
+                    if (!reader.begin_array() || reader.read_int<int>() != compact_envelope::version
+                        || !reader.next_element())
+                    {
+                        return std::nullopt;
+                    }
+
+                    reader.skip();
+
+                    if (!reader.next_element()
+                        || reader.peek_type() != adapters::json_reader::value_type::string)
+                    {
+                        return std::nullopt;
+                    }
+
+                    if (const auto func_name = reader.read_string(buffer); !func_name.empty())
+                    {
+                        return std::string{ func_name };
+                    }
+
+                    return std::nullopt;
+                }
+
+                if (!reader.begin_object())
+                {
+                    return std::nullopt;
+                }
+
+                do
+                {
+                    if (reader.read_key(buffer) != "func_name")
+                    {
+                        reader.skip();
+                        continue;
+                    }
+
+                    if (reader.peek_type() != adapters::json_reader::value_type::string)
+                    {
+                        return std::nullopt;
+                    }
+
+                    if (const auto func_name = reader.read_string(buffer); !func_name.empty())
+                    {
+                        return std::string{ func_name };
+                    }
+
+                    return std::nullopt;
+                } while (reader.next_member());
+            }
+            catch (const rpc_exception&)
+            {
+            }
+
+            return std::nullopt;
+        }
+
+        template<typename R, typename... Args>
+        [[nodiscard]] static packed_func<R, Args...> parse_pack(const std::string_view bytes)
+        {
+            using args_t = typename packed_func<R, Args...>::args_t;
+
+            adapters::json_reader reader{ bytes };
+            std::string buffer{};
+            streamed_pack<R, Args...> fields{};
+
+            if (reader.peek_type() == adapters::json_reader::value_type::array)
+            {
+                read_compact(reader, fields);
+            }
+            else if (reader.begin_object())
+            {
+                do
+                {
+                    const auto key = reader.read_key(buffer);
+
+                    if (key == "args")
+                    {
+                        bool more = reader.begin_array();
+                        fields.args = args_t{ read_args<Args>(reader, more)... };
+
+                        while (more)
+                        {
+                            reader.skip();
+                            more = reader.next_element();
+                        }
+                    }
+                    else if (key == "result")
+                    {
+                        read_result(reader, fields);
+                    }
+                    else if (key == "func_name")
+                    {
+                        fields.func_name = reader.read_string(buffer);
+                    }
+                    else if (key == "except_type")
+                    {
+                        fields.except_type = static_cast<exception_type>(reader.read_int<int>());
+                    }
+                    else if (key == "err_mesg")
+                    {
+                        fields.err_mesg = reader.read_string(buffer);
+                    }
+                    else
+                    {
+                        reader.skip();
+                    }
+                } while (reader.next_member());
+            }
+
+            if (!reader.at_end())
+            {
+                throw deserialization_error("JSON: unexpected data after the message");
+            }
+
+            return std::move(fields).finish();
+        }
+
+    private:
+        // A null result is only a value for std::optional
+        template<typename R, typename... Args>
+        static void read_result(adapters::json_reader& reader, streamed_pack<R, Args...>& fields)
+        {
+            if constexpr (std::is_void_v<R>)
+            {
+                reader.skip();
+            }
+            else if (!is_optional_v<R>
+                && reader.peek_type() == adapters::json_reader::value_type::null)
+            {
+                reader.read_null();
+            }
+            else
+            {
+                fields.result = read_arg<R>(reader);
+            }
+        }
+
+        // Reads a message written as a compact envelope (see compact_envelope)
+        template<typename R, typename... Args>
+        static void read_compact(adapters::json_reader& reader, streamed_pack<R, Args...>& fields)
+        {
+            using args_t = typename packed_func<R, Args...>::args_t;
+
+            std::string buffer{};
+
+            if (!reader.begin_array() || reader.read_int<int>() != compact_envelope::version)
+            {
+                throw deserialization_error("JSON: invalid compact envelope");
+            }
+
+            next_compact_field(reader);
+            const bool has_error = compact_envelope::has_error(reader.read_int<unsigned>());
+            next_compact_field(reader);
+            fields.func_name = reader.read_string(buffer);
+            next_compact_field(reader);
+
+            if (has_error)
+            {
+                if (!reader.begin_array())
+                {
+                    throw deserialization_error("JSON: invalid compact envelope");
+                }
+
+                fields.except_type = static_cast<exception_type>(reader.read_int<int>());
+                next_compact_field(reader);
+                fields.err_mesg = reader.read_string(buffer);
+
+                if (reader.next_element())
+                {
+                    throw deserialization_error("JSON: invalid compact envelope");
+                }
+            }
+            else
+            {
+                read_result(reader, fields);
+            }
+
+            bool more = reader.next_element();
+
+            // Replies that only report an error can omit the arguments
+            if (has_error && !more)
+            {
+                return;
+            }
+
+            fields.args = args_t{ read_args<Args>(reader, more)... };
+
+            while (more)
+            {
+                reader.skip();
+                more = reader.next_element();
+            }
+        }
+
+        static void next_compact_field(adapters::json_reader& reader)
+        {
+            if (!reader.next_element())
+            {
+                throw deserialization_error("JSON: invalid compact envelope");
+            }
+        }
+
+        // nodiscard because parsing can be expensive, and it makes no sense to not use the parsed result
+        template<typename T>
+        [[nodiscard]] static std::remove_cv_t<std::remove_reference_t<T>> read_arg(
+            adapters::json_reader& reader)
+        {
+            using no_ref_t = std::remove_cv_t<std::remove_reference_t<T>>;
+            using value_type = adapters::json_reader::value_type;
+
+            if constexpr (is_bulk_container_v<no_ref_t>)
+            {
+                if (reader.peek_type() == value_type::string)
+                {
+                    return read_bulk<no_ref_t>(reader);
+                }
+            }
+
+            if constexpr (std::is_same_v<no_ref_t, bool>)
+            {
+                return reader.read_bool();
+            }
+            else if constexpr (std::is_integral_v<no_ref_t>)
+            {
+                return reader.read_int<no_ref_t>();
+            }
+            else if constexpr (std::is_floating_point_v<no_ref_t>)
+            {
+                return static_cast<no_ref_t>(reader.read_float());
+            }
+            else if constexpr (std::is_same_v<no_ref_t, std::string>)
+            {
+                std::string buffer{};
+                const auto str = reader.read_string(buffer);
+                return str.data() == buffer.data() ? std::move(buffer) : std::string{ str };
+            }
+            else if constexpr (is_optional_v<no_ref_t>)
+            {
+                if (reader.peek_type() == value_type::null)
+                {
+                    reader.read_null();
+                    return std::nullopt;
+                }
+
+                return read_arg<typename no_ref_t::value_type>(reader);
+            }
+            else if constexpr (is_variant_v<no_ref_t>)
+            {
+                if (!reader.begin_array())
+                {
+                    throw function_mismatch("JSON expected type: [index, value]");
+                }
+
+                const auto index = reader.read_int<int64_t>();
+
+                if (index < 0)
+                {
+                    throw function_mismatch("Variant index out of range");
+                }
+
+                if (!reader.next_element())
+                {
+                    throw function_mismatch("JSON expected type: [index, value]");
+                }
+
+                auto val = make_variant<no_ref_t>(static_cast<size_t>(index),
+                    [&reader](auto tag) { return read_arg<typename decltype(tag)::type>(reader); });
+
+                if (reader.next_element())
+                {
+                    throw function_mismatch("JSON expected type: [index, value]");
+                }
+
+                return val;
+            }
+            else if constexpr (is_string_map_v<no_ref_t>)
+            {
+                no_ref_t container{};
+
+                if (reader.begin_object())
+                {
+                    std::string buffer{};
+
+                    do
+                    {
+                        auto key = std::string{ reader.read_key(buffer) };
+                        emplace_assoc(container, std::move(key),
+                            read_arg<typename no_ref_t::mapped_type>(reader));
+                    } while (reader.next_member());
+                }
+
+                return container;
+            }
+            else if constexpr (is_map_v<no_ref_t>)
+            {
+                no_ref_t container{};
+
+                for (bool more = reader.begin_array(); more; more = reader.next_element())
+                {
+                    if (reader.peek_type() != value_type::array || !reader.begin_array())
+                    {
+                        throw function_mismatch("JSON expected type: [key, value]");
+                    }
+
+                    auto key = read_arg<typename no_ref_t::key_type>(reader);
+
+                    if (!reader.next_element())
+                    {
+                        throw function_mismatch("JSON expected type: [key, value]");
+                    }
+
+                    emplace_assoc(container, std::move(key),
+                        read_arg<typename no_ref_t::mapped_type>(reader));
+
+                    if (reader.next_element())
+                    {
+                        throw function_mismatch("JSON expected type: [key, value]");
+                    }
+                }
+
+                return container;
+            }
+            else if constexpr (is_set_v<no_ref_t>)
+            {
+                no_ref_t container{};
+
+                for (bool more = reader.begin_array(); more; more = reader.next_element())
+                {
+                    emplace_assoc(container, read_arg<typename no_ref_t::value_type>(reader));
+                }
+
+                return container;
+            }
+            else if constexpr (is_byte_container_v<no_ref_t>)
+            {
+                return read_bulk<no_ref_t>(reader);
+            }
+            else if constexpr (is_fixed_extent_v<no_ref_t>)
+            {
+                no_ref_t container{};
+                size_t size = 0;
+
+                for (bool more = reader.begin_array(); more; more = reader.next_element())
+                {
+                    if (size == container.size())
+                    {
+                        check_extent<no_ref_t>(size + 1);
+                    }
+
+                    container[size++] = read_arg<typename no_ref_t::value_type>(reader);
+                }
+
+                check_extent<no_ref_t>(size);
+                return container;
+            }
+            else if constexpr (is_container_v<no_ref_t>)
+            {
+                no_ref_t container{};
+
+                for (bool more = reader.begin_array(); more; more = reader.next_element())
+                {
+                    container.push_back(read_arg<typename no_ref_t::value_type>(reader));
+                }
+
+                return container;
+            }
+            else if constexpr (is_tuple_v<no_ref_t>)
+            {
+                no_ref_t container{};
+                bool more = reader.begin_array();
+
+                for_each_tuple(container,
+                    [&reader, &more](auto& val) { val = read_args<decltype(val)>(reader, more); });
+
+                while (more)
+                {
+                    reader.skip();
+                    more = reader.next_element();
+                }
+
+                return container;
+            }
+            else if constexpr (is_serializable_v<Adapter, no_ref_t>)
+            {
+                return Adapter::template parse_text<no_ref_t>(reader.read_raw());
+            }
+            else if constexpr (is_reflected_v<no_ref_t>)
+            {
+                no_ref_t val{};
+                std::array<bool, field_count_v<no_ref_t>> found{};
+
+                if (reader.begin_object())
+                {
+                    std::string buffer{};
+
+                    // Fields may arrive in any order, unknown ones are skipped
+                    do
+                    {
+                        const auto key = reader.read_key(buffer);
+                        size_t index = 0;
+                        bool matched = false;
+
+                        for_each_field(val,
+                            [&reader, key, &found, &index, &matched](
+                                const std::string_view name, auto& field)
+                            {
+                                if (!matched && name == key)
+                                {
+                                    field =
+                                        read_arg<std::remove_reference_t<decltype(field)>>(reader);
+
+                                    found[index] = true;
+                                    matched = true;
+                                }
+
+                                ++index;
+                            });
+
+                        if (!matched)
+                        {
+                            reader.skip();
+                        }
+                    } while (reader.next_member());
+                }
+
+                for (size_t i = 0; i < found.size(); ++i)
+                {
+                    if (!found[i])
+                    {
+                        throw function_mismatch(
+                            "JSON missing field: " + std::string{ field_names_v<no_ref_t>[i] });
+                    }
+                }
+
+                return val;
+            }
+            else
+            {
+                // User-defined serialization works on the adapter's document type
+                return Adapter::template parse_text<no_ref_t>(reader.read_raw());
+            }
+        }
+
+        // nodiscard because parsing can be expensive, and it makes no sense to not use the parsed result
+        template<typename C>
+        [[nodiscard]] static C read_bulk(adapters::json_reader& reader)
+        {
+            std::string buffer{};
+            const auto text = reader.read_string(buffer);
+            const auto byte_size = base64_decoded_size(text);
+
+            if (!byte_size.has_value())
+            {
+                throw function_mismatch(
+                    std::string{ "JSON expected base64 data of type: " } + typeid(C).name());
+            }
+
+            C container{};
+
+            if (!base64_decode(text, resize_bulk(container, *byte_size)))
+            {
+                throw function_mismatch(
+                    std::string{ "JSON expected base64 data of type: " } + typeid(C).name());
+            }
+
+            return container;
+        }
+
+        // nodiscard because parsing can be expensive, and it makes no sense to not use the parsed result
+        template<typename T>
+        [[nodiscard]] static std::remove_cv_t<std::remove_reference_t<T>> read_args(
+            adapters::json_reader& reader, bool& more)
+        {
+            if (!more)
+            {
+                throw function_mismatch("Argument count mismatch");
+            }
+
+            auto val = read_arg<T>(reader);
+            more = reader.next_element();
+            return val;
+        }
+    };
+} // namespace detail
+} // namespace rpc_hpp
@@ -0,0 +1,1331 @@
+///@file rpc_adapters/rpc_msgpack.hpp
+///@author Jackson Harmer (jharmer95@gmail.com)
+///@brief Implementation of a native MessagePack (https://msgpack.org) adapter, wire-compatible with the njson adapter
+///
+///@copyright
+///BSD 3-Clause License
+///
+///Copyright (c) 2020-2022, Jackson Harmer
+///All rights reserved.
+///
+///Redistribution and use in source and binary forms, with or without
+///modification, are permitted provided that the following conditions are met:
+///
+///1. Redistributions of source code must retain the above copyright notice, this
+///   list of conditions and the following disclaimer.
+///
+///2. Redistributions in binary form must reproduce the above copyright notice,
+///   this list of conditions and the following disclaimer in the documentation
+///   and/or other materials provided with the distribution.
+///
+///3. Neither the name of the copyright holder nor the names of its
+///   contributors may be used to endorse or promote products derived from
+///   this software without specific prior written permission.
+///
+///THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+///AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+///IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+///DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+///FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+///DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+///SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+///CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+///OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+///OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+///
+
+
+#pragma once
+
+#include "../rpc.hpp"
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <optional>
+#include <string_view>
+#include <variant>
+
+namespace rpc_hpp
+{
+namespace detail
+{
+    // MessagePack stores multi-byte values in big-endian order (the swap is its own inverse)
+    template<size_t N>
+    constexpr void to_big_endian([[maybe_unused]] std::array<char, N>& bytes) noexcept
+    {
+#if !defined(__BYTE_ORDER__) || __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+        for (size_t i = 0; i < N / 2; ++i)
+        {
+            std::swap(bytes[i], bytes[N - 1 - i]);
+        }
+#endif
+    }
+} // namespace detail
+
+namespace adapters
+{
+    ///@brief Writes MessagePack values directly into a byte buffer
+    class msgpack_writer
+    {
+    public:
+        explicit msgpack_writer(std::string& buffer) noexcept : m_buffer(buffer) {}
+
+        void write_nil() { put(0xC0U); }
+        void write_bool(const bool val) { put(val ? 0xC3U : 0xC2U); }
+
+        template<typename T>
+        void write_int(const T val)
+        {
+            static_assert(std::is_integral_v<T>, "write_int requires an integral type");
+
+            if constexpr (std::is_signed_v<T>)
+            {
+                if (val < 0)
+                {
+                    write_negative(static_cast<int64_t>(val));
+                    return;
+                }
+            }
+
+            write_unsigned(static_cast<uint64_t>(val));
+        }
+
+        // Matches nlohmann/json: values exactly representable as float are written as float32
+        void write_float(const double val)
+        {
+            if (static_cast<double>(std::numeric_limits<float>::lowest()) <= val
+                && val <= static_cast<double>(std::numeric_limits<float>::max())
+                && static_cast<double>(static_cast<float>(val)) == val)
+            {
+                put(0xCAU);
+                put_be(static_cast<float>(val));
+            }
+            else
+            {
+                put(0xCBU);
+                put_be(val);
+            }
+        }
+
+        void write_string(const std::string_view str)
+        {
+            const auto size = str.size();
+
+            if (size < 32)
+            {
+                put(static_cast<uint8_t>(0xA0U | size));
+            }
+            else if (size <= std::numeric_limits<uint8_t>::max())
+            {
+                put(0xD9U);
+                put(static_cast<uint8_t>(size));
+            }
+            else if (size <= std::numeric_limits<uint16_t>::max())
+            {
+                put(0xDAU);
+                put_be(static_cast<uint16_t>(size));
+            }
+            else
+            {
+                put(0xDBU);
+                put_be(static_cast<uint32_t>(size));
+            }
+
+            m_buffer.append(str.data(), size);
+        }
+
+        void write_array_header(const size_t size) { write_header(size, 0x90U, 0xDCU); }
+        void write_map_header(const size_t size) { write_header(size, 0x80U, 0xDEU); }
+
+        ///@brief Appends already encoded MessagePack data
+        void write_raw(const std::string_view bytes) { m_buffer.append(bytes.data(), bytes.size()); }
+
+        [[nodiscard]] size_t position() const noexcept { return m_buffer.size(); }
+
+    private:
+        void put(const unsigned val) { m_buffer.push_back(static_cast<char>(val)); }
+
+        template<typename T>
+        void put_be(const T val)
+        {
+            std::array<char, sizeof(T)> bytes{};
+            memcpy(bytes.data(), &val, sizeof(T));
+            detail::to_big_endian(bytes);
+            m_buffer.append(bytes.data(), bytes.size());
+        }
+
+        void write_unsigned(const uint64_t val)
+        {
+            if (val < 0x80U)
+            {
+                put(static_cast<uint8_t>(val));
+            }
+            else if (val <= std::numeric_limits<uint8_t>::max())
+            {
+                put(0xCCU);
+                put(static_cast<uint8_t>(val));
+            }
+            else if (val <= std::numeric_limits<uint16_t>::max())
+            {
+                put(0xCDU);
+                put_be(static_cast<uint16_t>(val));
+            }
+            else if (val <= std::numeric_limits<uint32_t>::max())
+            {
+                put(0xCEU);
+                put_be(static_cast<uint32_t>(val));
+            }
+            else
+            {
+                put(0xCFU);
+                put_be(val);
+            }
+        }
+
+        void write_negative(const int64_t val)
+        {
+            if (val >= -32)
+            {
+                put(static_cast<uint8_t>(static_cast<int8_t>(val)));
+            }
+            else if (val >= std::numeric_limits<int8_t>::min())
+            {
+                put(0xD0U);
+                put_be(static_cast<int8_t>(val));
+            }
+            else if (val >= std::numeric_limits<int16_t>::min())
+            {
+                put(0xD1U);
+                put_be(static_cast<int16_t>(val));
+            }
+            else if (val >= std::numeric_limits<int32_t>::min())
+            {
+                put(0xD2U);
+                put_be(static_cast<int32_t>(val));
+            }
+            else
+            {
+                put(0xD3U);
+                put_be(val);
+            }
+        }
+
+        void write_header(const size_t size, const unsigned fix_tag, const unsigned tag16)
+        {
+            if (size < 16)
+            {
+                put(static_cast<uint8_t>(fix_tag | size));
+            }
+            else if (size <= std::numeric_limits<uint16_t>::max())
+            {
+                put(tag16);
+                put_be(static_cast<uint16_t>(size));
+            }
+            else
+            {
+                put(tag16 + 1);
+                put_be(static_cast<uint32_t>(size));
+            }
+        }
+
+        std::string& m_buffer;
+    };
+
+    ///@brief Reads MessagePack values directly from a byte buffer
+    ///
+    ///@note Throws @ref deserialization_error on truncated data and @ref function_mismatch on unexpected types
+    class msgpack_reader
+    {
+    public:
+        enum class value_type
+        {
+            nil,
+            boolean,
+            integer,
+            floating,
+            string,
+            binary,
+            array,
+            map,
+            ext,
+            invalid,
+        };
+
+        explicit msgpack_reader(const std::string_view bytes) noexcept : m_bytes(bytes) {}
+
+        [[nodiscard]] size_t position() const noexcept { return m_pos; }
+        [[nodiscard]] bool at_end() const noexcept { return m_pos >= m_bytes.size(); }
+
+        [[nodiscard]] value_type peek_type() const
+        {
+            return type_of(static_cast<uint8_t>(m_bytes.at(require_pos(1))));
+        }
+
+        [[nodiscard]] bool read_bool()
+        {
+            expect(value_type::boolean, "bool");
+            return get() == 0xC3U;
+        }
+
+        template<typename T>
+        [[nodiscard]] T read_int()
+        {
+            static_assert(std::is_integral_v<T>, "read_int requires an integral type");
+            expect(value_type::integer, "integer");
+
+            const auto tag = get();
+
+            if (tag < 0x80U)
+            {
+                return static_cast<T>(tag);
+            }
+
+            if (tag >= 0xE0U)
+            {
+                return static_cast<T>(static_cast<int8_t>(tag));
+            }
+
+            switch (tag)
+            {
+                case 0xCCU:
+                    return static_cast<T>(get_be<uint8_t>());
+
+                case 0xCDU:
+                    return static_cast<T>(get_be<uint16_t>());
+
+                case 0xCEU:
+                    return static_cast<T>(get_be<uint32_t>());
+
+                case 0xCFU:
+                    return static_cast<T>(get_be<uint64_t>());
+
+                case 0xD0U:
+                    return static_cast<T>(get_be<int8_t>());
+
+                case 0xD1U:
+                    return static_cast<T>(get_be<int16_t>());
+
+                case 0xD2U:
+                    return static_cast<T>(get_be<int32_t>());
+
+                case 0xD3U:
+                default:
+                    return static_cast<T>(get_be<int64_t>());
+            }
+        }
+
+        [[nodiscard]] double read_float()
+        {
+            expect(value_type::floating, "float");
+
+            if (get() == 0xCAU)
+            {
+                return static_cast<double>(get_be<float>());
+            }
+
+            return get_be<double>();
+        }
+
+        [[nodiscard]] std::string_view read_string()
+        {
+            expect(value_type::string, "string");
+
+            const auto tag = get();
+            size_t size = 0;
+
+            if (tag <= 0xBFU)
+            {
+                size = tag & 0x1FU;
+            }
+            else if (tag == 0xD9U)
+            {
+                size = get_be<uint8_t>();
+            }
+            else if (tag == 0xDAU)
+            {
+                size = get_be<uint16_t>();
+            }
+            else
+            {
+                size = get_be<uint32_t>();
+            }
+
+            const auto start = require_pos(size);
+            m_pos += size;
+            return m_bytes.substr(start, size);
+        }
+
+        [[nodiscard]] size_t read_array_header()
+        {
+            expect(value_type::array, "array");
+            return read_header(0x90U, 0xDCU);
+        }
+
+        [[nodiscard]] size_t read_map_header()
+        {
+            expect(value_type::map, "map");
+            return read_header(0x80U, 0xDEU);
+        }
+
+        ///@brief Contents of a binary or ext value, along with its ext type (if any)
+        struct binary_data
+        {
+            std::string_view bytes{};
+            std::optional<uint8_t> subtype{};
+        };
+
+        [[nodiscard]] binary_data read_binary()
+        {
+            if (const auto type = peek_type(); type != value_type::ext)
+            {
+                expect(value_type::binary, "binary");
+            }
+
+            const auto tag = get();
+
+            if (tag <= 0xC6U)
+            {
+                const size_t size = tag == 0xC4U ? get_be<uint8_t>()
+                    : tag == 0xC5U               ? get_be<uint16_t>()
+                                                 : get_be<uint32_t>();
+
+                return { read_raw(size), std::nullopt };
+            }
+
+            // fixext: 1, 2, 4, 8, or 16 bytes of data after the type byte
+            const size_t size = tag >= 0xD4U ? size_t{ 1 } << (tag - 0xD4U)
+                : tag == 0xC7U               ? get_be<uint8_t>()
+                : tag == 0xC8U               ? get_be<uint16_t>()
+                                             : get_be<uint32_t>();
+
+            const auto subtype = get();
+            return { read_raw(size), subtype };
+        }
+
+        ///@brief Returns the next 'size' bytes without interpreting them
+        [[nodiscard]] std::string_view read_raw(const size_t size)
+        {
+            const auto start = require_pos(size);
+            m_pos += size;
+            return m_bytes.substr(start, size);
+        }
+
+        ///@brief Skips over the next value (including any nested values)
+        void skip()
+        {
+            size_t remaining = 1;
+
+            while (remaining != 0)
+            {
+                --remaining;
+
+                switch (peek_type())
+                {
+                    case value_type::nil:
+                    case value_type::boolean:
+                        ++m_pos;
+                        break;
+
+                    case value_type::integer:
+                        std::ignore = read_int<uint64_t>();
+                        break;
+
+                    case value_type::floating:
+                        std::ignore = read_float();
+                        break;
+
+                    case value_type::string:
+                        std::ignore = read_string();
+                        break;
+
+                    case value_type::binary:
+                    {
+                        const auto tag = get();
+                        const size_t size = tag == 0xC4U ? get_be<uint8_t>()
+                            : tag == 0xC5U               ? get_be<uint16_t>()
+                                                         : get_be<uint32_t>();
+
+                        advance(size);
+                        break;
+                    }
+
+                    case value_type::ext:
+                    {
+                        const auto tag = get();
+
+                        if (tag >= 0xD4U)
+                        {
+                            // fixext: 1, 2, 4, 8, or 16 bytes of data after the type byte
+                            advance(1 + (size_t{ 1 } << (tag - 0xD4U)));
+                        }
+                        else
+                        {
+                            const size_t size = tag == 0xC7U ? get_be<uint8_t>()
+                                : tag == 0xC8U               ? get_be<uint16_t>()
+                                                             : get_be<uint32_t>();
+
+                            advance(1 + size);
+                        }
+
+                        break;
+                    }
+
+                    case value_type::array:
+                        remaining += read_array_header();
+                        break;
+
+                    case value_type::map:
+                        remaining += 2 * read_map_header();
+                        break;
+
+                    case value_type::invalid:
+                    default:
+                        throw deserialization_error("msgpack: invalid type tag");
+                }
+            }
+        }
+
+        [[nodiscard]] static const char* type_name(const value_type type) noexcept
+        {
+            switch (type)
+            {
+                case value_type::nil:
+                    return "nil";
+
+                case value_type::boolean:
+                    return "bool";
+
+                case value_type::integer:
+                    return "integer";
+
+                case value_type::floating:
+                    return "float";
+
+                case value_type::string:
+                    return "string";
+
+                case value_type::binary:
+                    return "binary";
+
+                case value_type::array:
+                    return "array";
+
+                case value_type::map:
+                    return "map";
+
+                case value_type::ext:
+                    return "ext";
+
+                case value_type::invalid:
+                default:
+                    return "invalid";
+            }
+        }
+
+    private:
+        [[nodiscard]] static constexpr value_type type_of(const uint8_t tag) noexcept
+        {
+            if (tag <= 0x7FU || tag >= 0xE0U || (tag >= 0xCCU && tag <= 0xD3U))
+            {
+                return value_type::integer;
+            }
+
+            if (tag <= 0x8FU || tag == 0xDEU || tag == 0xDFU)
+            {
+                return value_type::map;
+            }
+
+            if (tag <= 0x9FU || tag == 0xDCU || tag == 0xDDU)
+            {
+                return value_type::array;
+            }
+
+            if (tag <= 0xBFU || (tag >= 0xD9U && tag <= 0xDBU))
+            {
+                return value_type::string;
+            }
+
+            switch (tag)
+            {
+                case 0xC0U:
+                    return value_type::nil;
+
+                case 0xC2U:
+                case 0xC3U:
+                    return value_type::boolean;
+
+                case 0xC4U:
+                case 0xC5U:
+                case 0xC6U:
+                    return value_type::binary;
+
+                case 0xC7U:
+                case 0xC8U:
+                case 0xC9U:
+                case 0xD4U:
+                case 0xD5U:
+                case 0xD6U:
+                case 0xD7U:
+                case 0xD8U:
+                    return value_type::ext;
+
+                case 0xCAU:
+                case 0xCBU:
+                    return value_type::floating;
+
+                default:
+                    return value_type::invalid;
+            }
+        }
+
+        // Returns the current position if 'size' more bytes are available
+        [[nodiscard]] size_t require_pos(const size_t size) const
+        {
+            if (size > m_bytes.size() || m_pos > m_bytes.size() - size)
+            {
+                throw deserialization_error("msgpack: unexpected end of data");
+            }
+
+            return m_pos;
+        }
+
+        void advance(const size_t size) { m_pos = require_pos(size) + size; }
+
+        [[nodiscard]] uint8_t get()
+        {
+            const auto start = require_pos(1);
+            ++m_pos;
+            return static_cast<uint8_t>(m_bytes[start]);
+        }
+
+        template<typename T>
+        [[nodiscard]] T get_be()
+        {
+            const auto start = require_pos(sizeof(T));
+            std::array<char, sizeof(T)> bytes{};
+            memcpy(bytes.data(), &m_bytes[start], sizeof(T));
+            detail::to_big_endian(bytes);
+            m_pos += sizeof(T);
+            T val{};
+            memcpy(&val, bytes.data(), sizeof(T));
+            return val;
+        }
+
+        // Every element takes at least one byte, so a size larger than the rest of the data is
+        // rejected here, before any caller reserves room for that many elements
+        [[nodiscard]] size_t read_header(const unsigned fix_tag, const unsigned tag16)
+        {
+            const auto tag = get();
+            size_t size = 0;
+
+            if ((tag & 0xF0U) == fix_tag)
+            {
+                size = tag & 0x0FU;
+            }
+            else if (tag == tag16)
+            {
+                size = get_be<uint16_t>();
+            }
+            else
+            {
+                size = get_be<uint32_t>();
+            }
+
+            if (size > m_bytes.size() - m_pos)
+            {
+                throw deserialization_error("msgpack: container size exceeds the data left");
+            }
+
+            return size;
+        }
+
+        void expect(const value_type type, const char* expect_name) const
+        {
+            if (const auto actual = peek_type(); actual != type)
+            {
+                throw function_mismatch(std::string{ "msgpack expected type: " } + expect_name
+                    + ", got type: " + type_name(actual));
+            }
+        }
+
+        std::string_view m_bytes;
+        size_t m_pos{ 0 };
+    };
+
+    ///@brief Serialized MessagePack message, with the location of each top-level field
+    struct msgpack_message
+    {
+        ///@brief Top-level fields, in the (sorted) order nlohmann/json writes them
+        enum field : size_t
+        {
+            args,
+            err_mesg,
+            except_type,
+            func_name,
+            result,
+            field_count,
+        };
+
+        struct span
+        {
+            size_t offset{};
+            size_t size{};
+        };
+
+        [[nodiscard]] bool has(const field fld) const noexcept { return fields[fld].size != 0; }
+
+        [[nodiscard]] msgpack_reader reader(const field fld) const noexcept
+        {
+            return msgpack_reader{ std::string_view{ bytes }.substr(
+                fields[fld].offset, fields[fld].size) };
+        }
+
+        std::string bytes{};
+        std::array<span, field_count> fields{};
+    };
+
+    class msgpack_adapter;
+
+    template<>
+    struct serial_traits<msgpack_adapter>
+    {
+        using serial_t = msgpack_message;
+        using bytes_t = std::string;
+    };
+
+    class msgpack_adapter : public detail::serial_adapter_base<msgpack_adapter>
+    {
+    public:
+        [[nodiscard]] static std::string to_bytes(msgpack_message&& serial_obj)
+        {
+            return std::move(serial_obj.bytes);
+        }
+
+        ///@brief Hands the message's buffer over to out, giving out's previous buffer to the thread's buffer_pool
+        static void to_bytes(msgpack_message&& serial_obj, std::string& out)
+        {
+            out.swap(serial_obj.bytes);
+            recycle(std::move(serial_obj));
+        }
+
+        ///@brief Gives the message's buffer back to the thread's buffer_pool
+        static void recycle(msgpack_message&& serial_obj) noexcept
+        {
+            buffer_pool<std::string>::local().release(std::move(serial_obj.bytes));
+        }
+
+        ///@brief Whether a message in this format can start with byte (lets multi_server recognize the format)
+        [[nodiscard]] static constexpr bool may_start_with(const uint8_t byte) noexcept
+        {
+            // map
+            return (byte >= 0x80U && byte <= 0x8FU) || byte == 0xDEU || byte == 0xDFU;
+        }
+
+        [[nodiscard]] static std::optional<msgpack_message> from_bytes(std::string&& bytes)
+        {
+            msgpack_message msg{ std::move(bytes), {} };
+
+            try
+            {
+                msgpack_reader reader{ msg.bytes };
+
+                if (reader.peek_type() != msgpack_reader::value_type::map)
+                {
+                    return std::nullopt;
+                }
+
+                const auto num_fields = reader.read_map_header();
+
+                for (size_t i = 0; i < num_fields; ++i)
+                {
+                    if (reader.peek_type() != msgpack_reader::value_type::string)
+                    {
+                        return std::nullopt;
+                    }
+
+                    const auto fld = field_from_key(reader.read_string());
+                    const auto offset = reader.position();
+                    reader.skip();
+
+                    if (fld != msgpack_message::field_count)
+                    {
+                        msg.fields[fld] = { offset, reader.position() - offset };
+                    }
+                }
+
+                if (!reader.at_end())
+                {
+                    return std::nullopt;
+                }
+
+                if (msg.has(msgpack_message::except_type))
+                {
+                    auto ex_reader = msg.reader(msgpack_message::except_type);
+
+                    if (ex_reader.peek_type() != msgpack_reader::value_type::integer
+                        || (ex_reader.read_int<int>() != 0 && !msg.has(msgpack_message::err_mesg)))
+                    {
+                        return std::nullopt;
+                    }
+
+                    // Objects with exceptions can be otherwise empty
+                    return std::make_optional(std::move(msg));
+                }
+
+                if (!msg.has(msgpack_message::func_name))
+                {
+                    return std::nullopt;
+                }
+
+                if (auto name_reader = msg.reader(msgpack_message::func_name);
+                    name_reader.peek_type() != msgpack_reader::value_type::string
+                    || name_reader.read_string().empty())
+                {
+                    return std::nullopt;
+                }
+
+                if (!msg.has(msgpack_message::args)
+                    || msg.reader(msgpack_message::args).peek_type()
+                        != msgpack_reader::value_type::array)
+                {
+                    return std::nullopt;
+                }
+            }
+            catch (const rpc_exception&)
+            {
+                return std::nullopt;
+            }
+
+            return std::make_optional(std::move(msg));
+        }
+
+        static msgpack_message empty_object() { return msgpack_message{ std::string(1, '\x80'), {} }; }
+
+        template<typename R, typename... Args>
+        [[nodiscard]] static msgpack_message serialize_pack(
+            const detail::packed_func<R, Args...>& pack)
+        {
+            msgpack_message msg{};
+            msg.bytes = buffer_pool<std::string>::local().acquire(
+                detail::message_size_hints::get(pack.get_func_name()));
+            msgpack_writer writer{ msg.bytes };
+            const bool has_error = !pack;
+
+            if (has_error)
+            {
+                writer.write_map_header(4);
+            }
+            else
+            {
+                writer.write_map_header(std::is_void_v<R> ? 2 : 3);
+            }
+
+            write_field(msg, writer, msgpack_message::args,
+                [&pack](msgpack_writer& wr)
+                {
+                    wr.write_array_header(sizeof...(Args));
+                    detail::for_each_tuple(
+                        pack.get_args(), [&wr](const auto& elem) { push_arg(elem, wr); });
+                });
+
+            if (has_error)
+            {
+                write_field(msg, writer, msgpack_message::err_mesg,
+                    [&pack](msgpack_writer& wr) { wr.write_string(pack.get_err_mesg()); });
+
+                write_field(msg, writer, msgpack_message::except_type,
+                    [&pack](msgpack_writer& wr)
+                    { wr.write_int(static_cast<int>(pack.get_except_type())); });
+            }
+
+            write_field(msg, writer, msgpack_message::func_name,
+                [&pack](msgpack_writer& wr) { wr.write_string(pack.get_func_name()); });
+
+            if constexpr (!std::is_void_v<R>)
+            {
+                if (!has_error)
+                {
+                    write_field(msg, writer, msgpack_message::result,
+                        [&pack](msgpack_writer& wr) { push_arg(pack.get_result(), wr); });
+                }
+            }
+
+            return msg;
+        }
+
+        template<typename R, typename... Args>
+        [[nodiscard]] static detail::packed_func<R, Args...> deserialize_pack(
+            const msgpack_message& serial_obj)
+        {
+            auto args_reader = serial_obj.reader(msgpack_message::args);
+            [[maybe_unused]] const size_t arg_count = args_reader.read_array_header();
+            [[maybe_unused]] unsigned arg_counter = 0;
+
+            typename detail::packed_func<R, Args...>::args_t args{ parse_args<Args>(
+                args_reader, arg_count, arg_counter)... };
+
+            auto func_name = get_func_name(serial_obj);
+
+            if constexpr (std::is_void_v<R>)
+            {
+                detail::packed_func<void, Args...> pack(std::move(func_name), std::move(args));
+
+                if (serial_obj.has(msgpack_message::except_type))
+                {
+                    set_pack_exception(serial_obj, pack);
+                }
+
+                return pack;
+            }
+            else
+            {
+                // A nil result is a valid value for std::optional
+                if (serial_obj.has(msgpack_message::result)
+                    && (detail::is_optional_v<R>
+                            ? !serial_obj.has(msgpack_message::except_type)
+                            : serial_obj.reader(msgpack_message::result).peek_type()
+                                != msgpack_reader::value_type::nil))
+                {
+                    auto result_reader = serial_obj.reader(msgpack_message::result);
+
+                    return detail::packed_func<R, Args...>(
+                        std::move(func_name), parse_arg<R>(result_reader), std::move(args));
+                }
+
+                detail::packed_func<R, Args...> pack(
+                    std::move(func_name), std::nullopt, std::move(args));
+
+                if (serial_obj.has(msgpack_message::except_type))
+                {
+                    set_pack_exception(serial_obj, pack);
+                }
+
+                return pack;
+            }
+        }
+
+        [[nodiscard]] static std::string get_func_name(const msgpack_message& serial_obj)
+        {
+            if (!serial_obj.has(msgpack_message::func_name))
+            {
+                return {};
+            }
+
+            return std::string{ serial_obj.reader(msgpack_message::func_name).read_string() };
+        }
+
+        [[nodiscard]] static rpc_exception extract_exception(const msgpack_message& serial_obj)
+        {
+            if (!serial_obj.has(msgpack_message::err_mesg)
+                || !serial_obj.has(msgpack_message::except_type))
+            {
+                throw deserialization_error("msgpack: message does not contain an exception");
+            }
+
+            return rpc_exception{
+                std::string{ serial_obj.reader(msgpack_message::err_mesg).read_string() },
+                static_cast<exception_type>(
+                    serial_obj.reader(msgpack_message::except_type).read_int<int>())
+            };
+        }
+
+        // Rebuilds the message in a single pass, keeping all other fields as-is
+        static void set_exception(msgpack_message& serial_obj, const rpc_exception& ex)
+        {
+            const std::string_view mesg = ex.what();
+            msgpack_message msg{};
+            msg.bytes.reserve(serial_obj.bytes.size() + mesg.size() + 16);
+            msgpack_writer writer{ msg.bytes };
+
+            size_t num_fields = 2;
+
+            for (const auto fld : { msgpack_message::args, msgpack_message::func_name,
+                     msgpack_message::result })
+            {
+                num_fields += serial_obj.has(fld) ? 1U : 0U;
+            }
+
+            writer.write_map_header(num_fields);
+
+            for (size_t i = 0; i < msgpack_message::field_count; ++i)
+            {
+                const auto fld = static_cast<msgpack_message::field>(i);
+
+                if (fld == msgpack_message::err_mesg)
+                {
+                    write_field(msg, writer, fld,
+                        [mesg](msgpack_writer& wr) { wr.write_string(mesg); });
+                }
+                else if (fld == msgpack_message::except_type)
+                {
+                    write_field(msg, writer, fld,
+                        [&ex](msgpack_writer& wr) { wr.write_int(static_cast<int>(ex.get_type())); });
+                }
+                else if (serial_obj.has(fld))
+                {
+                    const auto& span = serial_obj.fields[fld];
+
+                    write_field(msg, writer, fld,
+                        [&serial_obj, &span](msgpack_writer& wr) {
+                            wr.write_raw(std::string_view{ serial_obj.bytes }.substr(
+                                span.offset, span.size));
+                        });
+                }
+            }
+
+            serial_obj = std::move(msg);
+        }
+
+        template<typename T>
+        static void serialize(const T& val, msgpack_writer& writer) = delete;
+
+        template<typename T>
+        static T deserialize(msgpack_reader& reader) = delete;
+
+    private:
+        static constexpr std::array<std::string_view, msgpack_message::field_count> field_names{
+            "args", "err_mesg", "except_type", "func_name", "result"
+        };
+
+        [[nodiscard]] static msgpack_message::field field_from_key(const std::string_view key) noexcept
+        {
+            for (size_t i = 0; i < field_names.size(); ++i)
+            {
+                if (field_names[i] == key)
+                {
+                    return static_cast<msgpack_message::field>(i);
+                }
+            }
+
+            return msgpack_message::field_count;
+        }
+
+        template<typename F>
+        static void write_field(
+            msgpack_message& msg, msgpack_writer& writer, const msgpack_message::field fld, F&& func)
+        {
+            writer.write_string(field_names[fld]);
+            const auto offset = writer.position();
+            std::forward<F>(func)(writer);
+            msg.fields[fld] = { offset, writer.position() - offset };
+        }
+
+        template<typename R, typename... Args>
+        static void set_pack_exception(
+            const msgpack_message& serial_obj, detail::packed_func<R, Args...>& pack)
+        {
+            auto mesg = serial_obj.has(msgpack_message::err_mesg)
+                ? std::string{ serial_obj.reader(msgpack_message::err_mesg).read_string() }
+                : std::string{};
+
+            pack.set_exception(std::move(mesg),
+                static_cast<exception_type>(
+                    serial_obj.reader(msgpack_message::except_type).read_int<int>()));
+        }
+
+        template<typename T>
+        static void push_arg(const T& arg, msgpack_writer& writer)
+        {
+            using no_ref_t = std::remove_cv_t<std::remove_reference_t<T>>;
+
+            if constexpr (std::is_same_v<no_ref_t, bool>)
+            {
+                writer.write_bool(arg);
+            }
+            else if constexpr (std::is_integral_v<no_ref_t>)
+            {
+                writer.write_int(arg);
+            }
+            else if constexpr (std::is_floating_point_v<no_ref_t>)
+            {
+                static_assert(!std::is_same_v<no_ref_t, long double>,
+                    "long double is not supported for RPC msgpack serialization!");
+
+                writer.write_float(static_cast<double>(arg));
+            }
+            else if constexpr (std::is_same_v<no_ref_t, std::string>)
+            {
+                writer.write_string(arg);
+            }
+            else if constexpr (detail::is_optional_v<no_ref_t>)
+            {
+                if (arg.has_value())
+                {
+                    push_arg(*arg, writer);
+                }
+                else
+                {
+                    writer.write_nil();
+                }
+            }
+            else if constexpr (detail::is_variant_v<no_ref_t>)
+            {
+                // Encoded as [index, value]
+                writer.write_array_header(2);
+                writer.write_int(arg.index());
+                std::visit([&writer](const auto& val) { push_arg(val, writer); }, arg);
+            }
+            else if constexpr (detail::is_string_map_v<no_ref_t>)
+            {
+                writer.write_map_header(arg.size());
+
+                for (const auto& [key, val] : arg)
+                {
+                    writer.write_string(key);
+                    push_arg(val, writer);
+                }
+            }
+            else if constexpr (detail::is_map_v<no_ref_t>)
+            {
+                // Non-string keys are encoded as an array of [key, value] pairs
+                writer.write_array_header(arg.size());
+
+                for (const auto& [key, val] : arg)
+                {
+                    writer.write_array_header(2);
+                    push_arg(key, writer);
+                    push_arg(val, writer);
+                }
+            }
+            else if constexpr (detail::is_container_v<no_ref_t>)
+            {
+                writer.write_array_header(arg.size());
+
+                for (const auto& val : arg)
+                {
+                    push_arg(val, writer);
+                }
+            }
+            else if constexpr (detail::is_tuple_v<no_ref_t>)
+            {
+                writer.write_array_header(std::tuple_size_v<no_ref_t>);
+                detail::for_each_tuple(arg, [&writer](const auto& val) { push_arg(val, writer); });
+            }
+            else if constexpr (detail::is_serializable_v<msgpack_adapter, no_ref_t>)
+            {
+                writer.write_raw(no_ref_t::template serialize<msgpack_adapter>(arg).bytes);
+            }
+            else if constexpr (detail::is_reflected_v<no_ref_t>)
+            {
+                writer.write_map_header(detail::field_count_v<no_ref_t>);
+
+                detail::for_each_field(arg,
+                    [&writer](const std::string_view name, const auto& field)
+                    {
+                        writer.write_string(name);
+                        push_arg(field, writer);
+                    });
+            }
+            else
+            {
+                serialize<no_ref_t>(arg, writer);
+            }
+        }
+
+        // nodiscard because parsing can be expensive, and it makes no sense to not use the parsed result
+        template<typename T>
+        [[nodiscard]] static std::remove_cv_t<std::remove_reference_t<T>> parse_arg(
+            msgpack_reader& reader)
+        {
+            using no_ref_t = std::remove_cv_t<std::remove_reference_t<T>>;
+
+            if constexpr (std::is_same_v<no_ref_t, bool>)
+            {
+                return reader.read_bool();
+            }
+            else if constexpr (std::is_integral_v<no_ref_t>)
+            {
+                return reader.read_int<no_ref_t>();
+            }
+            else if constexpr (std::is_floating_point_v<no_ref_t>)
+            {
+                return static_cast<no_ref_t>(reader.read_float());
+            }
+            else if constexpr (std::is_same_v<no_ref_t, std::string>)
+            {
+                return std::string{ reader.read_string() };
+            }
+            else if constexpr (detail::is_optional_v<no_ref_t>)
+            {
+                if (reader.peek_type() == msgpack_reader::value_type::nil)
+                {
+                    reader.skip();
+                    return std::nullopt;
+                }
+
+                return parse_arg<typename no_ref_t::value_type>(reader);
+            }
+            else if constexpr (detail::is_variant_v<no_ref_t>)
+            {
+                if (reader.read_array_header() != 2)
+                {
+                    throw function_mismatch("msgpack expected type: [index, value]");
+                }
+
+                const auto index = reader.read_int<int64_t>();
+
+                if (index < 0)
+                {
+                    throw function_mismatch("Variant index out of range");
+                }
+
+                return detail::make_variant<no_ref_t>(static_cast<size_t>(index),
+                    [&reader](auto tag) { return parse_arg<typename decltype(tag)::type>(reader); });
+            }
+            else if constexpr (detail::is_map_v<no_ref_t>)
+            {
+                using key_t = typename no_ref_t::key_type;
+                using mapped_t = typename no_ref_t::mapped_type;
+
+                no_ref_t container{};
+
+                if constexpr (detail::is_string_map_v<no_ref_t>)
+                {
+                    const auto size = reader.read_map_header();
+                    detail::reserve_if_able(container, size);
+
+                    for (size_t i = 0; i < size; ++i)
+                    {
+                        auto key = std::string{ reader.read_string() };
+                        detail::emplace_assoc(
+                            container, std::move(key), parse_arg<mapped_t>(reader));
+                    }
+                }
+                else
+                {
+                    const auto size = reader.read_array_header();
+                    detail::reserve_if_able(container, size);
+
+                    for (size_t i = 0; i < size; ++i)
+                    {
+                        if (reader.read_array_header() != 2)
+                        {
+                            throw function_mismatch("msgpack expected type: [key, value]");
+                        }
+
+                        auto key = parse_arg<key_t>(reader);
+                        detail::emplace_assoc(
+                            container, std::move(key), parse_arg<mapped_t>(reader));
+                    }
+                }
+
+                return container;
+            }
+            else if constexpr (detail::is_set_v<no_ref_t>)
+            {
+                const auto size = reader.read_array_header();
+                no_ref_t container{};
+                detail::reserve_if_able(container, size);
+
+                for (size_t i = 0; i < size; ++i)
+                {
+                    detail::emplace_assoc(
+                        container, parse_arg<typename no_ref_t::value_type>(reader));
+                }
+
+                return container;
+            }
+            else if constexpr (detail::is_fixed_extent_v<no_ref_t>)
+            {
+                using value_t = typename no_ref_t::value_type;
+
+                detail::check_extent<no_ref_t>(reader.read_array_header());
+                no_ref_t container{};
+
+                for (auto& val : container)
+                {
+                    val = parse_arg<value_t>(reader);
+                }
+
+                return container;
+            }
+            else if constexpr (detail::is_container_v<no_ref_t>)
+            {
+                using value_t = typename no_ref_t::value_type;
+
+                const auto size = reader.read_array_header();
+                no_ref_t container{};
+                container.reserve(size);
+
+                for (size_t i = 0; i < size; ++i)
+                {
+                    container.push_back(parse_arg<value_t>(reader));
+                }
+
+                return container;
+            }
+            else if constexpr (detail::is_tuple_v<no_ref_t>)
+            {
+                const auto size = reader.read_array_header();
+                unsigned arg_counter = 0;
+                no_ref_t container{};
+
+                detail::for_each_tuple(container,
+                    [&reader, size, &arg_counter](auto& val)
+                    { val = parse_args<decltype(val)>(reader, size, arg_counter); });
+
+                return container;
+            }
+            else if constexpr (detail::is_serializable_v<msgpack_adapter, no_ref_t>)
+            {
+                const auto start = reader.position();
+                msgpack_reader sub_reader = reader;
+                sub_reader.skip();
+
+                msgpack_message sub_msg{};
+                sub_msg.bytes = std::string{ reader.read_raw(sub_reader.position() - start) };
+                return no_ref_t::template deserialize<msgpack_adapter>(sub_msg);
+            }
+            else if constexpr (detail::is_reflected_v<no_ref_t>)
+            {
+                no_ref_t val{};
+                const auto num_fields = reader.read_map_header();
+
+                // Fields may arrive in any order, unknown ones are skipped
+                for (size_t i = 0; i < num_fields; ++i)
+                {
+                    const auto key = reader.read_string();
+                    bool found = false;
+
+                    detail::for_each_field(val,
+                        [&reader, key, &found](const std::string_view name, auto& field)
+                        {
+                            if (!found && name == key)
+                            {
+                                field = parse_arg<std::remove_reference_t<decltype(field)>>(reader);
+                                found = true;
+                            }
+                        });
+
+                    if (!found)
+                    {
+                        reader.skip();
+                    }
+                }
+
+                return val;
+            }
+            else
+            {
+                return deserialize<no_ref_t>(reader);
+            }
+        }
+
+        // nodiscard because parsing can be expensive, and it makes no sense to not use the parsed result
+        template<typename T>
+        [[nodiscard]] static std::remove_cv_t<std::remove_reference_t<T>> parse_args(
+            msgpack_reader& reader, const size_t arg_count, unsigned& index)
+        {
+            if (index >= arg_count)
+            {
+                throw function_mismatch("Argument count mismatch");
+            }
+
+            ++index;
+            return parse_arg<T>(reader);
+        }
+    };
+} // namespace adapters
+} // namespace rpc_hpp
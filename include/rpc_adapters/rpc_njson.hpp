@@ -37,44 +37,173 @@
 #pragma once
 
 #include "../rpc.hpp"
+#include "rpc_msgpack.hpp"
 
 #include <nlohmann/json.hpp>
 
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
 namespace rpc_hpp
 {
 namespace adapters
 {
-    class njson_adapter;
+    ///@brief Wire formats that njson can encode messages with
+    enum class njson_format
+    {
+        msgpack,
+        cbor,
+        bson,
+        ubjson,
+        json,
+    };
+
+    template<njson_format Format>
+    class basic_njson_adapter;
+
+    ///@brief njson adapter using MessagePack
+    using njson_adapter = basic_njson_adapter<njson_format::msgpack>;
+
+    ///@brief njson adapter using CBOR
+    using njson_cbor_adapter = basic_njson_adapter<njson_format::cbor>;
+
+    ///@brief njson adapter using BSON (unsigned integers must fit in an int64_t)
+    using njson_bson_adapter = basic_njson_adapter<njson_format::bson>;
+
+    ///@brief njson adapter using UBJSON
+    using njson_ubjson_adapter = basic_njson_adapter<njson_format::ubjson>;
 
-    template<>
-    struct serial_traits<njson_adapter>
+    ///@brief njson adapter using JSON text
+    using njson_text_adapter = basic_njson_adapter<njson_format::json>;
+
+    template<njson_format Format>
+    struct serial_traits<basic_njson_adapter<Format>>
     {
         using serial_t = nlohmann::json;
-        using bytes_t = std::string;
+        using bytes_t = std::conditional_t<Format == njson_format::json, std::string,
+            std::vector<uint8_t>>;
     };
 
-    class njson_adapter : public detail::serial_adapter_base<njson_adapter>
+    template<njson_format Format>
+    class basic_njson_adapter : public detail::serial_adapter_base<basic_njson_adapter<Format>>
     {
     public:
-        [[nodiscard]] static std::string to_bytes(nlohmann::json&& serial_obj)
+        using bytes_t = typename serial_traits<basic_njson_adapter>::bytes_t;
+
+        ///@brief Encodes the object straight into the returned buffer
+        [[nodiscard]] static bytes_t to_bytes(nlohmann::json&& serial_obj)
+        {
+            bytes_t bytes{};
+            to_bytes(std::move(serial_obj), bytes);
+            return bytes;
+        }
+
+        ///@brief Encodes the object into out (replacing its contents), reusing its capacity for the
+        ///binary formats
+        static void to_bytes(nlohmann::json&& serial_obj, bytes_t& out)
         {
-            auto msg_pack = nlohmann::json::to_msgpack(serial_obj);
-            return {msg_pack.begin(), msg_pack.end()};
+            out.clear();
+
+            if constexpr (Format == njson_format::msgpack)
+            {
+                nlohmann::json::to_msgpack(serial_obj, out);
+            }
+            else if constexpr (Format == njson_format::cbor)
+            {
+                nlohmann::json::to_cbor(serial_obj, out);
+            }
+            else if constexpr (Format == njson_format::bson)
+            {
+                nlohmann::json::to_bson(serial_obj, out);
+            }
+            else if constexpr (Format == njson_format::ubjson)
+            {
+                nlohmann::json::to_ubjson(serial_obj, out);
+            }
+            else
+            {
+                // nlohmann::json only offers text output through dump(), so this is a new string
+                out = serial_obj.dump();
+            }
+        }
+
+        ///@brief Whether a message in this format can start with byte (lets multi_server recognize the format)
+        [[nodiscard]] static constexpr bool may_start_with(const uint8_t byte) noexcept
+        {
+            // The binary formats' maps and arrays share first bytes with each other, so only the
+            // form this side writes is claimed
+            if constexpr (Format == njson_format::msgpack)
+            {
+                return use_compact_envelope
+                    ? (byte >= 0x90U && byte <= 0x9FU) || byte == 0xDCU || byte == 0xDDU
+                    : (byte >= 0x80U && byte <= 0x8FU) || byte == 0xDEU || byte == 0xDFU;
+            }
+            else if constexpr (Format == njson_format::cbor)
+            {
+                return use_compact_envelope ? byte >= 0x80U && byte <= 0x9FU
+                                            : byte >= 0xA0U && byte <= 0xBFU;
+            }
+            else if constexpr (Format == njson_format::bson)
+            {
+                // Documents start with their size, which could be anything
+                return true;
+            }
+            else if constexpr (Format == njson_format::ubjson)
+            {
+                return byte == '{' || byte == '[';
+            }
+            else
+            {
+                return detail::is_json_text_start(byte);
+            }
         }
 
-        [[nodiscard]] static std::optional<nlohmann::json> from_bytes(std::string&& bytes)
+        [[nodiscard]] static std::optional<nlohmann::json> from_bytes(bytes_t&& bytes)
         {
             nlohmann::json obj;
 
             try
             {
-                obj = nlohmann::json::from_msgpack(bytes);
+                if constexpr (Format == njson_format::msgpack)
+                {
+                    obj = nlohmann::json::from_msgpack(bytes);
+                }
+                else if constexpr (Format == njson_format::cbor)
+                {
+                    // Binary subtypes are written as CBOR tags
+                    obj = nlohmann::json::from_cbor(
+                        bytes, true, true, nlohmann::json::cbor_tag_handler_t::store);
+                }
+                else if constexpr (Format == njson_format::bson)
+                {
+                    obj = nlohmann::json::from_bson(bytes);
+                }
+                else if constexpr (Format == njson_format::ubjson)
+                {
+                    obj = nlohmann::json::from_ubjson(bytes);
+                }
+                else
+                {
+                    obj = nlohmann::json::parse(bytes);
+                }
             }
             catch (const nlohmann::json::parse_error&)
             {
                 return std::nullopt;
             }
 
+            // The object holds copies of everything, so the buffer can serve a later message
+            buffer_pool<bytes_t>::local().release(std::move(bytes));
+
+            if (obj.is_array())
+            {
+                return is_compact_message(obj) ? std::make_optional(std::move(obj)) : std::nullopt;
+            }
+
             if (!obj.is_object())
             {
                 return std::nullopt;
@@ -105,12 +234,27 @@ namespace adapters
             return std::make_optional(std::move(obj));
         }
 
-        static nlohmann::json empty_object() { return nlohmann::json::object(); }
+        static nlohmann::json empty_object()
+        {
+            if constexpr (use_compact_envelope)
+            {
+                return nlohmann::json::array({ detail::compact_envelope::version, 0U, "", nullptr });
+            }
+            else
+            {
+                return nlohmann::json::object();
+            }
+        }
 
         template<typename R, typename... Args>
         [[nodiscard]] static nlohmann::json serialize_pack(
             const detail::packed_func<R, Args...>& pack)
         {
+            if constexpr (use_compact_envelope)
+            {
+                return serialize_compact(pack);
+            }
+
             nlohmann::json obj{};
             obj["func_name"] = pack.get_func_name();
             obj["args"] = nlohmann::json::array();
@@ -141,6 +285,25 @@ namespace adapters
         [[nodiscard]] static detail::packed_func<R, Args...> deserialize_pack(
             const nlohmann::json& serial_obj)
         {
+            if (serial_obj.is_array())
+            {
+                return deserialize_compact<R, Args...>(serial_obj);
+            }
+
+            // Replies to requests that could not be read hold nothing but the exception
+            if (!serial_obj.contains("args"))
+            {
+                detail::streamed_pack<R, Args...> fields{};
+
+                if (const auto ex_it = serial_obj.find("except_type"); ex_it != serial_obj.end())
+                {
+                    fields.except_type = static_cast<exception_type>(ex_it->get<int>());
+                    fields.err_mesg = serial_obj.value("err_mesg", std::string{});
+                }
+
+                return std::move(fields).finish();
+            }
+
             const auto& args_val = serial_obj["args"];
             [[maybe_unused]] unsigned arg_counter = 0;
             typename detail::packed_func<R, Args...>::args_t args{ parse_args<Args>(
@@ -160,7 +323,10 @@ namespace adapters
             }
             else
             {
-                if (serial_obj.contains("result") && !serial_obj["result"].is_null())
+                // A null result is a valid value for std::optional
+                if (serial_obj.contains("result")
+                    && (detail::is_optional_v<R> ? !serial_obj.contains("except_type")
+                                                 : !serial_obj["result"].is_null()))
                 {
                     return detail::packed_func<R, Args...>(serial_obj["func_name"],
                         parse_arg<R>(serial_obj["result"]), std::move(args));
@@ -179,19 +345,160 @@ namespace adapters
             }
         }
 
+        ///@brief Finds the name of the function a message calls, without parsing the rest of it
+        /// (MessagePack only, other formats are parsed with from_bytes)
+        ///
+        ///@return std::optional<std::string> The function name (std::nullopt if the message is invalid)
+        template<njson_format F = Format, typename = std::enable_if_t<F == njson_format::msgpack>>
+        [[nodiscard]] static std::optional<std::string> peek_func_name(const bytes_t& bytes)
+        {
+            try
+            {
+                msgpack_reader reader{ as_view(bytes) };
+
+                if (reader.peek_type() == msgpack_reader::value_type::array)
+                {
+                    if (reader.read_array_header() < detail::compact_envelope::args_index
+                        || reader.read_int<int>() != detail::compact_envelope::version)
+                    {
+                        return std::nullopt;
+                    }
+
+                    reader.skip();
+
+                    if (const auto func_name = reader.read_string(); !func_name.empty())
+                    {
+                        return std::string{ func_name };
+                    }
+
+                    return std::nullopt;
+                }
+
+                const auto num_fields = reader.read_map_header();
+
+                for (size_t i = 0; i < num_fields; ++i)
+                {
+                    if (reader.read_string() != "func_name")
+                    {
+                        reader.skip();
+                        continue;
+                    }
+
+                    if (const auto func_name = reader.read_string(); !func_name.empty())
+                    {
+                        return std::string{ func_name };
+                    }
+
+                    break;
+                }
+            }
+            catch (const rpc_exception&)
+            {
+            }
+
+            return std::nullopt;
+        }
+
+        ///@brief Reads a message straight from its (MessagePack) bytes into a packed_func, without
+        /// building a nlohmann::json object first
+        template<typename R, typename... Args>
+        [[nodiscard]] static detail::packed_func<R, Args...> parse_pack(const bytes_t& bytes)
+        {
+            static_assert(Format == njson_format::msgpack,
+                "parse_pack is only available for MessagePack");
+
+            using args_t = typename detail::packed_func<R, Args...>::args_t;
+
+            msgpack_reader reader{ as_view(bytes) };
+            detail::streamed_pack<R, Args...> fields{};
+
+            if (reader.peek_type() == msgpack_reader::value_type::array)
+            {
+                read_compact(reader, fields);
+                return std::move(fields).finish();
+            }
+
+            const auto num_fields = reader.read_map_header();
+
+            for (size_t i = 0; i < num_fields; ++i)
+            {
+                const auto key = reader.read_string();
+
+                if (key == "args")
+                {
+                    const size_t arg_count = reader.read_array_header();
+                    [[maybe_unused]] unsigned arg_counter = 0;
+
+                    fields.args =
+                        args_t{ read_args<Args>(reader, arg_count, arg_counter)... };
+
+                    for (size_t j = sizeof...(Args); j < arg_count; ++j)
+                    {
+                        reader.skip();
+                    }
+                }
+                else if (key == "result")
+                {
+                    read_result(reader, fields);
+                }
+                else if (key == "func_name")
+                {
+                    fields.func_name = reader.read_string();
+                }
+                else if (key == "except_type")
+                {
+                    fields.except_type = static_cast<exception_type>(reader.read_int<int>());
+                }
+                else if (key == "err_mesg")
+                {
+                    fields.err_mesg = reader.read_string();
+                }
+                else
+                {
+                    reader.skip();
+                }
+            }
+
+            return std::move(fields).finish();
+        }
+
         [[nodiscard]] static std::string get_func_name(const nlohmann::json& serial_obj)
         {
+            if (serial_obj.is_array())
+            {
+                return serial_obj[detail::compact_envelope::func_name_index];
+            }
+
             return serial_obj["func_name"];
         }
 
         [[nodiscard]] static rpc_exception extract_exception(const nlohmann::json& serial_obj)
         {
+            if (serial_obj.is_array())
+            {
+                const auto& slot = serial_obj.at(detail::compact_envelope::result_index);
+
+                return rpc_exception{ slot.at(1).get<std::string>(),
+                    static_cast<exception_type>(slot.at(0).get<int>()) };
+            }
+
             return rpc_exception{ serial_obj.at("err_mesg").get<std::string>(),
                 static_cast<exception_type>(serial_obj.at("except_type").get<int>()) };
         }
 
         static void set_exception(nlohmann::json& serial_obj, const rpc_exception& ex)
         {
+            if (serial_obj.is_array())
+            {
+                // The error replaces the result
+                auto& flags = serial_obj[detail::compact_envelope::flags_index];
+                flags = flags.get<unsigned>() | detail::compact_envelope::error_flag;
+                serial_obj[detail::compact_envelope::result_index] =
+                    nlohmann::json::array({ static_cast<int>(ex.get_type()), ex.what() });
+
+                return;
+            }
+
             serial_obj["except_type"] = ex.get_type();
             serial_obj["err_mesg"] = ex.what();
         }
@@ -203,6 +510,140 @@ namespace adapters
         static T deserialize(const nlohmann::json& serial_obj) = delete;
 
     private:
+        // Numeric containers are sent as binary values holding their raw bytes, tagged with the
+        // element type. Decoding accepts both forms regardless of this setting
+#if defined(RPC_HPP_NJSON_BINARY_ARRAYS)
+        static constexpr bool use_binary_arrays = true;
+#else
+        static constexpr bool use_binary_arrays = false;
+#endif
+
+        // Messages are written as a positional array (see detail::compact_envelope) instead of an
+        // object with named fields. BSON documents must be objects, so it always uses the object.
+        // Decoding accepts both forms regardless of this setting
+#if defined(RPC_HPP_NJSON_COMPACT_ENVELOPE)
+        static constexpr bool use_compact_envelope = Format != njson_format::bson;
+#else
+        static constexpr bool use_compact_envelope = false;
+#endif
+
+        // UBJSON and JSON text have no binary type, so binary values are sent as base64 strings
+        // instead (like the other JSON adapters)
+        static constexpr bool has_binary =
+            Format != njson_format::ubjson && Format != njson_format::json;
+
+        [[nodiscard]] static std::string_view as_view(const bytes_t& bytes) noexcept
+        {
+            return { reinterpret_cast<const char*>(bytes.data()), bytes.size() };
+        }
+
+        [[nodiscard]] static bool is_blob(const nlohmann::json& arg) noexcept
+        {
+            return has_binary ? arg.is_binary() : arg.is_string();
+        }
+
+        // Checks the fixed fields of a compact envelope
+        [[nodiscard]] static bool is_compact_message(const nlohmann::json& arr)
+        {
+            using envelope = detail::compact_envelope;
+
+            if (arr.size() < envelope::args_index
+                || !arr[envelope::version_index].is_number_integer()
+                || arr[envelope::version_index] != envelope::version
+                || !arr[envelope::flags_index].is_number_integer()
+                || arr[envelope::flags_index].get<int64_t>() < 0
+                || !arr[envelope::func_name_index].is_string())
+            {
+                return false;
+            }
+
+            if (envelope::has_error(arr[envelope::flags_index].get<unsigned>()))
+            {
+                const auto& slot = arr[envelope::result_index];
+
+                return slot.is_array() && slot.size() == 2 && slot[0].is_number_integer()
+                    && slot[1].is_string();
+            }
+
+            return !arr[envelope::func_name_index].get_ref<const std::string&>().empty();
+        }
+
+        template<typename R, typename... Args>
+        [[nodiscard]] static nlohmann::json serialize_compact(
+            const detail::packed_func<R, Args...>& pack)
+        {
+            using envelope = detail::compact_envelope;
+
+            const bool has_error = pack.get_except_type() != exception_type::none;
+            nlohmann::json arr = nlohmann::json::array();
+            arr.get_ref<nlohmann::json::array_t&>().reserve(envelope::args_index + sizeof...(Args));
+            arr.push_back(envelope::version);
+            arr.push_back(has_error ? envelope::error_flag : 0U);
+            arr.push_back(pack.get_func_name());
+
+            if (has_error)
+            {
+                arr.push_back(nlohmann::json::array(
+                    { static_cast<int>(pack.get_except_type()), pack.get_err_mesg() }));
+            }
+            else if constexpr (!std::is_void_v<R>)
+            {
+                if (pack)
+                {
+                    push_args(pack.get_result(), arr);
+                }
+                else
+                {
+                    arr.push_back(nullptr);
+                }
+            }
+            else
+            {
+                arr.push_back(nullptr);
+            }
+
+            detail::for_each_tuple(pack.get_args(),
+                [&arr](auto&& elem) { push_args(std::forward<decltype(elem)>(elem), arr); });
+
+            return arr;
+        }
+
+        template<typename R, typename... Args>
+        [[nodiscard]] static detail::packed_func<R, Args...> deserialize_compact(
+            const nlohmann::json& serial_obj)
+        {
+            using envelope = detail::compact_envelope;
+
+            detail::streamed_pack<R, Args...> fields{};
+            fields.func_name = serial_obj[envelope::func_name_index].get<std::string>();
+            const auto& slot = serial_obj[envelope::result_index];
+
+            if (envelope::has_error(serial_obj[envelope::flags_index].get<unsigned>()))
+            {
+                fields.except_type = static_cast<exception_type>(slot[0].get<int>());
+                fields.err_mesg = slot[1].get<std::string>();
+
+                if (serial_obj.size() == envelope::args_index)
+                {
+                    return std::move(fields).finish();
+                }
+            }
+            else if constexpr (!std::is_void_v<R>)
+            {
+                // A null result is a valid value for std::optional
+                if (detail::is_optional_v<R> || !slot.is_null())
+                {
+                    fields.result = parse_arg<R>(slot);
+                }
+            }
+
+            [[maybe_unused]] unsigned arg_counter = envelope::args_index;
+            fields.args = typename detail::packed_func<R, Args...>::args_t{ parse_args<Args>(
+                serial_obj, arg_counter)... };
+
+            return std::move(fields).finish();
+        }
+
         // nodiscard because this function is pointless without checking the bool
         template<typename T>
         [[nodiscard]] static constexpr bool validate_arg(const nlohmann::json& arg) noexcept
@@ -223,10 +664,37 @@ namespace adapters
             {
                 return arg.is_string();
             }
+            else if constexpr (detail::is_optional_v<T>)
+            {
+                // null or the contained value, which is validated when parsed
+                return true;
+            }
+            else if constexpr (detail::is_variant_v<T>)
+            {
+                // BSON has no unsigned type, so the index may be read back as signed
+                return arg.is_array() && arg.size() == 2 && arg[0].is_number_integer()
+                    && arg[0].template get<int64_t>() >= 0;
+            }
+            else if constexpr (detail::is_string_map_v<T>)
+            {
+                return arg.is_object();
+            }
+            else if constexpr (detail::is_byte_container_v<T>)
+            {
+                return is_blob(arg);
+            }
+            else if constexpr (detail::is_bulk_container_v<T>)
+            {
+                return arg.is_array() || is_blob(arg);
+            }
             else if constexpr (detail::is_container_v<T> && !std::is_same_v<T, nlohmann::json>)
             {
                 return arg.is_array();
             }
+            else if constexpr (detail::is_reflected_v<T>)
+            {
+                return arg.is_object();
+            }
             else
             {
                 return !arg.is_null();
@@ -250,6 +718,77 @@ namespace adapters
                           std::is_same_v<no_ref_t, nlohmann::json>) {
                 obj = std::forward<T>(arg);
             }
+            else if constexpr (detail::is_optional_v<no_ref_t>)
+            {
+                if (arg.has_value())
+                {
+                    push_arg(*arg, obj);
+                }
+                else
+                {
+                    obj = nullptr;
+                }
+            }
+            else if constexpr (detail::is_variant_v<no_ref_t>)
+            {
+                // Encoded as [index, value]
+                obj = nlohmann::json::array();
+                obj.get_ref<nlohmann::json::array_t&>().reserve(2);
+                obj.push_back(arg.index());
+                std::visit([&obj](const auto& val) { push_args(val, obj); }, arg);
+            }
+            else if constexpr (detail::is_map_v<no_ref_t>)
+            {
+                if constexpr (detail::is_string_map_v<no_ref_t>)
+                {
+                    obj = nlohmann::json::object();
+
+                    for (const auto& [key, val] : arg)
+                    {
+                        push_arg(val, obj[key]);
+                    }
+                }
+                else
+                {
+                    // Non-string keys are encoded as an array of [key, value] pairs
+                    obj = nlohmann::json::array();
+                    obj.get_ref<nlohmann::json::array_t&>().reserve(arg.size());
+
+                    for (const auto& [key, val] : arg)
+                    {
+                        nlohmann::json pair = nlohmann::json::array();
+                        push_args(key, pair);
+                        push_args(val, pair);
+                        obj.push_back(std::move(pair));
+                    }
+                }
+            }
+            else if constexpr ((use_binary_arrays && detail::is_bulk_container_v<no_ref_t>)
+                || detail::is_byte_container_v<no_ref_t>)
+            {
+                using value_t = typename no_ref_t::value_type;
+
+                const auto byte_size = arg.size() * sizeof(value_t);
+
+                if constexpr (has_binary)
+                {
+                    nlohmann::json::binary_t::container_type bytes(byte_size);
+
+                    if (byte_size != 0)
+                    {
+                        std::memcpy(bytes.data(), arg.data(), byte_size);
+                    }
+
+                    obj = nlohmann::json::binary(
+                        std::move(bytes), detail::bulk_type_tag_v<value_t>);
+                }
+                else
+                {
+                    std::string text(detail::base64_encoded_size(byte_size), '\0');
+                    detail::base64_encode(arg.data(), byte_size, text.data());
+                    obj = std::move(text);
+                }
+            }
             else if constexpr (detail::is_container_v<no_ref_t>)
             {
                 obj = nlohmann::json::array();
@@ -272,9 +811,17 @@ namespace adapters
                     obj[arg_counter++] = std::move(tmp);
                 });
             }
-            else if constexpr (detail::is_serializable_v<njson_adapter, no_ref_t>)
+            else if constexpr (detail::is_serializable_v<basic_njson_adapter, no_ref_t>)
+            {
+                obj = no_ref_t::template serialize<basic_njson_adapter>(std::forward<T>(arg));
+            }
+            else if constexpr (detail::is_reflected_v<no_ref_t>)
             {
-                obj = no_ref_t::template serialize<njson_adapter>(std::forward<T>(arg));
+                obj = nlohmann::json::object();
+
+                detail::for_each_field(arg,
+                    [&obj](const std::string_view name, const auto& field)
+                    { push_arg(field, obj[std::string{ name }]); });
             }
             else
             {
@@ -302,6 +849,14 @@ namespace adapters
                 throw function_mismatch(mismatch_string(typeid(T).name(), arg));
             }
 
+            if constexpr (detail::is_bulk_container_v<no_ref_t>)
+            {
+                if (is_blob(arg))
+                {
+                    return parse_bulk<no_ref_t>(arg);
+                }
+            }
+
             if constexpr (std::is_same_v<no_ref_t, nlohmann::json>)
             {
                 return arg;
@@ -310,18 +865,94 @@ namespace adapters
             {
                 return arg.get<no_ref_t>();
             }
+            else if constexpr (detail::is_optional_v<no_ref_t>)
+            {
+                if (arg.is_null())
+                {
+                    return std::nullopt;
+                }
+
+                return parse_arg<typename no_ref_t::value_type>(arg);
+            }
+            else if constexpr (detail::is_variant_v<no_ref_t>)
+            {
+                const auto& val = arg[1];
+
+                return detail::make_variant<no_ref_t>(arg[0].get<size_t>(),
+                    [&val](auto tag) { return parse_arg<typename decltype(tag)::type>(val); });
+            }
+            else if constexpr (detail::is_map_v<no_ref_t>)
+            {
+                using key_t = typename no_ref_t::key_type;
+                using mapped_t = typename no_ref_t::mapped_type;
+
+                no_ref_t container{};
+                detail::reserve_if_able(container, arg.size());
+
+                if constexpr (detail::is_string_map_v<no_ref_t>)
+                {
+                    for (const auto& item : arg.items())
+                    {
+                        detail::emplace_assoc(
+                            container, item.key(), parse_arg<mapped_t>(item.value()));
+                    }
+                }
+                else
+                {
+                    for (const auto& pair : arg)
+                    {
+                        if (!pair.is_array() || pair.size() != 2)
+                        {
+                            throw function_mismatch(mismatch_string("[key, value]", pair));
+                        }
+
+                        detail::emplace_assoc(
+                            container, parse_arg<key_t>(pair[0]), parse_arg<mapped_t>(pair[1]));
+                    }
+                }
+
+                return container;
+            }
+            else if constexpr (detail::is_set_v<no_ref_t>)
+            {
+                no_ref_t container{};
+                detail::reserve_if_able(container, arg.size());
+
+                for (const auto& val : arg)
+                {
+                    detail::emplace_assoc(container, parse_arg<typename no_ref_t::value_type>(val));
+                }
+
+                return container;
+            }
+            else if constexpr (detail::is_byte_container_v<no_ref_t>)
+            {
+                return parse_bulk<no_ref_t>(arg);
+            }
+            else if constexpr (detail::is_fixed_extent_v<no_ref_t>)
+            {
+                using value_t = typename no_ref_t::value_type;
+
+                detail::check_extent<no_ref_t>(arg.size());
+                no_ref_t container{};
+
+                for (size_t i = 0; i < container.size(); ++i)
+                {
+                    container[i] = parse_arg<value_t>(arg[i]);
+                }
+
+                return container;
+            }
             else if constexpr (detail::is_container_v<no_ref_t>)
             {
                 using value_t = typename no_ref_t::value_type;
 
                 no_ref_t container{};
                 container.reserve(arg.size());
-                unsigned arg_counter = 0;
 
                 for (const auto& val : arg)
                 {
-                    // TODO val -> arg? Note that the first argument of parse_args requires an array
-                    container.push_back(parse_args<value_t>(val, arg_counter));
+                    container.push_back(parse_arg<value_t>(val));
                 }
 
                 return container;
@@ -336,9 +967,29 @@ namespace adapters
                 });
                 return container;
             }
-            else if constexpr (detail::is_serializable_v<njson_adapter, no_ref_t>)
+            else if constexpr (detail::is_serializable_v<basic_njson_adapter, no_ref_t>)
+            {
+                return no_ref_t::template deserialize<basic_njson_adapter>(arg);
+            }
+            else if constexpr (detail::is_reflected_v<no_ref_t>)
             {
-                return no_ref_t::template deserialize<njson_adapter>(arg);
+                no_ref_t val{};
+
+                detail::for_each_field(val,
+                    [&arg](const std::string_view name, auto& field)
+                    {
+                        const auto field_it = arg.find(std::string{ name });
+
+                        if (field_it == arg.end())
+                        {
+                            throw function_mismatch(
+                                "njson missing field: " + std::string{ name });
+                        }
+
+                        field = parse_arg<std::remove_reference_t<decltype(field)>>(*field_it);
+                    });
+
+                return val;
             }
             else
             {
@@ -346,6 +997,51 @@ namespace adapters
             }
         }
 
+        // nodiscard because parsing can be expensive, and it makes no sense to not use the parsed result
+        template<typename C>
+        [[nodiscard]] static C parse_bulk(const nlohmann::json& arg)
+        {
+            if constexpr (!has_binary)
+            {
+                const auto& text = arg.get_ref<const std::string&>();
+                const auto byte_size = detail::base64_decoded_size(text);
+
+                if (!byte_size.has_value())
+                {
+                    throw function_mismatch(mismatch_string(typeid(C).name(), arg));
+                }
+
+                C container{};
+
+                if (!detail::base64_decode(text, detail::resize_bulk(container, *byte_size)))
+                {
+                    throw function_mismatch(mismatch_string(typeid(C).name(), arg));
+                }
+
+                return container;
+            }
+            else
+            {
+                const auto& bytes = arg.get_binary();
+
+                if (!bytes.has_subtype()
+                    || bytes.subtype() != detail::bulk_type_tag_v<typename C::value_type>)
+                {
+                    throw function_mismatch(mismatch_string(typeid(C).name(), arg));
+                }
+
+                C container{};
+                auto* const data = detail::resize_bulk(container, bytes.size());
+
+                if (!bytes.empty())
+                {
+                    std::memcpy(data, bytes.data(), bytes.size());
+                }
+
+                return container;
+            }
+        }
+
         // nodiscard because parsing can be expensive, and it makes no sense to not use the parsed result
         template<typename T>
         [[nodiscard]] static std::remove_cv_t<std::remove_reference_t<T>> parse_args(
@@ -359,6 +1055,343 @@ namespace adapters
             const auto& arg = arg_arr.is_array() ? arg_arr[index++] : arg_arr;
             return parse_arg<T>(arg);
         }
+
+        // Reads a value straight from MessagePack, accepting the same encodings as parse_arg
+        // nodiscard because parsing can be expensive, and it makes no sense to not use the parsed result
+        template<typename T>
+        [[nodiscard]] static std::remove_cv_t<std::remove_reference_t<T>> read_arg(
+            msgpack_reader& reader)
+        {
+            using no_ref_t = std::remove_cv_t<std::remove_reference_t<T>>;
+
+            if constexpr (detail::is_bulk_container_v<no_ref_t>)
+            {
+                if (const auto type = reader.peek_type(); type == msgpack_reader::value_type::binary
+                    || type == msgpack_reader::value_type::ext)
+                {
+                    return read_bulk<no_ref_t>(reader);
+                }
+            }
+
+            if constexpr (std::is_same_v<no_ref_t, nlohmann::json>)
+            {
+                return read_json(reader);
+            }
+            else if constexpr (std::is_same_v<no_ref_t, bool>)
+            {
+                return reader.read_bool();
+            }
+            else if constexpr (std::is_integral_v<no_ref_t>)
+            {
+                return reader.read_int<no_ref_t>();
+            }
+            else if constexpr (std::is_floating_point_v<no_ref_t>)
+            {
+                return static_cast<no_ref_t>(reader.read_float());
+            }
+            else if constexpr (std::is_same_v<no_ref_t, std::string>)
+            {
+                return std::string{ reader.read_string() };
+            }
+            else if constexpr (detail::is_optional_v<no_ref_t>)
+            {
+                if (reader.peek_type() == msgpack_reader::value_type::nil)
+                {
+                    reader.skip();
+                    return std::nullopt;
+                }
+
+                return read_arg<typename no_ref_t::value_type>(reader);
+            }
+            else if constexpr (detail::is_variant_v<no_ref_t>)
+            {
+                if (reader.read_array_header() != 2)
+                {
+                    throw function_mismatch("njson expected type: [index, value]");
+                }
+
+                const auto index = reader.read_int<int64_t>();
+
+                if (index < 0)
+                {
+                    throw function_mismatch("Variant index out of range");
+                }
+
+                return detail::make_variant<no_ref_t>(static_cast<size_t>(index),
+                    [&reader](auto tag) { return read_arg<typename decltype(tag)::type>(reader); });
+            }
+            else if constexpr (detail::is_map_v<no_ref_t>)
+            {
+                using key_t = typename no_ref_t::key_type;
+                using mapped_t = typename no_ref_t::mapped_type;
+
+                no_ref_t container{};
+
+                if constexpr (detail::is_string_map_v<no_ref_t>)
+                {
+                    const auto size = reader.read_map_header();
+                    detail::reserve_if_able(container, size);
+
+                    for (size_t i = 0; i < size; ++i)
+                    {
+                        auto key = std::string{ reader.read_string() };
+                        detail::emplace_assoc(
+                            container, std::move(key), read_arg<mapped_t>(reader));
+                    }
+                }
+                else
+                {
+                    const auto size = reader.read_array_header();
+                    detail::reserve_if_able(container, size);
+
+                    for (size_t i = 0; i < size; ++i)
+                    {
+                        if (reader.peek_type() != msgpack_reader::value_type::array
+                            || reader.read_array_header() != 2)
+                        {
+                            throw function_mismatch("njson expected type: [key, value]");
+                        }
+
+                        auto key = read_arg<key_t>(reader);
+                        detail::emplace_assoc(
+                            container, std::move(key), read_arg<mapped_t>(reader));
+                    }
+                }
+
+                return container;
+            }
+            else if constexpr (detail::is_set_v<no_ref_t>)
+            {
+                const auto size = reader.read_array_header();
+                no_ref_t container{};
+                detail::reserve_if_able(container, size);
+
+                for (size_t i = 0; i < size; ++i)
+                {
+                    detail::emplace_assoc(
+                        container, read_arg<typename no_ref_t::value_type>(reader));
+                }
+
+                return container;
+            }
+            else if constexpr (detail::is_byte_container_v<no_ref_t>)
+            {
+                return read_bulk<no_ref_t>(reader);
+            }
+            else if constexpr (detail::is_fixed_extent_v<no_ref_t>)
+            {
+                using value_t = typename no_ref_t::value_type;
+
+                detail::check_extent<no_ref_t>(reader.read_array_header());
+                no_ref_t container{};
+
+                for (auto& val : container)
+                {
+                    val = read_arg<value_t>(reader);
+                }
+
+                return container;
+            }
+            else if constexpr (detail::is_container_v<no_ref_t>)
+            {
+                using value_t = typename no_ref_t::value_type;
+
+                const auto size = reader.read_array_header();
+                no_ref_t container{};
+                container.reserve(size);
+
+                for (size_t i = 0; i < size; ++i)
+                {
+                    container.push_back(read_arg<value_t>(reader));
+                }
+
+                return container;
+            }
+            else if constexpr (detail::is_tuple_v<no_ref_t>)
+            {
+                const auto size = reader.read_array_header();
+                unsigned arg_counter = 0;
+                no_ref_t container{};
+
+                detail::for_each_tuple(container,
+                    [&reader, size, &arg_counter](auto& val)
+                    { val = read_args<decltype(val)>(reader, size, arg_counter); });
+
+                for (size_t i = arg_counter; i < size; ++i)
+                {
+                    reader.skip();
+                }
+
+                return container;
+            }
+            else if constexpr (detail::is_serializable_v<basic_njson_adapter, no_ref_t>)
+            {
+                return no_ref_t::template deserialize<basic_njson_adapter>(read_json(reader));
+            }
+            else if constexpr (detail::is_reflected_v<no_ref_t>)
+            {
+                no_ref_t val{};
+                std::array<bool, detail::field_count_v<no_ref_t>> found{};
+                const auto num_fields = reader.read_map_header();
+
+                // Fields may arrive in any order, unknown ones are skipped
+                for (size_t i = 0; i < num_fields; ++i)
+                {
+                    const auto key = reader.read_string();
+                    size_t index = 0;
+                    bool matched = false;
+
+                    detail::for_each_field(val,
+                        [&reader, key, &found, &index, &matched](
+                            const std::string_view name, auto& field)
+                        {
+                            if (!matched && name == key)
+                            {
+                                field = read_arg<std::remove_reference_t<decltype(field)>>(reader);
+                                found[index] = true;
+                                matched = true;
+                            }
+
+                            ++index;
+                        });
+
+                    if (!matched)
+                    {
+                        reader.skip();
+                    }
+                }
+
+                for (size_t i = 0; i < found.size(); ++i)
+                {
+                    if (!found[i])
+                    {
+                        throw function_mismatch("njson missing field: "
+                            + std::string{ detail::field_names_v<no_ref_t>[i] });
+                    }
+                }
+
+                return val;
+            }
+            else
+            {
+                return deserialize<no_ref_t>(read_json(reader));
+            }
+        }
+
+        // A null result is only a value for std::optional
+        template<typename R, typename... Args>
+        static void read_result(msgpack_reader& reader, detail::streamed_pack<R, Args...>& fields)
+        {
+            if constexpr (std::is_void_v<R>)
+            {
+                reader.skip();
+            }
+            else if (!detail::is_optional_v<R>
+                && reader.peek_type() == msgpack_reader::value_type::nil)
+            {
+                reader.skip();
+            }
+            else
+            {
+                fields.result = read_arg<R>(reader);
+            }
+        }
+
+        // Reads a message written as a compact envelope (see detail::compact_envelope)
+        template<typename R, typename... Args>
+        static void read_compact(msgpack_reader& reader, detail::streamed_pack<R, Args...>& fields)
+        {
+            using envelope = detail::compact_envelope;
+
+            const auto num_fields = reader.read_array_header();
+
+            if (num_fields < envelope::args_index || reader.read_int<int>() != envelope::version)
+            {
+                throw deserialization_error("njson: invalid compact envelope");
+            }
+
+            const bool has_error = envelope::has_error(reader.read_int<unsigned>());
+            fields.func_name = reader.read_string();
+
+            if (has_error)
+            {
+                if (reader.read_array_header() != 2)
+                {
+                    throw deserialization_error("njson: invalid compact envelope");
+                }
+
+                fields.except_type = static_cast<exception_type>(reader.read_int<int>());
+                fields.err_mesg = reader.read_string();
+
+                // Replies that only report an error can omit the arguments
+                if (num_fields == envelope::args_index)
+                {
+                    return;
+                }
+            }
+            else
+            {
+                read_result(reader, fields);
+            }
+
+            const size_t arg_count = num_fields - envelope::args_index;
+            [[maybe_unused]] unsigned arg_counter = 0;
+
+            fields.args = typename detail::packed_func<R, Args...>::args_t{ read_args<Args>(
+                reader, arg_count, arg_counter)... };
+
+            for (size_t i = sizeof...(Args); i < arg_count; ++i)
+            {
+                reader.skip();
+            }
+        }
+
+        // nodiscard because parsing can be expensive, and it makes no sense to not use the parsed result
+        template<typename C>
+        [[nodiscard]] static C read_bulk(msgpack_reader& reader)
+        {
+            const auto data = reader.read_binary();
+
+            if (data.subtype != detail::bulk_type_tag_v<typename C::value_type>)
+            {
+                throw function_mismatch(
+                    std::string{ "njson expected binary data of type: " } + typeid(C).name());
+            }
+
+            C container{};
+            auto* const out = detail::resize_bulk(container, data.bytes.size());
+
+            if (!data.bytes.empty())
+            {
+                std::memcpy(out, data.bytes.data(), data.bytes.size());
+            }
+
+            return container;
+        }
+
+        // Parses the next value into a nlohmann::json, for types only readable from one
+        [[nodiscard]] static nlohmann::json read_json(msgpack_reader& reader)
+        {
+            auto end_reader = reader;
+            end_reader.skip();
+
+            const auto raw = reader.read_raw(end_reader.position() - reader.position());
+            return nlohmann::json::from_msgpack(raw.begin(), raw.end());
+        }
+
+        // nodiscard because parsing can be expensive, and it makes no sense to not use the parsed result
+        template<typename T>
+        [[nodiscard]] static std::remove_cv_t<std::remove_reference_t<T>> read_args(
+            msgpack_reader& reader, const size_t arg_count, unsigned& index)
+        {
+            if (index >= arg_count)
+            {
+                throw function_mismatch("Argument count mismatch");
+            }
+
+            ++index;
+            return read_arg<T>(reader);
+        }
     };
 } // namespace adapters
 } // namespace rpc_hpp
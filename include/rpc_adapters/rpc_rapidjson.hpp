@@ -37,13 +37,98 @@
 #pragma once
 
 #include "../rpc.hpp"
+#include "rpc_json_reader.hpp"
 
 #include <rapidjson/document.h>
-#include <rapidjson/stringbuffer.h>
 #include <rapidjson/writer.h>
 
+#include <algorithm>
+#include <array>
+
+#if !defined(RPC_HPP_RAPIDJSON_ARENA_SIZE)
+#  define RPC_HPP_RAPIDJSON_ARENA_SIZE 65536
+#endif
+
 namespace rpc_hpp
 {
+namespace detail
+{
+    // Per-thread memory pool shared by the documents of a request, reset when the outermost request
+    // scope ends so that its buffer is reused instead of allocating new chunks for every document
+    class rapidjson_arena
+    {
+    public:
+        class scope
+        {
+        public:
+            scope() noexcept { ++get_state().depth; }
+
+            scope(const scope&) = delete;
+            scope& operator=(const scope&) = delete;
+
+            ~scope() noexcept
+            {
+                auto& state = get_state();
+
+                if (--state.depth == 0)
+                {
+                    state.allocator.Clear();
+                }
+            }
+        };
+
+        // Outside of a request scope documents own their allocator, as they may outlive the request
+        [[nodiscard]] static rapidjson::MemoryPoolAllocator<>* allocator() noexcept
+        {
+            auto& state = get_state();
+            return state.depth == 0 ? nullptr : &state.allocator;
+        }
+
+    private:
+        struct state_t
+        {
+            alignas(std::max_align_t) std::array<char, RPC_HPP_RAPIDJSON_ARENA_SIZE> buffer{};
+            rapidjson::MemoryPoolAllocator<> allocator{ buffer.data(), buffer.size() };
+            unsigned depth{ 0 };
+        };
+
+        [[nodiscard]] static state_t& get_state() noexcept
+        {
+            thread_local state_t state{};
+            return state;
+        }
+    };
+
+    // Output stream for rapidjson::Writer that appends straight to the output std::string
+    class rapidjson_string_stream
+    {
+    public:
+        using Ch = char;
+
+        explicit rapidjson_string_stream(std::string& str) noexcept : m_str(str) {}
+
+        void Put(const char c) { m_str.push_back(c); }
+        void Flush() noexcept {}
+
+        void Reserve(const size_t count)
+        {
+            if (m_str.capacity() - m_str.size() < count)
+            {
+                m_str.reserve(std::max(m_str.size() + count, 2 * m_str.capacity()));
+            }
+        }
+
+    private:
+        std::string& m_str;
+    };
+
+    // Found by ADL from rapidjson::Writer, replacing its no-op default
+    inline void PutReserve(rapidjson_string_stream& stream, const size_t count)
+    {
+        stream.Reserve(count);
+    }
+} // namespace detail
+
 namespace adapters
 {
     class rapidjson_adapter;
@@ -58,25 +143,53 @@ namespace adapters
     class rapidjson_adapter : public detail::serial_adapter_base<rapidjson_adapter>
     {
     public:
+        ///@brief While alive, documents on this thread allocate from a reused per-thread arena
+        using request_scope = detail::rapidjson_arena::scope;
+
         [[nodiscard]] static std::string to_bytes(rapidjson::Document&& serial_obj)
         {
-            rapidjson::StringBuffer buffer{};
-            rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+            std::string bytes{};
+            to_bytes(std::move(serial_obj), bytes);
+            return bytes;
+        }
+
+        ///@brief Writes the document into out (replacing its contents), reusing its capacity
+        static void to_bytes(rapidjson::Document&& serial_obj, std::string& out)
+        {
+            out.clear();
+            detail::rapidjson_string_stream stream{ out };
+            rapidjson::Writer<detail::rapidjson_string_stream, rapidjson::UTF8<>, rapidjson::UTF8<>,
+                rapidjson::MemoryPoolAllocator<>>
+                writer(stream, detail::rapidjson_arena::allocator());
             std::move(serial_obj).Accept(writer);
-            return buffer.GetString();
         }
 
+        ///@brief Whether a message in this format can start with byte (lets multi_server recognize the format)
+        [[nodiscard]] static constexpr bool may_start_with(const uint8_t byte) noexcept
+        {
+            return detail::is_json_text_start(byte);
+        }
+
+        ///@brief Parses bytes in place, without copying its strings into the document
+        ///
+        ///@note The returned document refers to the storage of bytes (which is modified), so the
+        ///caller must keep bytes alive and unchanged while the document is in use. Both
+        ///server::dispatch and the client's response handling do this
         [[nodiscard]] static std::optional<rapidjson::Document> from_bytes(std::string&& bytes)
         {
-            rapidjson::Document d{};
-            d.SetObject();
-            d.Parse(std::move(bytes).c_str());
+            rapidjson::Document d{ detail::rapidjson_arena::allocator() };
+            d.ParseInsitu(bytes.data());
 
             if (d.HasParseError())
             {
                 return std::nullopt;
             }
 
+            if (d.IsArray())
+            {
+                return is_compact_message(d) ? std::make_optional(std::move(d)) : std::nullopt;
+            }
+
             if (const auto ex_it = d.FindMember("except_type"); ex_it != d.MemberEnd())
             {
                 if (const auto& ex_val = ex_it->value;
@@ -106,8 +219,22 @@ namespace adapters
 
         static rapidjson::Document empty_object()
         {
-            rapidjson::Document d{};
-            d.SetObject();
+            rapidjson::Document d{ detail::rapidjson_arena::allocator() };
+
+            if constexpr (use_compact_envelope)
+            {
+                auto& alloc = d.GetAllocator();
+                d.SetArray();
+                d.PushBack(detail::compact_envelope::version, alloc);
+                d.PushBack(0U, alloc);
+                d.PushBack(rapidjson::StringRef(""), alloc);
+                d.PushBack(rapidjson::Value{}, alloc);
+            }
+            else
+            {
+                d.SetObject();
+            }
+
             return d;
         }
 
@@ -115,7 +242,12 @@ namespace adapters
         [[nodiscard]] static rapidjson::Document serialize_pack(
             const detail::packed_func<R, Args...>& pack)
         {
-            rapidjson::Document d{};
+            if constexpr (use_compact_envelope)
+            {
+                return serialize_compact(pack);
+            }
+
+            rapidjson::Document d{ detail::rapidjson_arena::allocator() };
             auto& alloc = d.GetAllocator();
             d.SetObject();
             d.AddMember("func_name",
@@ -127,36 +259,7 @@ namespace adapters
 
                 if (pack)
                 {
-                    if constexpr (std::is_arithmetic_v<R>)
-                    {
-                        result.Set<R>(pack.get_result());
-                    }
-                    else if constexpr (std::is_same_v<R, std::string>)
-                    {
-                        result.SetString(pack.get_result().c_str(), alloc);
-                    }
-                    else if constexpr (rpc_hpp::detail::is_container_v<R>)
-                    {
-                        const auto& container = pack.get_result();
-                        result.SetArray();
-                        result.Reserve(static_cast<rapidjson::SizeType>(container.size()), alloc);
-
-                        for (const auto& val : container)
-                        {
-                            result.PushBack(val, alloc);
-                        }
-                    }
-                    else if constexpr (rpc_hpp::detail::is_serializable_v<rapidjson_adapter, R>)
-                    {
-                        const rapidjson::Document tmp =
-                            R::template serialize<rapidjson_adapter>(pack.get_result());
-
-                        result.CopyFrom(tmp, alloc);
-                    }
-                    else
-                    {
-                        result = serialize<R>(pack.get_result(), alloc);
-                    }
+                    push_arg(pack.get_result(), result, alloc);
                 }
 
                 d.AddMember("result", result, alloc);
@@ -177,6 +280,11 @@ namespace adapters
         [[nodiscard]] static detail::packed_func<R, Args...> deserialize_pack(
             const rapidjson::Document& serial_obj)
         {
+            if (serial_obj.IsArray())
+            {
+                return deserialize_compact<R, Args...>(serial_obj);
+            }
+
             const auto& args_val = serial_obj["args"];
             [[maybe_unused]] unsigned arg_counter = 0;
             typename detail::packed_func<R, Args...>::args_t args{ parse_args<Args>(
@@ -197,7 +305,10 @@ namespace adapters
             }
             else
             {
-                if (serial_obj.HasMember("result") && !serial_obj["result"].IsNull())
+                // A null result is a valid value for std::optional
+                if (serial_obj.HasMember("result")
+                    && (detail::is_optional_v<R> ? !serial_obj.HasMember("except_type")
+                                                 : !serial_obj["result"].IsNull()))
                 {
                     const rapidjson::Value& result = serial_obj["result"];
                     return detail::packed_func<R, Args...>(
@@ -217,13 +328,39 @@ namespace adapters
             }
         }
 
+        [[nodiscard]] static std::optional<std::string> peek_func_name(const std::string& bytes)
+        {
+            return detail::json_text_parser<rapidjson_adapter>::peek_func_name(bytes);
+        }
+
+        ///@brief Parses a message straight into a packed_func, without building a document
+        template<typename R, typename... Args>
+        [[nodiscard]] static detail::packed_func<R, Args...> parse_pack(const std::string& bytes)
+        {
+            return detail::json_text_parser<rapidjson_adapter>::template parse_pack<R, Args...>(
+                bytes);
+        }
+
         [[nodiscard]] static std::string get_func_name(const rapidjson::Document& serial_obj)
         {
+            if (serial_obj.IsArray())
+            {
+                return serial_obj[detail::compact_envelope::func_name_index].GetString();
+            }
+
             return serial_obj["func_name"].GetString();
         }
 
         [[nodiscard]] static rpc_exception extract_exception(const rapidjson::Document& serial_obj)
         {
+            if (serial_obj.IsArray())
+            {
+                const auto& slot = serial_obj[detail::compact_envelope::result_index];
+
+                return rpc_exception{ slot[1].GetString(),
+                    static_cast<exception_type>(slot[0].GetInt()) };
+            }
+
             return rpc_exception{ serial_obj["err_mesg"].GetString(),
                 static_cast<exception_type>(serial_obj["except_type"].GetInt()) };
         }
@@ -232,6 +369,19 @@ namespace adapters
         {
             auto& alloc = serial_obj.GetAllocator();
 
+            if (serial_obj.IsArray())
+            {
+                // The error replaces the result
+                auto& flags = serial_obj[detail::compact_envelope::flags_index];
+                flags.SetUint(flags.GetUint() | detail::compact_envelope::error_flag);
+
+                auto& slot = serial_obj[detail::compact_envelope::result_index];
+                slot.SetArray();
+                slot.PushBack(static_cast<int>(ex.get_type()), alloc);
+                slot.PushBack(rapidjson::Value{}.SetString(ex.what(), alloc), alloc);
+                return;
+            }
+
             if (const auto ex_it = serial_obj.FindMember("except_type");
                 ex_it != serial_obj.MemberEnd())
             {
@@ -254,6 +404,131 @@ namespace adapters
         static T deserialize(const rapidjson::Value& serial_obj) = delete;
 
     private:
+        friend class detail::json_text_parser<rapidjson_adapter>;
+
+        // Numeric containers are sent as base64 strings holding their raw (host order) bytes.
+        // Decoding accepts both forms regardless of this setting
+#if defined(RPC_HPP_RAPIDJSON_BINARY_ARRAYS)
+        static constexpr bool use_binary_arrays = true;
+#else
+        static constexpr bool use_binary_arrays = false;
+#endif
+
+        // Messages are written as a positional array (see detail::compact_envelope) instead of an
+        // object with named fields. Decoding accepts both forms regardless of this setting
+#if defined(RPC_HPP_RAPIDJSON_COMPACT_ENVELOPE)
+        static constexpr bool use_compact_envelope = true;
+#else
+        static constexpr bool use_compact_envelope = false;
+#endif
+
+        // Checks the fixed fields of a compact envelope
+        [[nodiscard]] static bool is_compact_message(const rapidjson::Value& arr)
+        {
+            using envelope = detail::compact_envelope;
+
+            if (arr.Size() < envelope::args_index)
+            {
+                return false;
+            }
+
+            const auto& version = arr[envelope::version_index];
+            const auto& flags = arr[envelope::flags_index];
+            const auto& func_name = arr[envelope::func_name_index];
+
+            if (!version.IsInt() || version.GetInt() != envelope::version || !flags.IsUint()
+                || !func_name.IsString())
+            {
+                return false;
+            }
+
+            if (envelope::has_error(flags.GetUint()))
+            {
+                const auto& slot = arr[envelope::result_index];
+
+                return slot.IsArray() && slot.Size() == 2 && slot[0].IsInt() && slot[1].IsString();
+            }
+
+            return func_name.GetStringLength() != 0;
+        }
+
+        template<typename R, typename... Args>
+        [[nodiscard]] static rapidjson::Document serialize_compact(
+            const detail::packed_func<R, Args...>& pack)
+        {
+            using envelope = detail::compact_envelope;
+
+            const bool has_error = pack.get_except_type() != exception_type::none;
+            rapidjson::Document d{ detail::rapidjson_arena::allocator() };
+            auto& alloc = d.GetAllocator();
+            d.SetArray();
+            d.Reserve(
+                static_cast<rapidjson::SizeType>(envelope::args_index + sizeof...(Args)), alloc);
+            d.PushBack(envelope::version, alloc);
+            d.PushBack(has_error ? envelope::error_flag : 0U, alloc);
+            d.PushBack(rapidjson::Value{}.SetString(pack.get_func_name().c_str(), alloc), alloc);
+
+            rapidjson::Value slot{};
+
+            if (has_error)
+            {
+                slot.SetArray();
+                slot.PushBack(static_cast<int>(pack.get_except_type()), alloc);
+                slot.PushBack(
+                    rapidjson::Value{}.SetString(pack.get_err_mesg().c_str(), alloc), alloc);
+            }
+            else if constexpr (!std::is_void_v<R>)
+            {
+                if (pack)
+                {
+                    push_arg(pack.get_result(), slot, alloc);
+                }
+            }
+
+            d.PushBack(slot, alloc);
+            detail::for_each_tuple(pack.get_args(),
+                [&d, &alloc](auto&& elem)
+                { push_args(std::forward<decltype(elem)>(elem), d, alloc); });
+
+            return d;
+        }
+
+        template<typename R, typename... Args>
+        [[nodiscard]] static detail::packed_func<R, Args...> deserialize_compact(
+            const rapidjson::Document& serial_obj)
+        {
+            using envelope = detail::compact_envelope;
+
+            detail::streamed_pack<R, Args...> fields{};
+            fields.func_name = serial_obj[envelope::func_name_index].GetString();
+            const auto& slot = serial_obj[envelope::result_index];
+
+            if (envelope::has_error(serial_obj[envelope::flags_index].GetUint()))
+            {
+                fields.except_type = static_cast<exception_type>(slot[0].GetInt());
+                fields.err_mesg = slot[1].GetString();
+
+                if (serial_obj.Size() == envelope::args_index)
+                {
+                    return std::move(fields).finish();
+                }
+            }
+            else if constexpr (!std::is_void_v<R>)
+            {
+                // A null result is a valid value for std::optional
+                if (detail::is_optional_v<R> || !slot.IsNull())
+                {
+                    fields.result = parse_arg<R>(slot);
+                }
+            }
+
+            [[maybe_unused]] unsigned arg_counter = envelope::args_index;
+            fields.args = typename detail::packed_func<R, Args...>::args_t{ parse_args<Args>(
+                serial_obj, arg_counter)... };
+
+            return std::move(fields).finish();
+        }
+
         // nodiscard because this function is pointless without checking the bool
         template<typename T>
         [[nodiscard]] static constexpr bool validate_arg(const rapidjson::Value& arg) noexcept
@@ -299,10 +574,35 @@ namespace adapters
             {
                 return arg.IsString();
             }
+            else if constexpr (rpc_hpp::detail::is_optional_v<T>)
+            {
+                // null or the contained value, which is validated when parsed
+                return true;
+            }
+            else if constexpr (rpc_hpp::detail::is_variant_v<T>)
+            {
+                return arg.IsArray() && arg.Size() == 2 && arg.GetArray()[0].IsUint();
+            }
+            else if constexpr (rpc_hpp::detail::is_string_map_v<T>)
+            {
+                return arg.IsObject();
+            }
+            else if constexpr (rpc_hpp::detail::is_byte_container_v<T>)
+            {
+                return arg.IsString();
+            }
+            else if constexpr (rpc_hpp::detail::is_bulk_container_v<T>)
+            {
+                return arg.IsArray() || arg.IsString();
+            }
             else if constexpr (rpc_hpp::detail::is_container_v<T>)
             {
                 return arg.IsArray();
             }
+            else if constexpr (rpc_hpp::detail::is_reflected_v<T>)
+            {
+                return arg.IsObject();
+            }
             else
             {
                 return !arg.IsNull();
@@ -406,6 +706,69 @@ namespace adapters
                     obj.Set<no_ref_t>(arg);
                 }
             }
+            else if constexpr (rpc_hpp::detail::is_optional_v<no_ref_t>)
+            {
+                if (arg.has_value())
+                {
+                    push_arg(*arg, obj, alloc);
+                }
+                else
+                {
+                    obj.SetNull();
+                }
+            }
+            else if constexpr (rpc_hpp::detail::is_variant_v<no_ref_t>)
+            {
+                // Encoded as [index, value]
+                obj.SetArray();
+                obj.Reserve(2, alloc);
+                obj.PushBack(
+                    rapidjson::Value{}.SetUint(static_cast<unsigned>(arg.index())), alloc);
+
+                std::visit([&obj, &alloc](const auto& val) { push_args(val, obj, alloc); }, arg);
+            }
+            else if constexpr (rpc_hpp::detail::is_string_map_v<no_ref_t>)
+            {
+                obj.SetObject();
+                obj.MemberReserve(static_cast<rapidjson::SizeType>(arg.size()), alloc);
+
+                for (const auto& [key, val] : arg)
+                {
+                    rapidjson::Value name{};
+                    name.SetString(
+                        key.c_str(), static_cast<rapidjson::SizeType>(key.size()), alloc);
+                    rapidjson::Value tmp{};
+                    push_arg(val, tmp, alloc);
+                    obj.AddMember(name, tmp, alloc);
+                }
+            }
+            else if constexpr (rpc_hpp::detail::is_map_v<no_ref_t>)
+            {
+                // Non-string keys are encoded as an array of [key, value] pairs
+                obj.SetArray();
+                obj.Reserve(static_cast<rapidjson::SizeType>(arg.size()), alloc);
+
+                for (const auto& [key, val] : arg)
+                {
+                    rapidjson::Value pair{ rapidjson::kArrayType };
+                    pair.Reserve(2, alloc);
+                    push_args(key, pair, alloc);
+                    push_args(val, pair, alloc);
+                    obj.PushBack(pair, alloc);
+                }
+            }
+            else if constexpr ((use_binary_arrays && rpc_hpp::detail::is_bulk_container_v<no_ref_t>)
+                || rpc_hpp::detail::is_byte_container_v<no_ref_t>)
+            {
+                const auto byte_size = arg.size() * sizeof(typename no_ref_t::value_type);
+                const auto text_size = rpc_hpp::detail::base64_encoded_size(byte_size);
+
+                // Encoded straight into the document's allocator, then referenced without a copy
+                auto* const text = static_cast<char*>(alloc.Malloc(text_size));
+                rpc_hpp::detail::base64_encode(arg.data(), byte_size, text);
+                obj.SetString(
+                    rapidjson::StringRef(text, static_cast<rapidjson::SizeType>(text_size)));
+            }
             else if constexpr (rpc_hpp::detail::is_container_v<no_ref_t>)
             {
                 obj.SetArray();
@@ -423,6 +786,24 @@ namespace adapters
 
                 obj.CopyFrom(serialized, alloc);
             }
+            else if constexpr (rpc_hpp::detail::is_reflected_v<no_ref_t>)
+            {
+                obj.SetObject();
+                obj.MemberReserve(
+                    static_cast<rapidjson::SizeType>(rpc_hpp::detail::field_count_v<no_ref_t>),
+                    alloc);
+
+                // Field names are string literals, so they can be referenced rather than copied
+                rpc_hpp::detail::for_each_field(arg,
+                    [&obj, &alloc](const std::string_view name, const auto& field)
+                    {
+                        rapidjson::Value field_val{};
+                        push_arg(field, field_val, alloc);
+                        obj.AddMember(rapidjson::StringRef(name.data(),
+                                          static_cast<rapidjson::SizeType>(name.size())),
+                            field_val, alloc);
+                    });
+            }
             else
             {
                 obj = serialize<no_ref_t>(std::forward<T>(arg), alloc);
@@ -450,6 +831,14 @@ namespace adapters
                 throw function_mismatch(mismatch_message(typeid(no_ref_t).name(), arg));
             }
 
+            if constexpr (rpc_hpp::detail::is_bulk_container_v<no_ref_t>)
+            {
+                if (arg.IsString())
+                {
+                    return parse_bulk<no_ref_t>(arg);
+                }
+            }
+
             if constexpr (std::is_same_v<no_ref_t, std::string>)
             {
                 return arg.GetString();
@@ -473,33 +862,163 @@ namespace adapters
                     return arg.Get<no_ref_t>();
                 }
             }
+            else if constexpr (rpc_hpp::detail::is_optional_v<no_ref_t>)
+            {
+                if (arg.IsNull())
+                {
+                    return std::nullopt;
+                }
+
+                return parse_arg<typename no_ref_t::value_type>(arg);
+            }
+            else if constexpr (rpc_hpp::detail::is_variant_v<no_ref_t>)
+            {
+                const auto arr = arg.GetArray();
+                const auto& val = arr[1];
+
+                return rpc_hpp::detail::make_variant<no_ref_t>(arr[0].GetUint(),
+                    [&val](auto tag) { return parse_arg<typename decltype(tag)::type>(val); });
+            }
+            else if constexpr (rpc_hpp::detail::is_string_map_v<no_ref_t>)
+            {
+                no_ref_t container{};
+                rpc_hpp::detail::reserve_if_able(container, arg.MemberCount());
+
+                for (const auto& member : arg.GetObject())
+                {
+                    rpc_hpp::detail::emplace_assoc(container,
+                        std::string{ member.name.GetString(), member.name.GetStringLength() },
+                        parse_arg<typename no_ref_t::mapped_type>(member.value));
+                }
+
+                return container;
+            }
+            else if constexpr (rpc_hpp::detail::is_map_v<no_ref_t>)
+            {
+                no_ref_t container{};
+                rpc_hpp::detail::reserve_if_able(container, arg.Size());
+
+                for (const auto& pair : arg.GetArray())
+                {
+                    if (!pair.IsArray() || pair.Size() != 2)
+                    {
+                        throw function_mismatch(mismatch_message("[key, value]", pair));
+                    }
+
+                    const auto key_val = pair.GetArray();
+
+                    rpc_hpp::detail::emplace_assoc(container,
+                        parse_arg<typename no_ref_t::key_type>(key_val[0]),
+                        parse_arg<typename no_ref_t::mapped_type>(key_val[1]));
+                }
+
+                return container;
+            }
+            else if constexpr (rpc_hpp::detail::is_set_v<no_ref_t>)
+            {
+                no_ref_t container{};
+                rpc_hpp::detail::reserve_if_able(container, arg.Size());
+
+                for (const auto& val : arg.GetArray())
+                {
+                    rpc_hpp::detail::emplace_assoc(
+                        container, parse_arg<typename no_ref_t::value_type>(val));
+                }
+
+                return container;
+            }
+            else if constexpr (rpc_hpp::detail::is_byte_container_v<no_ref_t>)
+            {
+                return parse_bulk<no_ref_t>(arg);
+            }
+            else if constexpr (rpc_hpp::detail::is_fixed_extent_v<no_ref_t>)
+            {
+                using subvalue_t = typename no_ref_t::value_type;
+
+                rpc_hpp::detail::check_extent<no_ref_t>(arg.Size());
+                const auto arr = arg.GetArray();
+                no_ref_t container{};
+
+                for (rapidjson::SizeType i = 0; i < container.size(); ++i)
+                {
+                    container[i] = parse_arg<subvalue_t>(arr[i]);
+                }
+
+                return container;
+            }
             else if constexpr (rpc_hpp::detail::is_container_v<no_ref_t>)
             {
                 using subvalue_t = typename no_ref_t::value_type;
 
                 no_ref_t container{};
                 container.reserve(arg.Size());
-                unsigned arg_counter = 0;
 
                 for (const auto& val : arg.GetArray())
                 {
-                    container.push_back(parse_args<subvalue_t>(val, arg_counter));
+                    container.push_back(parse_arg<subvalue_t>(val));
                 }
 
                 return container;
             }
             else if constexpr (rpc_hpp::detail::is_serializable_v<rapidjson_adapter, no_ref_t>)
             {
-                rapidjson::Document d{};
+                rapidjson::Document d{ rpc_hpp::detail::rapidjson_arena::allocator() };
                 d.CopyFrom(arg, d.GetAllocator());
                 return no_ref_t::template deserialize<rapidjson_adapter>(d);
             }
+            else if constexpr (rpc_hpp::detail::is_reflected_v<no_ref_t>)
+            {
+                no_ref_t val{};
+
+                rpc_hpp::detail::for_each_field(val,
+                    [&arg](const std::string_view name, auto& field)
+                    {
+                        const rapidjson::Value key{ rapidjson::StringRef(
+                            name.data(), static_cast<rapidjson::SizeType>(name.size())) };
+
+                        const auto field_it = arg.FindMember(key);
+
+                        if (field_it == arg.MemberEnd())
+                        {
+                            throw function_mismatch(
+                                "rapidjson missing field: " + std::string{ name });
+                        }
+
+                        field = parse_arg<std::remove_reference_t<decltype(field)>>(
+                            field_it->value);
+                    });
+
+                return val;
+            }
             else
             {
                 return deserialize<no_ref_t>(arg);
             }
         }
 
+        // nodiscard because parsing can be expensive, and it makes no sense to not use the parsed result
+        template<typename C>
+        [[nodiscard]] static C parse_bulk(const rapidjson::Value& arg)
+        {
+            const std::string_view text{ arg.GetString(), arg.GetStringLength() };
+            const auto byte_size = rpc_hpp::detail::base64_decoded_size(text);
+
+            if (!byte_size.has_value())
+            {
+                throw function_mismatch(mismatch_message(typeid(C).name(), arg));
+            }
+
+            C container{};
+
+            if (!rpc_hpp::detail::base64_decode(
+                    text, rpc_hpp::detail::resize_bulk(container, *byte_size)))
+            {
+                throw function_mismatch(mismatch_message(typeid(C).name(), arg));
+            }
+
+            return container;
+        }
+
         // nodiscard because parsing can be expensive, and it makes no sense to not use the parsed result
         template<typename T>
         [[nodiscard]] static std::remove_cv_t<std::remove_reference_t<T>> parse_args(
@@ -519,6 +1038,21 @@ namespace adapters
 
             return parse_arg<T>(arr[index++]);
         }
+
+        // Parses the text of a single value, for types only readable from a document
+        template<typename T>
+        [[nodiscard]] static T parse_text(const std::string_view text)
+        {
+            rapidjson::Document d{ detail::rapidjson_arena::allocator() };
+            d.Parse(text.data(), text.size());
+
+            if (d.HasParseError())
+            {
+                throw deserialization_error("rapidjson: could not parse value");
+            }
+
+            return parse_arg<T>(d);
+        }
     };
 } // namespace adapters
 } // namespace rpc_hpp
@@ -0,0 +1,537 @@
+///@file rpc_adapters/rpc_raw.hpp
+///@author Jackson Harmer (jharmer95@gmail.com)
+///@brief Implementation of a raw binary adapter for functions with only trivially copyable types
+///
+///@copyright
+///BSD 3-Clause License
+///
+///Copyright (c) 2020-2022, Jackson Harmer
+///All rights reserved.
+///
+///Redistribution and use in source and binary forms, with or without
+///modification, are permitted provided that the following conditions are met:
+///
+///1. Redistributions of source code must retain the above copyright notice, this
+///   list of conditions and the following disclaimer.
+///
+///2. Redistributions in binary form must reproduce the above copyright notice,
+///   this list of conditions and the following disclaimer in the documentation
+///   and/or other materials provided with the distribution.
+///
+///3. Neither the name of the copyright holder nor the names of its
+///   contributors may be used to endorse or promote products derived from
+///   this software without specific prior written permission.
+///
+///THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+///AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+///IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+///DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+///FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+///DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+///SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+///CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+///OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+///OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+///
+
+
+#pragma once
+
+#include "../rpc.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+namespace rpc_hpp
+{
+namespace adapters
+{
+#if defined(RPC_HPP_RAW_BUFFER_SIZE)
+    inline constexpr size_t raw_buffer_size = RPC_HPP_RAW_BUFFER_SIZE;
+#else
+    inline constexpr size_t raw_buffer_size = 256;
+#endif
+
+    ///@brief Fixed-capacity byte buffer that lives entirely on the stack
+    ///
+    ///@details Behaves like a contiguous byte container holding only the bytes in use (so
+    /// @ref size and @ref end cover the message, not the whole capacity)
+    ///@tparam N Capacity, in bytes
+    template<size_t N>
+    class raw_buffer
+    {
+    public:
+        using value_type = uint8_t;
+        using iterator = typename std::array<uint8_t, N>::iterator;
+        using const_iterator = typename std::array<uint8_t, N>::const_iterator;
+
+        raw_buffer() noexcept = default;
+
+        ///@brief Copies a received message into the buffer
+        ///
+        ///@note Messages that do not fit are truncated and flagged, so they can be rejected
+        template<typename InputIt>
+        raw_buffer(InputIt first, InputIt last) noexcept
+        {
+            for (; first != last; ++first)
+            {
+                if (m_size == N)
+                {
+                    m_overflow = true;
+                    break;
+                }
+
+                m_data[m_size++] = static_cast<uint8_t>(*first);
+            }
+        }
+
+        [[nodiscard]] constexpr size_t size() const noexcept { return m_size; }
+        [[nodiscard]] constexpr bool empty() const noexcept { return m_size == 0; }
+        [[nodiscard]] static constexpr size_t capacity() noexcept { return N; }
+        [[nodiscard]] constexpr bool overflowed() const noexcept { return m_overflow; }
+
+        [[nodiscard]] uint8_t* data() noexcept { return m_data.data(); }
+        [[nodiscard]] const uint8_t* data() const noexcept { return m_data.data(); }
+
+        [[nodiscard]] uint8_t& operator[](const size_t idx) noexcept { return m_data[idx]; }
+
+        [[nodiscard]] const uint8_t& operator[](const size_t idx) const noexcept
+        {
+            return m_data[idx];
+        }
+
+        [[nodiscard]] iterator begin() noexcept { return m_data.begin(); }
+        [[nodiscard]] const_iterator begin() const noexcept { return m_data.begin(); }
+        [[nodiscard]] iterator end() noexcept { return m_data.begin() + m_size; }
+        [[nodiscard]] const_iterator end() const noexcept { return m_data.begin() + m_size; }
+
+        void resize(const size_t size)
+        {
+            if (size > N)
+            {
+                throw std::length_error("raw_buffer: size exceeds capacity");
+            }
+
+            m_size = size;
+        }
+
+    private:
+        std::array<uint8_t, N> m_data{};
+        size_t m_size{ 0 };
+        bool m_overflow{ false };
+    };
+
+    template<typename T>
+    inline constexpr bool is_raw_type_v =
+        std::is_trivially_copyable_v<T> && !std::is_pointer_v<T> && !std::is_member_pointer_v<T>;
+
+    ///@brief Whether every type of a signature can be passed through @ref raw_adapter
+    template<typename R, typename... Args>
+    inline constexpr bool is_raw_signature_v = (std::is_void_v<R> || is_raw_type_v<R>)
+        && (is_raw_type_v<std::remove_cv_t<std::remove_reference_t<Args>>> && ...);
+
+    class raw_adapter;
+
+    template<>
+    struct serial_traits<raw_adapter>
+    {
+        using serial_t = raw_buffer<raw_buffer_size>;
+        using bytes_t = raw_buffer<raw_buffer_size>;
+    };
+
+    ///@brief Adapter that copies trivially copyable arguments and results as-is
+    ///
+    ///@details The arguments are laid out like the members of a struct, after a small fixed header
+    /// and the function name. A signature hash catches mismatched argument and result types.
+    /// Values are stored in the native representation, so both ends must share the same ABI
+    class raw_adapter : public detail::serial_adapter_base<raw_adapter>
+    {
+    public:
+        using buffer_t = raw_buffer<raw_buffer_size>;
+
+        [[nodiscard]] static buffer_t to_bytes(buffer_t&& serial_obj) noexcept
+        {
+            return serial_obj;
+        }
+
+        [[nodiscard]] static std::optional<buffer_t> from_bytes(buffer_t&& bytes) noexcept
+        {
+            if (bytes.overflowed() || bytes.size() < sizeof(header))
+            {
+                return std::nullopt;
+            }
+
+            const auto head = read_header(bytes);
+
+            if (sizeof(header) + head.name_len + head.err_len > bytes.size())
+            {
+                return std::nullopt;
+            }
+
+            if (head.except_type != 0)
+            {
+                // Objects with exceptions can be otherwise empty
+                return std::make_optional(bytes);
+            }
+
+            if (head.name_len == 0)
+            {
+                return std::nullopt;
+            }
+
+            return std::make_optional(bytes);
+        }
+
+        static buffer_t empty_object() noexcept
+        {
+            buffer_t buffer{};
+            buffer.resize(sizeof(header));
+            write_header(buffer, header{});
+            return buffer;
+        }
+
+        template<typename R, typename... Args>
+        [[nodiscard]] static buffer_t serialize_pack(const detail::packed_func<R, Args...>& pack)
+        {
+            using layout = raw_layout<R, Args...>;
+            static_assert(args_offset(0) + layout::size <= raw_buffer_size,
+                "raw_adapter: signature does not fit in the buffer, increase "
+                "RPC_HPP_RAW_BUFFER_SIZE");
+
+            const auto& func_name = pack.get_func_name();
+
+            if (func_name.size() > std::numeric_limits<uint8_t>::max()
+                || args_offset(func_name.size()) + layout::size > raw_buffer_size)
+            {
+                throw serialization_error("raw_adapter: function name is too long");
+            }
+
+            header head{};
+            head.signature = layout::signature;
+            head.except_type = static_cast<int32_t>(pack.get_except_type());
+            head.name_len = static_cast<uint8_t>(func_name.size());
+
+            const size_t base = args_offset(head.name_len);
+            buffer_t buffer{};
+            buffer.resize(base + layout::args_size);
+            memcpy(buffer.data() + sizeof(header), func_name.data(), func_name.size());
+            write_args(buffer.data() + base, pack.get_args(), std::index_sequence_for<Args...>{});
+
+            if constexpr (!std::is_void_v<R>)
+            {
+                if (pack)
+                {
+                    head.has_result = 1;
+                    buffer.resize(base + layout::size);
+                    const R& result = pack.get_result();
+                    memcpy(buffer.data() + base + layout::result_offset, &result, sizeof(R));
+                }
+            }
+
+            write_header(buffer, head);
+            append_err_mesg(buffer, pack.get_err_mesg());
+            return buffer;
+        }
+
+        template<typename R, typename... Args>
+        [[nodiscard]] static detail::packed_func<R, Args...> deserialize_pack(
+            const buffer_t& serial_obj)
+        {
+            using layout = raw_layout<R, Args...>;
+
+            const auto head = read_header(serial_obj);
+            auto func_name = get_func_name(serial_obj);
+
+            if (head.except_type != 0)
+            {
+                return make_pack<R, Args...>(std::move(func_name),
+                    typename detail::packed_func<R, Args...>::args_t{},
+                    rpc_exception{ read_err_mesg(serial_obj, head),
+                        static_cast<exception_type>(head.except_type) });
+            }
+
+            const size_t base = args_offset(head.name_len);
+            const size_t expected_size = base + layout::args_size
+                + static_cast<size_t>(head.has_result != 0) * (layout::size - layout::args_size)
+                + head.err_len;
+
+            if (head.signature != layout::signature || serial_obj.size() != expected_size)
+            {
+                throw function_mismatch("raw_adapter: mismatched function signature");
+            }
+
+            auto args = read_args<typename detail::packed_func<R, Args...>::args_t>(
+                serial_obj.data() + base, std::index_sequence_for<Args...>{});
+
+            if constexpr (!std::is_void_v<R>)
+            {
+                if (head.has_result != 0)
+                {
+                    R result{};
+                    read_arg(serial_obj.data() + base + layout::result_offset, result);
+
+                    return detail::packed_func<R, Args...>(
+                        std::move(func_name), std::move(result), std::move(args));
+                }
+
+                return detail::packed_func<R, Args...>(
+                    std::move(func_name), std::nullopt, std::move(args));
+            }
+            else
+            {
+                return detail::packed_func<void, Args...>(std::move(func_name), std::move(args));
+            }
+        }
+
+        [[nodiscard]] static std::string get_func_name(const buffer_t& serial_obj)
+        {
+            const auto head = read_header(serial_obj);
+
+            return { reinterpret_cast<const char*>(serial_obj.data() + sizeof(header)),
+                head.name_len };
+        }
+
+        [[nodiscard]] static rpc_exception extract_exception(const buffer_t& serial_obj)
+        {
+            const auto head = read_header(serial_obj);
+            return rpc_exception{ read_err_mesg(serial_obj, head),
+                static_cast<exception_type>(head.except_type) };
+        }
+
+        // The error message is always stored last, so it is replaced without moving anything else
+        static void set_exception(buffer_t& serial_obj, const rpc_exception& ex)
+        {
+            auto head = read_header(serial_obj);
+            head.except_type = static_cast<int32_t>(ex.get_type());
+            serial_obj.resize(serial_obj.size() - head.err_len);
+            head.err_len = 0;
+            write_header(serial_obj, head);
+            append_err_mesg(serial_obj, ex.what());
+        }
+
+    private:
+        struct header
+        {
+            uint32_t signature{};
+            int32_t except_type{};
+            uint16_t err_len{};
+            uint8_t name_len{};
+            uint8_t has_result{};
+        };
+
+        static_assert(sizeof(header) == 12, "raw_adapter header must have no padding");
+
+        template<typename T>
+        using raw_t = std::remove_cv_t<std::remove_reference_t<T>>;
+
+        static constexpr uint32_t fnv_offset = 2'166'136'261U;
+        static constexpr uint32_t fnv_prime = 16'777'619U;
+
+        static constexpr size_t align_up(const size_t offset, const size_t alignment) noexcept
+        {
+            return (offset + alignment - 1) / alignment * alignment;
+        }
+
+        template<typename T>
+        static constexpr uint32_t type_code() noexcept
+        {
+            if constexpr (std::is_same_v<T, bool>)
+            {
+                return 1;
+            }
+            else if constexpr (std::is_floating_point_v<T>)
+            {
+                return 2;
+            }
+            else if constexpr (std::is_integral_v<T>)
+            {
+                return std::is_signed_v<T> ? 3 : 4;
+            }
+            else if constexpr (std::is_enum_v<T>)
+            {
+                return 5;
+            }
+            else
+            {
+                return 6;
+            }
+        }
+
+        template<typename T>
+        static constexpr uint32_t hash_type(const uint32_t hash) noexcept
+        {
+            return ((hash ^ type_code<T>()) * fnv_prime ^ static_cast<uint32_t>(sizeof(T)))
+                * fnv_prime;
+        }
+
+        // Offsets of each argument (and the result) as if they were members of a struct
+        template<typename R, typename... Args>
+        struct raw_layout
+        {
+            static_assert(is_raw_signature_v<R, Args...>,
+                "raw_adapter only supports trivially copyable arguments and results (so no strings, "
+                "containers, maps, or sets), use another adapter for this function");
+
+            static constexpr size_t count = sizeof...(Args);
+
+            static constexpr std::array<size_t, count + 1> offsets = []() noexcept
+            {
+                constexpr std::array<size_t, count + 1> sizes{ sizeof(raw_t<Args>)..., 0 };
+                constexpr std::array<size_t, count + 1> aligns{ alignof(raw_t<Args>)..., 1 };
+
+                std::array<size_t, count + 1> result{};
+                size_t offset = 0;
+
+                for (size_t i = 0; i < count; ++i)
+                {
+                    offset = align_up(offset, aligns[i]);
+                    result[i] = offset;
+                    offset += sizes[i];
+                }
+
+                result[count] = offset;
+                return result;
+            }();
+
+            static constexpr size_t args_size = offsets[count];
+
+            static constexpr size_t result_offset = []() noexcept
+            {
+                if constexpr (std::is_void_v<R>)
+                {
+                    return args_size;
+                }
+                else
+                {
+                    return align_up(args_size, alignof(R));
+                }
+            }();
+
+            static constexpr size_t size = []() noexcept
+            {
+                if constexpr (std::is_void_v<R>)
+                {
+                    return args_size;
+                }
+                else
+                {
+                    return result_offset + sizeof(R);
+                }
+            }();
+
+            static constexpr uint32_t signature = []() noexcept
+            {
+                uint32_t hash = fnv_offset;
+
+                if constexpr (!std::is_void_v<R>)
+                {
+                    hash = hash_type<R>(hash);
+                }
+
+                ((hash = hash_type<raw_t<Args>>(hash)), ...);
+                return hash ^ static_cast<uint32_t>(count);
+            }();
+        };
+
+        // Arguments start on an 8-byte boundary, so their layout does not depend on the name length
+        static constexpr size_t args_offset(const size_t name_len) noexcept
+        {
+            return align_up(sizeof(header) + name_len, 8);
+        }
+
+        [[nodiscard]] static header read_header(const buffer_t& buffer) noexcept
+        {
+            header head{};
+            memcpy(&head, buffer.data(), sizeof(header));
+            return head;
+        }
+
+        static void write_header(buffer_t& buffer, const header& head) noexcept
+        {
+            memcpy(buffer.data(), &head, sizeof(header));
+        }
+
+        [[nodiscard]] static std::string read_err_mesg(const buffer_t& buffer, const header& head)
+        {
+            return { reinterpret_cast<const char*>(buffer.data() + buffer.size() - head.err_len),
+                head.err_len };
+        }
+
+        // Truncates the message if needed, so that errors can always be reported
+        static void append_err_mesg(buffer_t& buffer, const std::string_view mesg) noexcept
+        {
+            const size_t err_len = std::min({ mesg.size(), buffer.capacity() - buffer.size(),
+                size_t{ std::numeric_limits<uint16_t>::max() } });
+
+            const auto old_size = buffer.size();
+            buffer.resize(old_size + err_len);
+            memcpy(buffer.data() + old_size, mesg.data(), err_len);
+
+            auto head = read_header(buffer);
+            head.err_len = static_cast<uint16_t>(err_len);
+            write_header(buffer, head);
+        }
+
+        template<typename Tuple, size_t... Is>
+        static void write_args(
+            [[maybe_unused]] uint8_t* base, [[maybe_unused]] const Tuple& args,
+            std::index_sequence<Is...>) noexcept
+        {
+            using layout = raw_layout<void, std::tuple_element_t<Is, Tuple>...>;
+            (memcpy(base + layout::offsets[Is], &std::get<Is>(args),
+                 sizeof(std::tuple_element_t<Is, Tuple>)),
+                ...);
+        }
+
+        template<typename Tuple, size_t... Is>
+        [[nodiscard]] static Tuple read_args(
+            [[maybe_unused]] const uint8_t* base, std::index_sequence<Is...>) noexcept
+        {
+            using layout = raw_layout<void, std::tuple_element_t<Is, Tuple>...>;
+            Tuple args{};
+            (read_arg(base + layout::offsets[Is], std::get<Is>(args)), ...);
+            return args;
+        }
+
+        template<typename T>
+        static void read_arg(const uint8_t* src, T& dst) noexcept
+        {
+            if constexpr (std::is_same_v<T, bool>)
+            {
+                // Any non-zero byte is true, never reinterpret it as a bool directly
+                dst = *src != 0;
+            }
+            else
+            {
+                memcpy(&dst, src, sizeof(T));
+            }
+        }
+
+        template<typename R, typename... Args>
+        [[nodiscard]] static detail::packed_func<R, Args...> make_pack(std::string&& func_name,
+            typename detail::packed_func<R, Args...>::args_t&& args, const rpc_exception& ex)
+        {
+            auto pack = [&]
+            {
+                if constexpr (std::is_void_v<R>)
+                {
+                    return detail::packed_func<void, Args...>(
+                        std::move(func_name), std::move(args));
+                }
+                else
+                {
+                    return detail::packed_func<R, Args...>(
+                        std::move(func_name), std::nullopt, std::move(args));
+                }
+            }();
+
+            pack.set_exception(ex.what(), ex.get_type());
+            return pack;
+        }
+    };
+} // namespace adapters
+} // namespace rpc_hpp
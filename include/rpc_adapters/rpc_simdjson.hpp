@@ -0,0 +1,1814 @@
+///@file rpc_adapters/rpc_simdjson.hpp
+///@author Jackson Harmer (jharmer95@gmail.com)
+///@brief Implementation of the simdjson (https://simdjson.org) adapter, using its On-Demand API
+///
+///@copyright
+///BSD 3-Clause License
+///
+///Copyright (c) 2020-2022, Jackson Harmer
+///All rights reserved.
+///
+///Redistribution and use in source and binary forms, with or without
+///modification, are permitted provided that the following conditions are met:
+///
+///1. Redistributions of source code must retain the above copyright notice, this
+///   list of conditions and the following disclaimer.
+///
+///2. Redistributions in binary form must reproduce the above copyright notice,
+///   this list of conditions and the following disclaimer in the documentation
+///   and/or other materials provided with the distribution.
+///
+///3. Neither the name of the copyright holder nor the names of its
+///   contributors may be used to endorse or promote products derived from
+///   this software without specific prior written permission.
+///
+///THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+///AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+///IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+///DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+///FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+///DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+///SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+///CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+///OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+///OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+///
+
+#pragma once
+
+#include "../rpc.hpp"
+#include "rpc_json_reader.hpp"
+
+#include <simdjson.h>
+
+#include <array>
+#include <charconv>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <string_view>
+
+namespace rpc_hpp
+{
+namespace detail
+{
+    // Per-thread on-demand parser. Within a request, the document indexed by peek_func_name is kept
+    // so that the next parse of the same bytes rewinds it instead of indexing the message again
+    class simdjson_state
+    {
+    public:
+        class scope
+        {
+        public:
+            scope() noexcept { ++get_state().depth; }
+
+            scope(const scope&) = delete;
+            scope& operator=(const scope&) = delete;
+
+            ~scope() noexcept
+            {
+                auto& state = get_state();
+
+                if (--state.depth == 0)
+                {
+                    state.kept = nullptr;
+                }
+            }
+        };
+
+        ///@brief Starts iterating bytes, which are padded in place as simdjson requires
+        [[nodiscard]] static simdjson::ondemand::document& iterate(std::string& bytes)
+        {
+            auto& state = get_state();
+
+            if (state.kept != nullptr && state.kept == bytes.data()
+                && state.kept_size == bytes.size())
+            {
+                state.kept = nullptr;
+                state.doc.rewind();
+                return state.doc;
+            }
+
+            state.kept = nullptr;
+
+            if (bytes.capacity() - bytes.size() < simdjson::SIMDJSON_PADDING)
+            {
+                bytes.reserve(bytes.size() + simdjson::SIMDJSON_PADDING);
+            }
+
+            if (const auto err = state.parser
+                                     .iterate(simdjson::padded_string_view(
+                                         bytes.data(), bytes.size(), bytes.capacity()))
+                                     .get(state.doc);
+                err != simdjson::SUCCESS)
+            {
+                throw deserialization_error(
+                    std::string{ "simdjson: " } + simdjson::error_message(err));
+            }
+
+            return state.doc;
+        }
+
+        ///@brief Keeps the current document of bytes for the next call to iterate in this request
+        static void keep(const std::string& bytes) noexcept
+        {
+            if (auto& state = get_state(); state.depth != 0)
+            {
+                state.kept = bytes.data();
+                state.kept_size = bytes.size();
+            }
+        }
+
+    private:
+        struct state_t
+        {
+            simdjson::ondemand::parser parser{};
+            simdjson::ondemand::document doc{};
+            const char* kept{ nullptr };
+            size_t kept_size{ 0 };
+            unsigned depth{ 0 };
+        };
+
+        [[nodiscard]] static state_t& get_state() noexcept
+        {
+            thread_local state_t state{};
+            return state;
+        }
+    };
+} // namespace detail
+
+namespace adapters
+{
+    ///@brief Writes JSON text into a string
+    class json_writer
+    {
+    public:
+        explicit json_writer(std::string& buffer) noexcept : m_buffer(buffer) {}
+
+        [[nodiscard]] size_t position() const noexcept { return m_buffer.size(); }
+
+        void write_null()
+        {
+            separate();
+            m_buffer.append("null");
+        }
+
+        void write_bool(const bool val)
+        {
+            separate();
+            m_buffer.append(val ? "true" : "false");
+        }
+
+        template<typename T>
+        void write_int(const T val)
+        {
+            static_assert(std::is_integral_v<T>, "write_int requires an integral type");
+
+            std::array<char, 24> text{};
+            const auto [end, ec] = std::to_chars(text.data(), text.data() + text.size(), val);
+            separate();
+            m_buffer.append(text.data(), end);
+        }
+
+        ///@brief Writes val in its shortest round-trip form, always marked as floating point
+        void write_float(const double val)
+        {
+            if (!std::isfinite(val))
+            {
+                throw serialization_error("JSON cannot represent non-finite numbers");
+            }
+
+            std::array<char, 32> text{};
+
+#if defined(__cpp_lib_to_chars)
+            const auto size = static_cast<size_t>(
+                std::to_chars(text.data(), text.data() + text.size(), val).ptr - text.data());
+#else
+            const auto size = static_cast<size_t>(
+                std::snprintf(text.data(), text.size(), "%.17g", val));
+#endif
+
+            separate();
+            const std::string_view str{ text.data(), size };
+            m_buffer.append(str);
+
+            if (str.find_first_of(".eE") == std::string_view::npos)
+            {
+                m_buffer.append(".0");
+            }
+        }
+
+        void write_string(const std::string_view str)
+        {
+            separate();
+            m_buffer.reserve(m_buffer.size() + str.size() + 2);
+            m_buffer.push_back('"');
+
+            size_t start = 0;
+
+            for (size_t i = 0; i < str.size(); ++i)
+            {
+                const auto c = static_cast<unsigned char>(str[i]);
+
+                if (c >= 0x20U && c != '"' && c != '\\')
+                {
+                    continue;
+                }
+
+                m_buffer.append(str.data() + start, i - start);
+                start = i + 1;
+                m_buffer.push_back('\\');
+
+                switch (c)
+                {
+                    case '"':
+                    case '\\':
+                        m_buffer.push_back(static_cast<char>(c));
+                        break;
+
+                    case '\b':
+                        m_buffer.push_back('b');
+                        break;
+
+                    case '\f':
+                        m_buffer.push_back('f');
+                        break;
+
+                    case '\n':
+                        m_buffer.push_back('n');
+                        break;
+
+                    case '\r':
+                        m_buffer.push_back('r');
+                        break;
+
+                    case '\t':
+                        m_buffer.push_back('t');
+                        break;
+
+                    default:
+                    {
+                        constexpr std::string_view hex_digits = "0123456789abcdef";
+                        m_buffer.append("u00");
+                        m_buffer.push_back(hex_digits[c >> 4U]);
+                        m_buffer.push_back(hex_digits[c & 0x0FU]);
+                        break;
+                    }
+                }
+            }
+
+            m_buffer.append(str.data() + start, str.size() - start);
+            m_buffer.push_back('"');
+        }
+
+        ///@brief Writes a string of size characters that need no escaping (e.g. base64)
+        ///
+        ///@return char* Where to put the characters
+        [[nodiscard]] char* write_unescaped_string(const size_t size)
+        {
+            separate();
+            const auto offset = m_buffer.size() + 1;
+            m_buffer.resize(offset + size + 1);
+            m_buffer[offset - 1] = '"';
+            m_buffer.back() = '"';
+            return &m_buffer[offset];
+        }
+
+        ///@brief Writes the separator before the next value, so that position() is where it starts
+        void begin_value()
+        {
+            separate();
+            m_need_comma = false;
+        }
+
+        ///@brief Writes the text of a complete JSON value as-is
+        void write_raw(const std::string_view json)
+        {
+            separate();
+            m_buffer.append(json);
+        }
+
+        void begin_array()
+        {
+            separate();
+            m_buffer.push_back('[');
+            m_need_comma = false;
+        }
+
+        void end_array()
+        {
+            m_buffer.push_back(']');
+            m_need_comma = true;
+        }
+
+        void begin_object()
+        {
+            separate();
+            m_buffer.push_back('{');
+            m_need_comma = false;
+        }
+
+        void end_object()
+        {
+            m_buffer.push_back('}');
+            m_need_comma = true;
+        }
+
+        ///@brief Writes the key of an object member, to be followed by its value
+        void write_key(const std::string_view key)
+        {
+            write_string(key);
+            m_buffer.push_back(':');
+            m_need_comma = false;
+        }
+
+    private:
+        // Writes the ',' before every value but the first of an array or object
+        void separate()
+        {
+            if (m_need_comma)
+            {
+                m_buffer.push_back(',');
+            }
+
+            m_need_comma = true;
+        }
+
+        std::string& m_buffer;
+        bool m_need_comma{ false };
+    };
+
+    ///@brief Serialized JSON message, with the location of each top-level field
+    struct simdjson_message
+    {
+        ///@brief Top-level fields, in the order they are written
+        enum field : size_t
+        {
+            func_name,
+            result,
+            args,
+            except_type,
+            err_mesg,
+            field_count,
+        };
+
+        struct span
+        {
+            size_t offset{};
+            size_t size{};
+        };
+
+        [[nodiscard]] bool has(const field fld) const noexcept { return fields[fld].size != 0; }
+
+        [[nodiscard]] json_reader reader(const field fld) const noexcept
+        {
+            return json_reader{ std::string_view{ bytes }.substr(
+                fields[fld].offset, fields[fld].size) };
+        }
+
+        std::string bytes{};
+        std::array<span, field_count> fields{};
+
+        ///@brief Whether the message is a compact envelope (see detail::compact_envelope), in which
+        ///case the args span covers the arguments without any brackets
+        bool compact{ false };
+    };
+
+    class simdjson_adapter;
+
+    template<>
+    struct serial_traits<simdjson_adapter>
+    {
+        using serial_t = simdjson_message;
+        using bytes_t = std::string;
+    };
+
+    ///@brief Adapter parsing JSON with simdjson's On-Demand API, wire-compatible with the rapidjson
+    ///and Boost.JSON adapters
+    ///
+    ///@note Requests are parsed straight into the arguments, in order, without building a document
+    class simdjson_adapter : public detail::serial_adapter_base<simdjson_adapter>
+    {
+    public:
+        ///@brief While alive, the document indexed to find a function name is kept for its request
+        using request_scope = detail::simdjson_state::scope;
+
+        [[nodiscard]] static std::string to_bytes(simdjson_message&& serial_obj)
+        {
+            return std::move(serial_obj.bytes);
+        }
+
+        ///@brief Hands the message's buffer over to out, giving out's previous buffer to the thread's buffer_pool
+        static void to_bytes(simdjson_message&& serial_obj, std::string& out)
+        {
+            out.swap(serial_obj.bytes);
+            recycle(std::move(serial_obj));
+        }
+
+        ///@brief Gives the message's buffer back to the thread's buffer_pool
+        static void recycle(simdjson_message&& serial_obj) noexcept
+        {
+            buffer_pool<std::string>::local().release(std::move(serial_obj.bytes));
+        }
+
+        ///@brief Whether a message in this format can start with byte (lets multi_server recognize the format)
+        [[nodiscard]] static constexpr bool may_start_with(const uint8_t byte) noexcept
+        {
+            return detail::is_json_text_start(byte);
+        }
+
+        [[nodiscard]] static std::optional<simdjson_message> from_bytes(std::string&& bytes)
+        {
+            simdjson_message msg{ std::move(bytes), {} };
+
+            try
+            {
+                auto& doc = detail::simdjson_state::iterate(msg.bytes);
+
+                if (is_array(doc))
+                {
+                    return index_compact(std::move(msg), doc);
+                }
+
+                simdjson::ondemand::object obj{};
+
+                if (doc.get_object().get(obj) != simdjson::SUCCESS)
+                {
+                    return std::nullopt;
+                }
+
+                for (auto field_result : obj)
+                {
+                    simdjson::ondemand::field fld{};
+                    std::string_view key{};
+                    std::string_view raw{};
+
+                    if (std::move(field_result).get(fld) != simdjson::SUCCESS
+                        || fld.unescaped_key().get(key) != simdjson::SUCCESS
+                        || fld.value().raw_json().get(raw) != simdjson::SUCCESS)
+                    {
+                        return std::nullopt;
+                    }
+
+                    if (const auto idx = field_from_key(key); idx != simdjson_message::field_count)
+                    {
+                        msg.fields[idx] = span_of(msg.bytes, raw);
+                    }
+                }
+
+                if (!doc.at_end())
+                {
+                    return std::nullopt;
+                }
+
+                if (msg.has(simdjson_message::except_type))
+                {
+                    auto ex_reader = msg.reader(simdjson_message::except_type);
+
+                    if (ex_reader.peek_type() != json_reader::value_type::integer
+                        || (ex_reader.read_int<int>() != 0 && !msg.has(simdjson_message::err_mesg)))
+                    {
+                        return std::nullopt;
+                    }
+
+                    // Objects with exceptions can be otherwise empty
+                    return std::make_optional(std::move(msg));
+                }
+
+                if (!msg.has(simdjson_message::func_name) || get_func_name(msg).empty())
+                {
+                    return std::nullopt;
+                }
+
+                if (!msg.has(simdjson_message::args)
+                    || msg.reader(simdjson_message::args).peek_type()
+                        != json_reader::value_type::array)
+                {
+                    return std::nullopt;
+                }
+            }
+            catch (const rpc_exception&)
+            {
+                return std::nullopt;
+            }
+
+            return std::make_optional(std::move(msg));
+        }
+
+        static simdjson_message empty_object()
+        {
+            if constexpr (use_compact_envelope)
+            {
+                simdjson_message msg{};
+                msg.compact = true;
+                json_writer writer{ msg.bytes };
+                writer.begin_array();
+                writer.write_int(detail::compact_envelope::version);
+                writer.write_int(0U);
+                write_value(msg, writer, simdjson_message::func_name,
+                    [](json_writer& wr) { wr.write_string({}); });
+                writer.write_null();
+                writer.end_array();
+                return msg;
+            }
+            else
+            {
+                return simdjson_message{ "{}", {} };
+            }
+        }
+
+        template<typename R, typename... Args>
+        [[nodiscard]] static simdjson_message serialize_pack(
+            const detail::packed_func<R, Args...>& pack)
+        {
+            if constexpr (use_compact_envelope)
+            {
+                return serialize_compact(pack);
+            }
+
+            simdjson_message msg{};
+            msg.bytes = buffer_pool<std::string>::local().acquire(
+                detail::message_size_hints::get(pack.get_func_name()));
+            json_writer writer{ msg.bytes };
+            writer.begin_object();
+
+            write_field(msg, writer, simdjson_message::func_name,
+                [&pack](json_writer& wr) { wr.write_string(pack.get_func_name()); });
+
+            if constexpr (!std::is_void_v<R>)
+            {
+                write_field(msg, writer, simdjson_message::result,
+                    [&pack](json_writer& wr)
+                    {
+                        if (pack)
+                        {
+                            push_arg(pack.get_result(), wr);
+                        }
+                        else
+                        {
+                            wr.write_null();
+                        }
+                    });
+            }
+
+            write_field(msg, writer, simdjson_message::args,
+                [&pack](json_writer& wr)
+                {
+                    wr.begin_array();
+                    detail::for_each_tuple(
+                        pack.get_args(), [&wr](const auto& elem) { push_arg(elem, wr); });
+                    wr.end_array();
+                });
+
+            if (pack.get_except_type() != exception_type::none)
+            {
+                write_field(msg, writer, simdjson_message::except_type,
+                    [&pack](json_writer& wr)
+                    { wr.write_int(static_cast<int>(pack.get_except_type())); });
+
+                write_field(msg, writer, simdjson_message::err_mesg,
+                    [&pack](json_writer& wr) { wr.write_string(pack.get_err_mesg()); });
+            }
+
+            writer.end_object();
+            return msg;
+        }
+
+        template<typename R, typename... Args>
+        [[nodiscard]] static detail::packed_func<R, Args...> deserialize_pack(
+            const simdjson_message& serial_obj)
+        {
+            auto bytes = serial_obj.bytes;
+            return parse_pack<R, Args...>(bytes);
+        }
+
+        [[nodiscard]] static std::string get_func_name(const simdjson_message& serial_obj)
+        {
+            if (!serial_obj.has(simdjson_message::func_name))
+            {
+                return {};
+            }
+
+            std::string buffer{};
+            const auto name = serial_obj.reader(simdjson_message::func_name).read_string(buffer);
+            return name.data() == buffer.data() ? std::move(buffer) : std::string{ name };
+        }
+
+        [[nodiscard]] static rpc_exception extract_exception(const simdjson_message& serial_obj)
+        {
+            if (!serial_obj.has(simdjson_message::err_mesg)
+                || !serial_obj.has(simdjson_message::except_type))
+            {
+                throw deserialization_error("simdjson: message does not contain an exception");
+            }
+
+            std::string buffer{};
+
+            return rpc_exception{
+                std::string{ serial_obj.reader(simdjson_message::err_mesg).read_string(buffer) },
+                static_cast<exception_type>(
+                    serial_obj.reader(simdjson_message::except_type).read_int<int>())
+            };
+        }
+
+        // Rebuilds the message in a single pass, keeping all other fields as-is
+        static void set_exception(simdjson_message& serial_obj, const rpc_exception& ex)
+        {
+            const std::string_view mesg = ex.what();
+            simdjson_message msg{};
+            msg.bytes.reserve(serial_obj.bytes.size() + mesg.size() + 32);
+            json_writer writer{ msg.bytes };
+
+            if (serial_obj.compact)
+            {
+                // The error replaces the result
+                msg.compact = true;
+                writer.begin_array();
+                writer.write_int(detail::compact_envelope::version);
+                writer.write_int(detail::compact_envelope::error_flag);
+                write_value(msg, writer, simdjson_message::func_name,
+                    [&serial_obj](json_writer& wr)
+                    {
+                        if (serial_obj.has(simdjson_message::func_name))
+                        {
+                            wr.write_raw(raw_field(serial_obj, simdjson_message::func_name));
+                        }
+                        else
+                        {
+                            wr.write_string({});
+                        }
+                    });
+
+                write_error(msg, writer, ex.get_type(), mesg);
+
+                if (serial_obj.has(simdjson_message::args))
+                {
+                    write_value(msg, writer, simdjson_message::args,
+                        [&serial_obj](json_writer& wr)
+                        { wr.write_raw(raw_field(serial_obj, simdjson_message::args)); });
+                }
+
+                writer.end_array();
+                serial_obj = std::move(msg);
+                return;
+            }
+
+            writer.begin_object();
+
+            for (size_t i = 0; i < simdjson_message::field_count; ++i)
+            {
+                const auto fld = static_cast<simdjson_message::field>(i);
+
+                if (fld == simdjson_message::except_type)
+                {
+                    write_field(msg, writer, fld,
+                        [&ex](json_writer& wr) { wr.write_int(static_cast<int>(ex.get_type())); });
+                }
+                else if (fld == simdjson_message::err_mesg)
+                {
+                    write_field(
+                        msg, writer, fld, [mesg](json_writer& wr) { wr.write_string(mesg); });
+                }
+                else if (serial_obj.has(fld))
+                {
+                    write_field(msg, writer, fld,
+                        [&serial_obj, fld](json_writer& wr)
+                        { wr.write_raw(raw_field(serial_obj, fld)); });
+                }
+            }
+
+            writer.end_object();
+            serial_obj = std::move(msg);
+        }
+
+        ///@brief Finds the function name of a request, without parsing anything else
+        [[nodiscard]] static std::optional<std::string> peek_func_name(std::string& bytes)
+        {
+            try
+            {
+                auto& doc = detail::simdjson_state::iterate(bytes);
+                std::string_view func_name{};
+
+                if (is_array(doc))
+                {
+                    if (!peek_compact_func_name(doc, func_name))
+                    {
+                        return std::nullopt;
+                    }
+                }
+                else
+                {
+                    simdjson::ondemand::object obj{};
+
+                    if (doc.get_object().get(obj) != simdjson::SUCCESS
+                        || obj.find_field_unordered("func_name").get_string().get(func_name)
+                            != simdjson::SUCCESS)
+                    {
+                        return std::nullopt;
+                    }
+                }
+
+                if (func_name.empty())
+                {
+                    return std::nullopt;
+                }
+
+                detail::simdjson_state::keep(bytes);
+                return std::string{ func_name };
+            }
+            catch (const rpc_exception&)
+            {
+                return std::nullopt;
+            }
+        }
+
+        ///@brief Parses a message lazily, decoding each argument straight into its type in order
+        template<typename R, typename... Args>
+        [[nodiscard]] static detail::packed_func<R, Args...> parse_pack(std::string& bytes)
+        {
+            auto& doc = detail::simdjson_state::iterate(bytes);
+            detail::streamed_pack<R, Args...> fields{};
+
+            if (is_array(doc))
+            {
+                parse_compact(doc, fields);
+            }
+            else
+            {
+                simdjson::ondemand::object obj{};
+                check(doc.get_object().get(obj), "object", doc);
+
+                for (auto field_result : obj)
+                {
+                    simdjson::ondemand::field fld{};
+                    check_syntax(std::move(field_result).get(fld));
+
+                    std::string_view key{};
+                    check_syntax(fld.unescaped_key().get(key));
+                    auto& val = fld.value();
+
+                    if (key == "args")
+                    {
+                        simdjson::ondemand::array arr{};
+                        check(val.get_array().get(arr), "array", val);
+
+                        [[maybe_unused]] simdjson::ondemand::array_iterator it{};
+                        [[maybe_unused]] simdjson::ondemand::array_iterator end{};
+                        check_syntax(arr.begin().get(it));
+                        check_syntax(arr.end().get(end));
+
+                        fields.args =
+                            typename detail::packed_func<R, Args...>::args_t{ parse_args<Args>(
+                                it, end)... };
+                    }
+                    else if (key == "result")
+                    {
+                        if constexpr (!std::is_void_v<R>)
+                        {
+                            if (detail::is_optional_v<R> || !is_null(val))
+                            {
+                                fields.result = parse_arg<R>(val);
+                            }
+                        }
+                    }
+                    else if (key == "func_name")
+                    {
+                        fields.func_name = parse_arg<std::string>(val);
+                    }
+                    else if (key == "except_type")
+                    {
+                        fields.except_type = static_cast<exception_type>(parse_arg<int>(val));
+                    }
+                    else if (key == "err_mesg")
+                    {
+                        fields.err_mesg = parse_arg<std::string>(val);
+                    }
+                }
+            }
+
+            if (!doc.at_end())
+            {
+                throw deserialization_error("simdjson: unexpected data after the message");
+            }
+
+            return std::move(fields).finish();
+        }
+
+        template<typename T>
+        static void serialize(const T& val, json_writer& writer) = delete;
+
+        template<typename T>
+        static T deserialize(simdjson::ondemand::value& val) = delete;
+
+    private:
+        // Numeric containers are sent as base64 strings holding their raw (host order) bytes.
+        // Decoding accepts both forms regardless of this setting
+#if defined(RPC_HPP_SIMDJSON_BINARY_ARRAYS)
+        static constexpr bool use_binary_arrays = true;
+#else
+        static constexpr bool use_binary_arrays = false;
+#endif
+
+        // Messages are written as a positional array (see detail::compact_envelope) instead of an
+        // object with named fields. Decoding accepts both forms regardless of this setting
+#if defined(RPC_HPP_SIMDJSON_COMPACT_ENVELOPE)
+        static constexpr bool use_compact_envelope = true;
+#else
+        static constexpr bool use_compact_envelope = false;
+#endif
+
+        static constexpr std::array<std::string_view, simdjson_message::field_count> field_names{
+            "func_name", "result", "args", "except_type", "err_mesg"
+        };
+
+        [[nodiscard]] static simdjson_message::field field_from_key(
+            const std::string_view key) noexcept
+        {
+            for (size_t i = 0; i < field_names.size(); ++i)
+            {
+                if (field_names[i] == key)
+                {
+                    return static_cast<simdjson_message::field>(i);
+                }
+            }
+
+            return simdjson_message::field_count;
+        }
+
+        template<typename F>
+        static void write_field(
+            simdjson_message& msg, json_writer& writer, const simdjson_message::field fld, F&& func)
+        {
+            writer.write_key(field_names[fld]);
+            write_value(msg, writer, fld, std::forward<F>(func));
+        }
+
+        // Writes a value (or several, for the arguments of a compact envelope) and records its span
+        template<typename F>
+        static void write_value(
+            simdjson_message& msg, json_writer& writer, const simdjson_message::field fld, F&& func)
+        {
+            writer.begin_value();
+            const auto offset = writer.position();
+            std::forward<F>(func)(writer);
+            msg.fields[fld] = { offset, writer.position() - offset };
+        }
+
+        [[nodiscard]] static std::string_view raw_field(
+            const simdjson_message& msg, const simdjson_message::field fld) noexcept
+        {
+            const auto& span = msg.fields[fld];
+            return std::string_view{ msg.bytes }.substr(span.offset, span.size);
+        }
+
+        // Scalars may include the whitespace following them
+        [[nodiscard]] static simdjson_message::span span_of(
+            const std::string& bytes, std::string_view raw) noexcept
+        {
+            while (!raw.empty()
+                && (raw.back() == ' ' || raw.back() == '\n' || raw.back() == '\r'
+                    || raw.back() == '\t'))
+            {
+                raw.remove_suffix(1);
+            }
+
+            return { static_cast<size_t>(raw.data() - bytes.data()), raw.size() };
+        }
+
+        [[nodiscard]] static bool is_array(simdjson::ondemand::document& doc)
+        {
+            simdjson::ondemand::json_type type{};
+            return doc.type().get(type) == simdjson::SUCCESS
+                && type == simdjson::ondemand::json_type::array;
+        }
+
+        [[nodiscard]] static bool is_type(
+            simdjson::ondemand::value& val, const simdjson::ondemand::json_type expected)
+        {
+            simdjson::ondemand::json_type type{};
+            return val.type().get(type) == simdjson::SUCCESS && type == expected;
+        }
+
+        // Writes [except_type, err_mesg], the result slot of a compact envelope reporting an error
+        static void write_error(simdjson_message& msg, json_writer& writer,
+            const exception_type type, const std::string_view mesg)
+        {
+            writer.begin_array();
+            write_value(msg, writer, simdjson_message::except_type,
+                [type](json_writer& wr) { wr.write_int(static_cast<int>(type)); });
+            write_value(msg, writer, simdjson_message::err_mesg,
+                [mesg](json_writer& wr) { wr.write_string(mesg); });
+            writer.end_array();
+        }
+
+        template<typename R, typename... Args>
+        [[nodiscard]] static simdjson_message serialize_compact(
+            const detail::packed_func<R, Args...>& pack)
+        {
+            const bool has_error = pack.get_except_type() != exception_type::none;
+            simdjson_message msg{};
+            msg.compact = true;
+            msg.bytes = buffer_pool<std::string>::local().acquire(
+                detail::message_size_hints::get(pack.get_func_name()));
+            json_writer writer{ msg.bytes };
+            writer.begin_array();
+            writer.write_int(detail::compact_envelope::version);
+            writer.write_int(has_error ? detail::compact_envelope::error_flag : 0U);
+            write_value(msg, writer, simdjson_message::func_name,
+                [&pack](json_writer& wr) { wr.write_string(pack.get_func_name()); });
+
+            if (has_error)
+            {
+                write_error(msg, writer, pack.get_except_type(), pack.get_err_mesg());
+            }
+            else
+            {
+                write_value(msg, writer, simdjson_message::result,
+                    [&pack](json_writer& wr)
+                    {
+                        if constexpr (!std::is_void_v<R>)
+                        {
+                            if (pack)
+                            {
+                                push_arg(pack.get_result(), wr);
+                                return;
+                            }
+                        }
+
+                        wr.write_null();
+                    });
+            }
+
+            if constexpr (sizeof...(Args) != 0)
+            {
+                write_value(msg, writer, simdjson_message::args,
+                    [&pack](json_writer& wr)
+                    {
+                        detail::for_each_tuple(
+                            pack.get_args(), [&wr](const auto& elem) { push_arg(elem, wr); });
+                    });
+            }
+
+            writer.end_array();
+            return msg;
+        }
+
+        // Records the span of a value
+        [[nodiscard]] static bool index_value(simdjson_message& msg,
+            const simdjson_message::field fld, simdjson::ondemand::value& val)
+        {
+            std::string_view raw{};
+
+            if (val.raw_json().get(raw) != simdjson::SUCCESS)
+            {
+                return false;
+            }
+
+            msg.fields[fld] = span_of(msg.bytes, raw);
+            return true;
+        }
+
+        // Records the spans of the [except_type, err_mesg] pair of a compact envelope
+        [[nodiscard]] static bool index_error(simdjson_message& msg, simdjson::ondemand::value& val)
+        {
+            simdjson::ondemand::array arr{};
+
+            if (val.get_array().get(arr) != simdjson::SUCCESS)
+            {
+                return false;
+            }
+
+            size_t count = 0;
+
+            for (auto elem_result : arr)
+            {
+                simdjson::ondemand::value elem{};
+
+                if (count == 2 || std::move(elem_result).get(elem) != simdjson::SUCCESS)
+                {
+                    return false;
+                }
+
+                const bool valid = count == 0
+                    ? is_type(elem, simdjson::ondemand::json_type::number)
+                        && index_value(msg, simdjson_message::except_type, elem)
+                    : is_type(elem, simdjson::ondemand::json_type::string)
+                        && index_value(msg, simdjson_message::err_mesg, elem);
+
+                if (!valid)
+                {
+                    return false;
+                }
+
+                ++count;
+            }
+
+            return count == 2
+                && msg.reader(simdjson_message::except_type).peek_type()
+                == json_reader::value_type::integer;
+        }
+
+        // Records where the fields of a compact envelope are, with the arguments as a single span
+        [[nodiscard]] static std::optional<simdjson_message> index_compact(
+            simdjson_message&& msg, simdjson::ondemand::document& doc)
+        {
+            using envelope = detail::compact_envelope;
+
+            simdjson::ondemand::array arr{};
+
+            if (doc.get_array().get(arr) != simdjson::SUCCESS)
+            {
+                return std::nullopt;
+            }
+
+            msg.compact = true;
+            bool has_error = false;
+            size_t index = 0;
+            size_t args_end = 0;
+
+            for (auto elem_result : arr)
+            {
+                simdjson::ondemand::value val{};
+
+                if (std::move(elem_result).get(val) != simdjson::SUCCESS)
+                {
+                    return std::nullopt;
+                }
+
+                if (index == envelope::version_index)
+                {
+                    int64_t version{};
+
+                    if (val.get_int64().get(version) != simdjson::SUCCESS
+                        || version != envelope::version)
+                    {
+                        return std::nullopt;
+                    }
+                }
+                else if (index == envelope::flags_index)
+                {
+                    uint64_t flags{};
+
+                    if (val.get_uint64().get(flags) != simdjson::SUCCESS)
+                    {
+                        return std::nullopt;
+                    }
+
+                    has_error = envelope::has_error(static_cast<unsigned>(flags));
+                }
+                else if (index == envelope::func_name_index)
+                {
+                    if (!is_type(val, simdjson::ondemand::json_type::string)
+                        || !index_value(msg, simdjson_message::func_name, val))
+                    {
+                        return std::nullopt;
+                    }
+                }
+                else if (index == envelope::result_index)
+                {
+                    if (!(has_error ? index_error(msg, val)
+                                    : index_value(msg, simdjson_message::result, val)))
+                    {
+                        return std::nullopt;
+                    }
+                }
+                else
+                {
+                    std::string_view raw{};
+
+                    if (val.raw_json().get(raw) != simdjson::SUCCESS)
+                    {
+                        return std::nullopt;
+                    }
+
+                    const auto span = span_of(msg.bytes, raw);
+
+                    if (index == envelope::args_index)
+                    {
+                        msg.fields[simdjson_message::args].offset = span.offset;
+                    }
+
+                    args_end = span.offset + span.size;
+                }
+
+                ++index;
+            }
+
+            if (!doc.at_end() || index < envelope::args_index)
+            {
+                return std::nullopt;
+            }
+
+            if (index > envelope::args_index)
+            {
+                auto& args_span = msg.fields[simdjson_message::args];
+                args_span.size = args_end - args_span.offset;
+            }
+
+            if (!has_error && get_func_name(msg).empty())
+            {
+                return std::nullopt;
+            }
+
+            return std::make_optional(std::move(msg));
+        }
+
+        [[nodiscard]] static bool peek_compact_func_name(
+            simdjson::ondemand::document& doc, std::string_view& func_name)
+        {
+            using envelope = detail::compact_envelope;
+
+            simdjson::ondemand::array arr{};
+
+            if (doc.get_array().get(arr) != simdjson::SUCCESS)
+            {
+                return false;
+            }
+
+            size_t index = 0;
+
+            for (auto elem_result : arr)
+            {
+                simdjson::ondemand::value val{};
+
+                if (std::move(elem_result).get(val) != simdjson::SUCCESS)
+                {
+                    return false;
+                }
+
+                if (index == envelope::version_index)
+                {
+                    int64_t version{};
+
+                    if (val.get_int64().get(version) != simdjson::SUCCESS
+                        || version != envelope::version)
+                    {
+                        return false;
+                    }
+                }
+                else if (index == envelope::func_name_index)
+                {
+                    return val.get_string().get(func_name) == simdjson::SUCCESS;
+                }
+
+                ++index;
+            }
+
+            return false;
+        }
+
+        // Parses the next fixed field of a compact envelope
+        template<typename T>
+        [[nodiscard]] static T parse_compact_field(
+            simdjson::ondemand::array_iterator& it, const simdjson::ondemand::array_iterator& end)
+        {
+            if (it == end)
+            {
+                throw deserialization_error("simdjson: invalid compact envelope");
+            }
+
+            return parse_args<T>(it, end);
+        }
+
+        template<typename R, typename... Args>
+        static void parse_compact(
+            simdjson::ondemand::document& doc, detail::streamed_pack<R, Args...>& fields)
+        {
+            using envelope = detail::compact_envelope;
+
+            simdjson::ondemand::array arr{};
+            check(doc.get_array().get(arr), "array", doc);
+
+            simdjson::ondemand::array_iterator it{};
+            simdjson::ondemand::array_iterator end{};
+            check_syntax(arr.begin().get(it));
+            check_syntax(arr.end().get(end));
+
+            if (parse_compact_field<int>(it, end) != envelope::version)
+            {
+                throw deserialization_error("simdjson: invalid compact envelope");
+            }
+
+            const bool has_error = envelope::has_error(parse_compact_field<unsigned>(it, end));
+            fields.func_name = parse_compact_field<std::string>(it, end);
+
+            if (it == end)
+            {
+                throw deserialization_error("simdjson: invalid compact envelope");
+            }
+
+            simdjson::ondemand::value slot{};
+            check_syntax((*it).get(slot));
+
+            if (has_error)
+            {
+                simdjson::ondemand::array err_arr{};
+                check(slot.get_array().get(err_arr), "array", slot);
+
+                simdjson::ondemand::array_iterator err_it{};
+                simdjson::ondemand::array_iterator err_end{};
+                check_syntax(err_arr.begin().get(err_it));
+                check_syntax(err_arr.end().get(err_end));
+
+                fields.except_type =
+                    static_cast<exception_type>(parse_compact_field<int>(err_it, err_end));
+                fields.err_mesg = parse_compact_field<std::string>(err_it, err_end);
+
+                if (err_it != err_end)
+                {
+                    throw deserialization_error("simdjson: invalid compact envelope");
+                }
+            }
+            else if constexpr (!std::is_void_v<R>)
+            {
+                // A null result is a valid value for std::optional
+                if (detail::is_optional_v<R> || !is_null(slot))
+                {
+                    fields.result = parse_arg<R>(slot);
+                }
+            }
+
+            ++it;
+
+            // Replies that only report an error can omit the arguments
+            if (has_error && it == end)
+            {
+                return;
+            }
+
+            fields.args =
+                typename detail::packed_func<R, Args...>::args_t{ parse_args<Args>(it, end)... };
+
+            while (it != end)
+            {
+                ++it;
+            }
+        }
+
+        // Malformed JSON
+        static void check_syntax(const simdjson::error_code err)
+        {
+            if (err != simdjson::SUCCESS)
+            {
+                throw deserialization_error(
+                    std::string{ "simdjson: " } + simdjson::error_message(err));
+            }
+        }
+
+        // Well-formed JSON of an unexpected type or range
+        template<typename V>
+        static void check(const simdjson::error_code err, const char* expect_name, V& val)
+        {
+            if (err == simdjson::INCORRECT_TYPE || err == simdjson::NUMBER_OUT_OF_RANGE
+                || err == simdjson::BIGINT_ERROR)
+            {
+                throw function_mismatch(mismatch_message(expect_name, val));
+            }
+
+            check_syntax(err);
+        }
+
+        [[nodiscard]] static const char* type_name(simdjson::ondemand::value& val) noexcept
+        {
+            simdjson::ondemand::json_type type{};
+
+            if (val.type().get(type) != simdjson::SUCCESS)
+            {
+                return "invalid";
+            }
+
+            switch (type)
+            {
+                case simdjson::ondemand::json_type::array:
+                    return "array";
+
+                case simdjson::ondemand::json_type::object:
+                    return "object";
+
+                case simdjson::ondemand::json_type::number:
+                {
+                    simdjson::ondemand::number_type num_type{};
+
+                    if (val.get_number_type().get(num_type) == simdjson::SUCCESS
+                        && num_type == simdjson::ondemand::number_type::floating_point_number)
+                    {
+                        return "float";
+                    }
+
+                    return "integer";
+                }
+
+                case simdjson::ondemand::json_type::string:
+                    return "string";
+
+                case simdjson::ondemand::json_type::boolean:
+                    return "bool";
+
+                case simdjson::ondemand::json_type::null:
+                    return "null";
+
+                default:
+                    return "unknown";
+            }
+        }
+
+        [[nodiscard]] static const char* type_name(simdjson::ondemand::document&) noexcept
+        {
+            return "non-object";
+        }
+
+        template<typename V>
+        [[nodiscard]] static std::string mismatch_message(const char* expect_name, V& val)
+        {
+            return std::string{ "simdjson expected type: " } + expect_name
+                + ", got type: " + type_name(val);
+        }
+
+        [[nodiscard]] static bool is_null(simdjson::ondemand::value& val)
+        {
+            simdjson::ondemand::json_type type{};
+            check_syntax(val.type().get(type));
+            return type == simdjson::ondemand::json_type::null;
+        }
+
+        // Numbers must be written in the expected form, so integers are not read as floats (or the
+        // reverse)
+        static void check_number(simdjson::ondemand::value& val, const bool floating)
+        {
+            simdjson::ondemand::json_type type{};
+            check_syntax(val.type().get(type));
+
+            if (type != simdjson::ondemand::json_type::number)
+            {
+                throw function_mismatch(mismatch_message(floating ? "float" : "integer", val));
+            }
+
+            simdjson::ondemand::number_type num_type{};
+            check(val.get_number_type().get(num_type), floating ? "float" : "integer", val);
+
+            if ((num_type == simdjson::ondemand::number_type::floating_point_number) != floating)
+            {
+                throw function_mismatch(mismatch_message(floating ? "float" : "integer", val));
+            }
+        }
+
+        template<typename T>
+        static void push_arg(const T& arg, json_writer& writer)
+        {
+            using no_ref_t = std::remove_cv_t<std::remove_reference_t<T>>;
+
+            if constexpr (std::is_same_v<no_ref_t, bool>)
+            {
+                writer.write_bool(arg);
+            }
+            else if constexpr (std::is_integral_v<no_ref_t>)
+            {
+                writer.write_int(arg);
+            }
+            else if constexpr (std::is_floating_point_v<no_ref_t>)
+            {
+                static_assert(!std::is_same_v<no_ref_t, long double>,
+                    "long double is not supported for RPC simdjson serialization!");
+
+                writer.write_float(static_cast<double>(arg));
+            }
+            else if constexpr (std::is_same_v<no_ref_t, std::string>)
+            {
+                writer.write_string(arg);
+            }
+            else if constexpr (detail::is_optional_v<no_ref_t>)
+            {
+                if (arg.has_value())
+                {
+                    push_arg(*arg, writer);
+                }
+                else
+                {
+                    writer.write_null();
+                }
+            }
+            else if constexpr (detail::is_variant_v<no_ref_t>)
+            {
+                // Encoded as [index, value]
+                writer.begin_array();
+                writer.write_int(arg.index());
+                std::visit([&writer](const auto& val) { push_arg(val, writer); }, arg);
+                writer.end_array();
+            }
+            else if constexpr (detail::is_string_map_v<no_ref_t>)
+            {
+                writer.begin_object();
+
+                for (const auto& [key, val] : arg)
+                {
+                    writer.write_key(key);
+                    push_arg(val, writer);
+                }
+
+                writer.end_object();
+            }
+            else if constexpr (detail::is_map_v<no_ref_t>)
+            {
+                // Non-string keys are encoded as an array of [key, value] pairs
+                writer.begin_array();
+
+                for (const auto& [key, val] : arg)
+                {
+                    writer.begin_array();
+                    push_arg(key, writer);
+                    push_arg(val, writer);
+                    writer.end_array();
+                }
+
+                writer.end_array();
+            }
+            else if constexpr ((use_binary_arrays && detail::is_bulk_container_v<no_ref_t>)
+                || detail::is_byte_container_v<no_ref_t>)
+            {
+                const auto byte_size = arg.size() * sizeof(typename no_ref_t::value_type);
+
+                detail::base64_encode(arg.data(), byte_size,
+                    writer.write_unescaped_string(detail::base64_encoded_size(byte_size)));
+            }
+            else if constexpr (detail::is_container_v<no_ref_t>)
+            {
+                writer.begin_array();
+
+                for (const auto& val : arg)
+                {
+                    push_arg(val, writer);
+                }
+
+                writer.end_array();
+            }
+            else if constexpr (detail::is_tuple_v<no_ref_t>)
+            {
+                writer.begin_array();
+                detail::for_each_tuple(arg, [&writer](const auto& val) { push_arg(val, writer); });
+                writer.end_array();
+            }
+            else if constexpr (detail::is_serializable_v<simdjson_adapter, no_ref_t>)
+            {
+                writer.write_raw(no_ref_t::template serialize<simdjson_adapter>(arg).bytes);
+            }
+            else if constexpr (detail::is_reflected_v<no_ref_t>)
+            {
+                writer.begin_object();
+
+                detail::for_each_field(arg,
+                    [&writer](const std::string_view name, const auto& field)
+                    {
+                        writer.write_key(name);
+                        push_arg(field, writer);
+                    });
+
+                writer.end_object();
+            }
+            else
+            {
+                serialize<no_ref_t>(arg, writer);
+            }
+        }
+
+        // nodiscard because parsing can be expensive, and it makes no sense to not use the parsed result
+        template<typename T>
+        [[nodiscard]] static std::remove_cv_t<std::remove_reference_t<T>> parse_arg(
+            simdjson::ondemand::value& val)
+        {
+            using no_ref_t = std::remove_cv_t<std::remove_reference_t<T>>;
+
+            if constexpr (detail::is_bulk_container_v<no_ref_t>)
+            {
+                simdjson::ondemand::json_type type{};
+                check_syntax(val.type().get(type));
+
+                if (type == simdjson::ondemand::json_type::string)
+                {
+                    return parse_bulk<no_ref_t>(val);
+                }
+            }
+
+            if constexpr (std::is_same_v<no_ref_t, bool>)
+            {
+                bool ret{};
+                check(val.get_bool().get(ret), "bool", val);
+                return ret;
+            }
+            else if constexpr (std::is_integral_v<no_ref_t>)
+            {
+                check_number(val, false);
+
+                if constexpr (std::is_signed_v<no_ref_t>)
+                {
+                    int64_t ret{};
+                    check(val.get_int64().get(ret), "integer", val);
+
+                    if (ret < std::numeric_limits<no_ref_t>::min()
+                        || ret > std::numeric_limits<no_ref_t>::max())
+                    {
+                        throw function_mismatch("simdjson integer out of range");
+                    }
+
+                    return static_cast<no_ref_t>(ret);
+                }
+                else
+                {
+                    uint64_t ret{};
+                    check(val.get_uint64().get(ret), "unsigned integer", val);
+
+                    if (ret > std::numeric_limits<no_ref_t>::max())
+                    {
+                        throw function_mismatch("simdjson integer out of range");
+                    }
+
+                    return static_cast<no_ref_t>(ret);
+                }
+            }
+            else if constexpr (std::is_floating_point_v<no_ref_t>)
+            {
+                check_number(val, true);
+
+                double ret{};
+                check(val.get_double().get(ret), "float", val);
+                return static_cast<no_ref_t>(ret);
+            }
+            else if constexpr (std::is_same_v<no_ref_t, std::string>)
+            {
+                std::string_view ret{};
+                check(val.get_string().get(ret), "string", val);
+                return std::string{ ret };
+            }
+            else if constexpr (detail::is_optional_v<no_ref_t>)
+            {
+                if (is_null(val))
+                {
+                    return std::nullopt;
+                }
+
+                return parse_arg<typename no_ref_t::value_type>(val);
+            }
+            else if constexpr (detail::is_variant_v<no_ref_t>)
+            {
+                simdjson::ondemand::array arr{};
+                check(val.get_array().get(arr), "[index, value]", val);
+
+                simdjson::ondemand::array_iterator it{};
+                simdjson::ondemand::array_iterator end{};
+                check_syntax(arr.begin().get(it));
+                check_syntax(arr.end().get(end));
+
+                const auto index = parse_args<int64_t>(it, end);
+
+                if (index < 0)
+                {
+                    throw function_mismatch("Variant index out of range");
+                }
+
+                if (it == end)
+                {
+                    throw function_mismatch("simdjson expected type: [index, value]");
+                }
+
+                simdjson::ondemand::value elem{};
+                check_syntax((*it).get(elem));
+
+                auto ret = detail::make_variant<no_ref_t>(static_cast<size_t>(index),
+                    [&elem](auto tag) { return parse_arg<typename decltype(tag)::type>(elem); });
+
+                if (++it != end)
+                {
+                    throw function_mismatch("simdjson expected type: [index, value]");
+                }
+
+                return ret;
+            }
+            else if constexpr (detail::is_string_map_v<no_ref_t>)
+            {
+                simdjson::ondemand::object obj{};
+                check(val.get_object().get(obj), "object", val);
+                no_ref_t container{};
+
+                for (auto field_result : obj)
+                {
+                    simdjson::ondemand::field fld{};
+                    check_syntax(std::move(field_result).get(fld));
+
+                    std::string_view key{};
+                    check_syntax(fld.unescaped_key().get(key));
+                    auto key_str = std::string{ key };
+
+                    detail::emplace_assoc(container, std::move(key_str),
+                        parse_arg<typename no_ref_t::mapped_type>(fld.value()));
+                }
+
+                return container;
+            }
+            else if constexpr (detail::is_map_v<no_ref_t>)
+            {
+                simdjson::ondemand::array arr{};
+                check(val.get_array().get(arr), "array", val);
+                no_ref_t container{};
+
+                for (auto elem_result : arr)
+                {
+                    simdjson::ondemand::array pair{};
+                    check(elem_result.get_array().get(pair), "[key, value]", val);
+
+                    simdjson::ondemand::array_iterator it{};
+                    simdjson::ondemand::array_iterator end{};
+                    check_syntax(pair.begin().get(it));
+                    check_syntax(pair.end().get(end));
+
+                    auto key = parse_args<typename no_ref_t::key_type>(it, end);
+
+                    detail::emplace_assoc(container, std::move(key),
+                        parse_args<typename no_ref_t::mapped_type>(it, end));
+
+                    if (it != end)
+                    {
+                        throw function_mismatch("simdjson expected type: [key, value]");
+                    }
+                }
+
+                return container;
+            }
+            else if constexpr (detail::is_set_v<no_ref_t>)
+            {
+                simdjson::ondemand::array arr{};
+                check(val.get_array().get(arr), "array", val);
+                no_ref_t container{};
+
+                for (auto elem_result : arr)
+                {
+                    simdjson::ondemand::value elem{};
+                    check_syntax(std::move(elem_result).get(elem));
+                    detail::emplace_assoc(
+                        container, parse_arg<typename no_ref_t::value_type>(elem));
+                }
+
+                return container;
+            }
+            else if constexpr (detail::is_byte_container_v<no_ref_t>)
+            {
+                return parse_bulk<no_ref_t>(val);
+            }
+            else if constexpr (detail::is_fixed_extent_v<no_ref_t>)
+            {
+                simdjson::ondemand::array arr{};
+                check(val.get_array().get(arr), "array", val);
+                no_ref_t container{};
+                size_t size = 0;
+
+                for (auto elem_result : arr)
+                {
+                    if (size == container.size())
+                    {
+                        detail::check_extent<no_ref_t>(size + 1);
+                    }
+
+                    simdjson::ondemand::value elem{};
+                    check_syntax(std::move(elem_result).get(elem));
+                    container[size++] = parse_arg<typename no_ref_t::value_type>(elem);
+                }
+
+                detail::check_extent<no_ref_t>(size);
+                return container;
+            }
+            else if constexpr (detail::is_container_v<no_ref_t>)
+            {
+                simdjson::ondemand::array arr{};
+                check(val.get_array().get(arr), "array", val);
+                no_ref_t container{};
+
+                for (auto elem_result : arr)
+                {
+                    simdjson::ondemand::value elem{};
+                    check_syntax(std::move(elem_result).get(elem));
+                    container.push_back(parse_arg<typename no_ref_t::value_type>(elem));
+                }
+
+                return container;
+            }
+            else if constexpr (detail::is_tuple_v<no_ref_t>)
+            {
+                simdjson::ondemand::array arr{};
+                check(val.get_array().get(arr), "array", val);
+
+                simdjson::ondemand::array_iterator it{};
+                simdjson::ondemand::array_iterator end{};
+                check_syntax(arr.begin().get(it));
+                check_syntax(arr.end().get(end));
+
+                no_ref_t container{};
+
+                detail::for_each_tuple(container,
+                    [&it, &end](auto& elem) { elem = parse_args<decltype(elem)>(it, end); });
+
+                return container;
+            }
+            else if constexpr (detail::is_serializable_v<simdjson_adapter, no_ref_t>)
+            {
+                std::string_view raw{};
+                check_syntax(val.raw_json().get(raw));
+                return no_ref_t::template deserialize<simdjson_adapter>(
+                    simdjson_message{ std::string{ raw }, {} });
+            }
+            else if constexpr (detail::is_reflected_v<no_ref_t>)
+            {
+                simdjson::ondemand::object obj{};
+                check(val.get_object().get(obj), "object", val);
+
+                no_ref_t ret{};
+                std::array<bool, detail::field_count_v<no_ref_t>> found{};
+
+                // Fields may arrive in any order, unknown ones are skipped
+                for (auto field_result : obj)
+                {
+                    simdjson::ondemand::field fld{};
+                    check_syntax(std::move(field_result).get(fld));
+
+                    std::string_view key{};
+                    check_syntax(fld.unescaped_key().get(key));
+                    size_t index = 0;
+                    bool matched = false;
+
+                    detail::for_each_field(ret,
+                        [&fld, key, &found, &index, &matched](
+                            const std::string_view name, auto& field)
+                        {
+                            if (!matched && name == key)
+                            {
+                                using field_t = std::remove_reference_t<decltype(field)>;
+                                field = parse_arg<field_t>(fld.value());
+
+                                found[index] = true;
+                                matched = true;
+                            }
+
+                            ++index;
+                        });
+                }
+
+                for (size_t i = 0; i < found.size(); ++i)
+                {
+                    if (!found[i])
+                    {
+                        throw function_mismatch("simdjson missing field: "
+                            + std::string{ detail::field_names_v<no_ref_t>[i] });
+                    }
+                }
+
+                return ret;
+            }
+            else
+            {
+                return deserialize<no_ref_t>(val);
+            }
+        }
+
+        // nodiscard because parsing can be expensive, and it makes no sense to not use the parsed result
+        template<typename C>
+        [[nodiscard]] static C parse_bulk(simdjson::ondemand::value& val)
+        {
+            std::string_view text{};
+            check(val.get_string().get(text), "base64 string", val);
+
+            const auto byte_size = detail::base64_decoded_size(text);
+
+            if (!byte_size.has_value())
+            {
+                throw function_mismatch(
+                    std::string{ "simdjson expected base64 data of type: " } + typeid(C).name());
+            }
+
+            C container{};
+
+            if (!detail::base64_decode(text, detail::resize_bulk(container, *byte_size)))
+            {
+                throw function_mismatch(
+                    std::string{ "simdjson expected base64 data of type: " } + typeid(C).name());
+            }
+
+            return container;
+        }
+
+        // Parses the element at it and moves past it, elements after the expected ones are skipped
+        // nodiscard because parsing can be expensive, and it makes no sense to not use the parsed result
+        template<typename T>
+        [[nodiscard]] static std::remove_cv_t<std::remove_reference_t<T>> parse_args(
+            simdjson::ondemand::array_iterator& it, const simdjson::ondemand::array_iterator& end)
+        {
+            if (it == end)
+            {
+                throw function_mismatch("Argument count mismatch");
+            }
+
+            simdjson::ondemand::value elem{};
+            check_syntax((*it).get(elem));
+            auto ret = parse_arg<T>(elem);
+            ++it;
+            return ret;
+        }
+    };
+} // namespace adapters
+} // namespace rpc_hpp
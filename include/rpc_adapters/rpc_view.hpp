@@ -0,0 +1,1010 @@
+///@file rpc_adapters/rpc_view.hpp
+///@author Jackson Harmer (jharmer95@gmail.com)
+///@brief Implementation of a zero-copy binary adapter whose arguments can be read in place
+///
+///@copyright
+///BSD 3-Clause License
+///
+///Copyright (c) 2020-2022, Jackson Harmer
+///All rights reserved.
+///
+///Redistribution and use in source and binary forms, with or without
+///modification, are permitted provided that the following conditions are met:
+///
+///1. Redistributions of source code must retain the above copyright notice, this
+///   list of conditions and the following disclaimer.
+///
+///2. Redistributions in binary form must reproduce the above copyright notice,
+///   this list of conditions and the following disclaimer in the documentation
+///   and/or other materials provided with the distribution.
+///
+///3. Neither the name of the copyright holder nor the names of its
+///   contributors may be used to endorse or promote products derived from
+///   this software without specific prior written permission.
+///
+///THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+///AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+///IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+///DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+///FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+///DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+///SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+///CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+///OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+///OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+///
+
+
+#pragma once
+
+#include "../rpc.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string_view>
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ != __ORDER_LITTLE_ENDIAN__
+#    error "rpc_view.hpp reads values in place and requires a little-endian target"
+#endif
+
+namespace rpc_hpp
+{
+namespace adapters
+{
+    ///@brief Read-only view of contiguous arithmetic values stored in a received message
+    ///
+    ///@note Like @c std::string_view arguments, an array_view is only valid for the duration of the
+    /// bound function call, and cannot be used as a return type
+    ///@tparam T Arithmetic element type
+    template<typename T>
+    class array_view
+    {
+        static_assert(std::is_arithmetic_v<T> && !std::is_same_v<T, bool>,
+            "array_view only supports non-bool arithmetic types");
+
+    public:
+        using value_type = T;
+        using const_iterator = const T*;
+        using iterator = const_iterator;
+
+        constexpr array_view() noexcept = default;
+        constexpr array_view(const T* data, const size_t size) noexcept : m_data(data), m_size(size)
+        {
+        }
+
+        [[nodiscard]] constexpr const T* data() const noexcept { return m_data; }
+        [[nodiscard]] constexpr size_t size() const noexcept { return m_size; }
+        [[nodiscard]] constexpr bool empty() const noexcept { return m_size == 0; }
+        [[nodiscard]] constexpr const_iterator begin() const noexcept { return m_data; }
+        [[nodiscard]] constexpr const_iterator end() const noexcept { return m_data + m_size; }
+        [[nodiscard]] constexpr const T& operator[](const size_t index) const noexcept
+        {
+            return m_data[index];
+        }
+
+    private:
+        const T* m_data{ nullptr };
+        size_t m_size{ 0 };
+    };
+
+    ///@brief Argument types that point into the received message instead of owning their data
+    template<typename T>
+    inline constexpr bool is_view_v = std::is_same_v<T, std::string_view>;
+
+    template<typename T>
+    inline constexpr bool is_view_v<array_view<T>> = true;
+
+    // Types the view format has no encoding for
+    template<typename T>
+    inline constexpr bool is_view_unsupported_v = detail::is_optional_v<T> || detail::is_variant_v<T>
+        || detail::is_map_v<T> || detail::is_set_v<T>;
+
+    template<typename C, typename = void>
+    struct is_contiguous : std::false_type
+    {
+    };
+
+    template<typename C>
+    struct is_contiguous<C,
+        std::void_t<decltype(std::declval<const C&>().data() + std::declval<const C&>().size())>> :
+        std::true_type
+    {
+    };
+
+    enum class view_kind : uint8_t
+    {
+        none,
+        boolean,
+        signed_int,
+        unsigned_int,
+        floating,
+        string,
+        array,
+        list,
+    };
+
+    template<typename T>
+    [[nodiscard]] constexpr view_kind view_kind_of() noexcept
+    {
+        if constexpr (std::is_same_v<T, bool>)
+        {
+            return view_kind::boolean;
+        }
+        else if constexpr (std::is_floating_point_v<T>)
+        {
+            return view_kind::floating;
+        }
+        else if constexpr (std::is_signed_v<T>)
+        {
+            return view_kind::signed_int;
+        }
+        else
+        {
+            return view_kind::unsigned_int;
+        }
+    }
+
+    ///@brief Location and type of a single value in a view message
+    ///
+    ///@details Offsets are absolute within the message. Lists store a uint32 count followed by
+    /// their entry table, arrays store their elements contiguously (aligned to the element size)
+    struct view_entry
+    {
+        uint32_t offset{};
+        uint32_t size{};
+        view_kind kind{ view_kind::none };
+        view_kind elem_kind{ view_kind::none };
+        uint16_t elem_size{};
+    };
+
+    static_assert(sizeof(view_entry) == 12, "view_entry must have no padding");
+
+    class view_adapter;
+
+    ///@brief Typed, bounds-checked access to a value in a view message
+    class view_node
+    {
+    public:
+        view_node(const std::string_view buffer, const view_entry& entry) noexcept
+            : m_buffer(buffer), m_entry(entry)
+        {
+        }
+
+        [[nodiscard]] view_kind kind() const noexcept { return m_entry.kind; }
+        [[nodiscard]] const view_entry& entry() const noexcept { return m_entry; }
+
+        ///@brief Returns the number of elements of a list or array (or characters of a string)
+        [[nodiscard]] size_t size() const noexcept
+        {
+            switch (m_entry.kind)
+            {
+                case view_kind::list:
+                    return read_count();
+
+                case view_kind::array:
+                    return m_entry.size / m_entry.elem_size;
+
+                case view_kind::string:
+                    return m_entry.size;
+
+                case view_kind::none:
+                    return 0;
+
+                default:
+                    return 1;
+            }
+        }
+
+        ///@brief Returns the element at index of a list
+        [[nodiscard]] view_node operator[](const size_t index) const
+        {
+            if (m_entry.kind != view_kind::list)
+            {
+                throw function_mismatch(mismatch_string("list"));
+            }
+
+            if (index >= read_count())
+            {
+                throw function_mismatch("Argument count mismatch");
+            }
+
+            view_entry child{};
+            memcpy(&child, m_buffer.data() + m_entry.offset + sizeof(uint32_t)
+                    + index * sizeof(view_entry),
+                sizeof(view_entry));
+
+            return { m_buffer, child };
+        }
+
+        ///@brief Parses the value as T, pointing into the message for view types
+        template<typename T>
+        [[nodiscard]] T as() const;
+
+        [[nodiscard]] std::string mismatch_string(const std::string& expect_type) const
+        {
+            return "view expected type: " + expect_type + ", got type: " + kind_name(m_entry.kind);
+        }
+
+        [[nodiscard]] static const char* kind_name(const view_kind kind) noexcept
+        {
+            switch (kind)
+            {
+                case view_kind::boolean:
+                    return "bool";
+
+                case view_kind::signed_int:
+                    return "signed integer";
+
+                case view_kind::unsigned_int:
+                    return "unsigned integer";
+
+                case view_kind::floating:
+                    return "float";
+
+                case view_kind::string:
+                    return "string";
+
+                case view_kind::array:
+                    return "array";
+
+                case view_kind::list:
+                    return "list";
+
+                case view_kind::none:
+                default:
+                    return "none";
+            }
+        }
+
+    private:
+        [[nodiscard]] const char* payload() const noexcept
+        {
+            return m_buffer.data() + m_entry.offset;
+        }
+
+        [[nodiscard]] uint32_t read_count() const noexcept
+        {
+            uint32_t count{};
+            memcpy(&count, payload(), sizeof(count));
+            return count;
+        }
+
+        template<typename T>
+        [[nodiscard]] T read_scalar() const
+        {
+            const auto read = [this](auto tag) noexcept
+            {
+                decltype(tag) val{};
+                memcpy(&val, payload(), sizeof(val));
+
+                if constexpr (std::is_same_v<T, decltype(tag)>)
+                {
+                    return val;
+                }
+                else
+                {
+                    return static_cast<T>(val);
+                }
+            };
+
+            switch (m_entry.kind)
+            {
+                case view_kind::signed_int:
+                    switch (m_entry.elem_size)
+                    {
+                        case 1:
+                            return read(int8_t{});
+
+                        case 2:
+                            return read(int16_t{});
+
+                        case 4:
+                            return read(int32_t{});
+
+                        default:
+                            return read(int64_t{});
+                    }
+
+                case view_kind::unsigned_int:
+                    switch (m_entry.elem_size)
+                    {
+                        case 1:
+                            return read(uint8_t{});
+
+                        case 2:
+                            return read(uint16_t{});
+
+                        case 4:
+                            return read(uint32_t{});
+
+                        default:
+                            return read(uint64_t{});
+                    }
+
+                case view_kind::floating:
+                    return m_entry.elem_size == sizeof(float) ? read(float{}) : read(double{});
+
+                default:
+                    throw function_mismatch(mismatch_string(typeid(T).name()));
+            }
+        }
+
+        std::string_view m_buffer;
+        view_entry m_entry;
+    };
+
+    ///@brief Appends values to a view message
+    class view_writer
+    {
+    public:
+        explicit view_writer(std::string& buffer) noexcept : m_buffer(buffer) {}
+
+        ///@brief Writes a single value, returning its entry
+        template<typename T>
+        view_entry write(const T& val);
+
+        ///@brief Writes the values as a list, returning its entry
+        template<typename... Ts>
+        view_entry write_list(const Ts&... vals)
+        {
+            const auto table = begin_list(sizeof...(Ts));
+            [[maybe_unused]] size_t index = 0;
+            (set_entry(table, index++, write(vals)), ...);
+            return end_list(table);
+        }
+
+    private:
+        friend class view_adapter;
+
+        // Every payload starts on an 8-byte boundary so arrays can be read in place
+        size_t align()
+        {
+            m_buffer.resize((m_buffer.size() + 7U) & ~size_t{ 7U }, '\0');
+            return check_offset(m_buffer.size());
+        }
+
+        static uint32_t check_offset(const size_t offset)
+        {
+            if (offset > std::numeric_limits<uint32_t>::max())
+            {
+                throw serialization_error("view: message exceeds 4 GiB");
+            }
+
+            return static_cast<uint32_t>(offset);
+        }
+
+        view_entry append(const void* data, const size_t size, const view_kind kind,
+            const view_kind elem_kind, const size_t elem_size)
+        {
+            const auto offset = align();
+            m_buffer.append(static_cast<const char*>(data), size);
+
+            return { check_offset(offset), check_offset(size), kind, elem_kind,
+                static_cast<uint16_t>(elem_size) };
+        }
+
+        size_t begin_list(const size_t count)
+        {
+            const auto table = align();
+            const auto count32 = check_offset(count);
+            m_buffer.append(reinterpret_cast<const char*>(&count32), sizeof(count32));
+            m_buffer.append(count * sizeof(view_entry), '\0');
+            return table;
+        }
+
+        view_entry end_list(const size_t table) const
+        {
+            return { check_offset(table), check_offset(m_buffer.size() - table), view_kind::list,
+                view_kind::none, 0 };
+        }
+
+        void set_entry(const size_t table, const size_t index, const view_entry& entry)
+        {
+            memcpy(&m_buffer[table + sizeof(uint32_t) + index * sizeof(view_entry)], &entry,
+                sizeof(view_entry));
+        }
+
+        std::string& m_buffer;
+    };
+
+    ///@brief Serialized view message
+    ///
+    ///@details Layout: a uint32 magic number, the uint32 total size, then the root list, whose
+    /// entries are the fields below (absent fields have kind none)
+    struct view_message
+    {
+        enum field : size_t
+        {
+            func_name,
+            args,
+            result,
+            except_type,
+            err_mesg,
+            field_count,
+        };
+
+        static constexpr uint32_t magic = 0x31565052U; // "RPV1"
+        static constexpr size_t root_offset = 2 * sizeof(uint32_t);
+        static constexpr size_t min_size =
+            root_offset + sizeof(uint32_t) + field_count * sizeof(view_entry);
+
+        [[nodiscard]] view_node root() const noexcept
+        {
+            return { bytes,
+                view_entry{ static_cast<uint32_t>(root_offset),
+                    static_cast<uint32_t>(bytes.size() - root_offset), view_kind::list,
+                    view_kind::none, 0 } };
+        }
+
+        [[nodiscard]] view_node get(const field fld) const { return root()[fld]; }
+        [[nodiscard]] bool has(const field fld) const { return get(fld).kind() != view_kind::none; }
+
+        std::string bytes{};
+    };
+
+    template<>
+    struct serial_traits<view_adapter>
+    {
+        using serial_t = view_message;
+        using bytes_t = std::string;
+    };
+
+    class view_adapter : public detail::serial_adapter_base<view_adapter>
+    {
+    public:
+        [[nodiscard]] static std::string to_bytes(view_message&& serial_obj)
+        {
+            return std::move(serial_obj.bytes);
+        }
+
+        ///@brief Hands the message's buffer over to out, giving out's previous buffer to the thread's buffer_pool
+        static void to_bytes(view_message&& serial_obj, std::string& out)
+        {
+            out.swap(serial_obj.bytes);
+            recycle(std::move(serial_obj));
+        }
+
+        ///@brief Gives the message's buffer back to the thread's buffer_pool
+        static void recycle(view_message&& serial_obj) noexcept
+        {
+            buffer_pool<std::string>::local().release(std::move(serial_obj.bytes));
+        }
+
+        ///@brief Whether a message in this format can start with byte (lets multi_server recognize the format)
+        [[nodiscard]] static bool may_start_with(const uint8_t byte) noexcept
+        {
+            // First byte of the magic number, as written in native byte order
+            uint8_t first{};
+            memcpy(&first, &view_message::magic, sizeof(first));
+            return byte == first;
+        }
+
+        [[nodiscard]] static std::optional<view_message> from_bytes(std::string&& bytes)
+        {
+            view_message msg{ std::move(bytes) };
+
+            if (!validate(msg.bytes))
+            {
+                return std::nullopt;
+            }
+
+            if (const auto ex_node = msg.get(view_message::except_type);
+                ex_node.kind() != view_kind::none)
+            {
+                if (ex_node.kind() != view_kind::signed_int
+                    || (ex_node.as<int>() != 0 && !msg.has(view_message::err_mesg)))
+                {
+                    return std::nullopt;
+                }
+
+                // Objects with exceptions can be otherwise empty
+                return std::make_optional(std::move(msg));
+            }
+
+            if (const auto name_node = msg.get(view_message::func_name);
+                name_node.kind() != view_kind::string || name_node.size() == 0)
+            {
+                return std::nullopt;
+            }
+
+            if (msg.get(view_message::args).kind() != view_kind::list)
+            {
+                return std::nullopt;
+            }
+
+            return std::make_optional(std::move(msg));
+        }
+
+        static view_message empty_object()
+        {
+            view_message msg{};
+            view_writer writer = begin_message(msg);
+            writer.end_list(writer.begin_list(view_message::field_count));
+            end_message(msg);
+            return msg;
+        }
+
+        template<typename R, typename... Args>
+        [[nodiscard]] static view_message serialize_pack(
+            const detail::packed_func<R, Args...>& pack)
+        {
+            view_message msg{};
+            view_writer writer = begin_message(msg, pack.get_func_name());
+            const auto root = writer.begin_list(view_message::field_count);
+
+            writer.set_entry(root, view_message::func_name, writer.write(pack.get_func_name()));
+            writer.set_entry(root, view_message::args, writer.write(pack.get_args()));
+
+            if (!pack)
+            {
+                writer.set_entry(root, view_message::except_type,
+                    writer.write(static_cast<int>(pack.get_except_type())));
+
+                writer.set_entry(root, view_message::err_mesg, writer.write(pack.get_err_mesg()));
+            }
+            else if constexpr (!std::is_void_v<R>)
+            {
+                writer.set_entry(root, view_message::result, writer.write(pack.get_result()));
+            }
+
+            end_message(msg);
+            return msg;
+        }
+
+        template<typename R, typename... Args>
+        [[nodiscard]] static detail::packed_func<R, Args...> deserialize_pack(
+            const view_message& serial_obj)
+        {
+            static_assert(!is_view_v<R>, "views into a message cannot be returned");
+
+            auto args = parse_args<typename detail::packed_func<R, Args...>::args_t>(
+                serial_obj.get(view_message::args), std::index_sequence_for<Args...>{});
+
+            auto func_name = get_func_name(serial_obj);
+
+            if constexpr (std::is_void_v<R>)
+            {
+                detail::packed_func<void, Args...> pack(std::move(func_name), std::move(args));
+
+                if (serial_obj.has(view_message::except_type))
+                {
+                    const auto ex = extract_exception(serial_obj);
+                    pack.set_exception(ex.what(), ex.get_type());
+                }
+
+                return pack;
+            }
+            else
+            {
+                if (const auto result_node = serial_obj.get(view_message::result);
+                    result_node.kind() != view_kind::none)
+                {
+                    return detail::packed_func<R, Args...>(
+                        std::move(func_name), result_node.as<R>(), std::move(args));
+                }
+
+                detail::packed_func<R, Args...> pack(
+                    std::move(func_name), std::nullopt, std::move(args));
+
+                if (serial_obj.has(view_message::except_type))
+                {
+                    const auto ex = extract_exception(serial_obj);
+                    pack.set_exception(ex.what(), ex.get_type());
+                }
+
+                return pack;
+            }
+        }
+
+        [[nodiscard]] static std::string get_func_name(const view_message& serial_obj)
+        {
+            if (const auto name_node = serial_obj.get(view_message::func_name);
+                name_node.kind() == view_kind::string)
+            {
+                return name_node.as<std::string>();
+            }
+
+            return {};
+        }
+
+        [[nodiscard]] static rpc_exception extract_exception(const view_message& serial_obj)
+        {
+            return rpc_exception{ serial_obj.get(view_message::err_mesg).as<std::string>(),
+                static_cast<exception_type>(serial_obj.get(view_message::except_type).as<int>()) };
+        }
+
+        // Appends the new fields and repoints the root entries, leaving the rest of the message
+        static void set_exception(view_message& serial_obj, const rpc_exception& ex)
+        {
+            view_writer writer{ serial_obj.bytes };
+            const auto ex_entry = writer.write(static_cast<int>(ex.get_type()));
+            const auto mesg_entry = writer.write(std::string_view{ ex.what() });
+            writer.set_entry(view_message::root_offset, view_message::except_type, ex_entry);
+            writer.set_entry(view_message::root_offset, view_message::err_mesg, mesg_entry);
+            end_message(serial_obj);
+        }
+
+        template<typename T>
+        static view_entry serialize(const T& val, view_writer& writer) = delete;
+
+        template<typename T>
+        static T deserialize(const view_node& node) = delete;
+
+    private:
+        // Guards against malicious input, as values are later read in place without further checks
+        static constexpr unsigned max_depth = 64;
+
+        template<typename Tuple, size_t... Is>
+        [[nodiscard]] static Tuple parse_args(
+            [[maybe_unused]] const view_node& args_node, std::index_sequence<Is...>)
+        {
+            return Tuple{ args_node[Is].template as<std::tuple_element_t<Is, Tuple>>()... };
+        }
+
+        static view_writer begin_message(view_message& msg, const std::string_view func_name = {})
+        {
+            msg.bytes = buffer_pool<std::string>::local().acquire(
+                detail::message_size_hints::get(func_name));
+
+            msg.bytes.append(reinterpret_cast<const char*>(&view_message::magic), sizeof(uint32_t));
+            msg.bytes.append(sizeof(uint32_t), '\0');
+            return view_writer{ msg.bytes };
+        }
+
+        static void end_message(view_message& msg)
+        {
+            const auto size = view_writer::check_offset(msg.bytes.size());
+            memcpy(&msg.bytes[sizeof(uint32_t)], &size, sizeof(size));
+        }
+
+        [[nodiscard]] static bool validate(const std::string_view bytes) noexcept
+        {
+            if (bytes.size() < view_message::min_size
+                || bytes.size() > std::numeric_limits<uint32_t>::max())
+            {
+                return false;
+            }
+
+            uint32_t magic{};
+            uint32_t size{};
+            uint32_t count{};
+            memcpy(&magic, bytes.data(), sizeof(magic));
+            memcpy(&size, bytes.data() + sizeof(magic), sizeof(size));
+            memcpy(&count, bytes.data() + view_message::root_offset, sizeof(count));
+
+            if (magic != view_message::magic || size != bytes.size()
+                || count != view_message::field_count)
+            {
+                return false;
+            }
+
+            return validate_list(bytes,
+                view_entry{ static_cast<uint32_t>(view_message::root_offset),
+                    static_cast<uint32_t>(bytes.size() - view_message::root_offset),
+                    view_kind::list, view_kind::none, 0 },
+                0);
+        }
+
+        [[nodiscard]] static constexpr bool valid_width(
+            const view_kind kind, const size_t width) noexcept
+        {
+            switch (kind)
+            {
+                case view_kind::signed_int:
+                case view_kind::unsigned_int:
+                    return width == 1 || width == 2 || width == 4 || width == 8;
+
+                case view_kind::floating:
+                    return width == sizeof(float) || width == sizeof(double);
+
+                default:
+                    return false;
+            }
+        }
+
+        // Children must lie within their parent (after its entry table), so the walk terminates
+        [[nodiscard]] static bool validate_list(
+            const std::string_view bytes, const view_entry& list, const unsigned depth) noexcept
+        {
+            if (depth > max_depth || list.offset % alignof(uint32_t) != 0
+                || list.size < sizeof(uint32_t))
+            {
+                return false;
+            }
+
+            uint32_t count{};
+            memcpy(&count, bytes.data() + list.offset, sizeof(count));
+
+            if (count > (list.size - sizeof(uint32_t)) / sizeof(view_entry))
+            {
+                return false;
+            }
+
+            const size_t data_begin = list.offset + sizeof(uint32_t) + count * sizeof(view_entry);
+            const size_t data_end = size_t{ list.offset } + list.size;
+
+            for (size_t i = 0; i < count; ++i)
+            {
+                view_entry child{};
+                memcpy(&child,
+                    bytes.data() + list.offset + sizeof(uint32_t) + i * sizeof(view_entry),
+                    sizeof(view_entry));
+
+                if (child.kind == view_kind::none)
+                {
+                    continue;
+                }
+
+                if (child.offset < data_begin || child.offset > data_end
+                    || child.size > data_end - child.offset)
+                {
+                    return false;
+                }
+
+                switch (child.kind)
+                {
+                    case view_kind::boolean:
+                        if (child.size != 1)
+                        {
+                            return false;
+                        }
+
+                        break;
+
+                    case view_kind::signed_int:
+                    case view_kind::unsigned_int:
+                    case view_kind::floating:
+                        if (!valid_width(child.kind, child.elem_size)
+                            || child.size != child.elem_size)
+                        {
+                            return false;
+                        }
+
+                        break;
+
+                    case view_kind::string:
+                        break;
+
+                    case view_kind::array:
+                        if (!valid_width(child.elem_kind, child.elem_size)
+                            || child.size % child.elem_size != 0
+                            || child.offset % child.elem_size != 0)
+                        {
+                            return false;
+                        }
+
+                        break;
+
+                    case view_kind::list:
+                        if (!validate_list(bytes, child, depth + 1))
+                        {
+                            return false;
+                        }
+
+                        break;
+
+                    case view_kind::none:
+                    default:
+                        return false;
+                }
+            }
+
+            return true;
+        }
+    };
+
+    template<typename T>
+    view_entry view_writer::write(const T& val)
+    {
+        using no_ref_t = std::remove_cv_t<std::remove_reference_t<T>>;
+        static_assert(!is_view_unsupported_v<no_ref_t>,
+            "view_adapter does not support maps, sets, optionals, or variants, use another adapter "
+            "for this function");
+
+        if constexpr (std::is_arithmetic_v<no_ref_t>)
+        {
+            static_assert(!std::is_same_v<no_ref_t, long double>,
+                "long double is not supported for RPC view serialization!");
+
+            return append(&val, sizeof(no_ref_t), view_kind_of<no_ref_t>(), view_kind::none,
+                sizeof(no_ref_t));
+        }
+        else if constexpr (std::is_same_v<no_ref_t, std::string>
+            || std::is_same_v<no_ref_t, std::string_view>)
+        {
+            return append(val.data(), val.size(), view_kind::string, view_kind::none, 0);
+        }
+        else if constexpr (detail::is_container_v<no_ref_t>)
+        {
+            using value_t = typename no_ref_t::value_type;
+
+            if constexpr (std::is_arithmetic_v<value_t> && !std::is_same_v<value_t, bool>
+                && is_contiguous<no_ref_t>::value)
+            {
+                return append(val.data(), val.size() * sizeof(value_t), view_kind::array,
+                    view_kind_of<value_t>(), sizeof(value_t));
+            }
+            else
+            {
+                const auto table = begin_list(val.size());
+                size_t index = 0;
+
+                for (const auto& elem : val)
+                {
+                    set_entry(table, index++, write(static_cast<const value_t&>(elem)));
+                }
+
+                return end_list(table);
+            }
+        }
+        else if constexpr (detail::is_tuple_v<no_ref_t>)
+        {
+            return std::apply([this](const auto&... elems) { return write_list(elems...); }, val);
+        }
+        else if constexpr (detail::is_reflected_v<no_ref_t>)
+        {
+            // Fields are positional, like a tuple
+            return std::apply([this](const auto&... fields) { return write_list(fields...); },
+                rpc_hpp_fields(val));
+        }
+        else
+        {
+            return view_adapter::serialize<no_ref_t>(val, *this);
+        }
+    }
+
+    template<typename T>
+    T view_node::as() const
+    {
+        using no_ref_t = std::remove_cv_t<std::remove_reference_t<T>>;
+        static_assert(!is_view_unsupported_v<no_ref_t>,
+            "view_adapter does not support maps, sets, optionals, or variants, use another adapter "
+            "for this function");
+
+        if constexpr (std::is_same_v<no_ref_t, bool>)
+        {
+            if (m_entry.kind != view_kind::boolean)
+            {
+                throw function_mismatch(mismatch_string("bool"));
+            }
+
+            return *payload() != 0;
+        }
+        else if constexpr (std::is_integral_v<no_ref_t>)
+        {
+            if (m_entry.kind != view_kind::signed_int && m_entry.kind != view_kind::unsigned_int)
+            {
+                throw function_mismatch(mismatch_string(typeid(no_ref_t).name()));
+            }
+
+            return read_scalar<no_ref_t>();
+        }
+        else if constexpr (std::is_floating_point_v<no_ref_t>)
+        {
+            if (m_entry.kind != view_kind::floating)
+            {
+                throw function_mismatch(mismatch_string(typeid(no_ref_t).name()));
+            }
+
+            return read_scalar<no_ref_t>();
+        }
+        else if constexpr (std::is_same_v<no_ref_t, std::string>
+            || std::is_same_v<no_ref_t, std::string_view>)
+        {
+            if (m_entry.kind != view_kind::string)
+            {
+                throw function_mismatch(mismatch_string("string"));
+            }
+
+            return no_ref_t(payload(), m_entry.size);
+        }
+        else if constexpr (is_view_v<no_ref_t>)
+        {
+            using value_t = typename no_ref_t::value_type;
+
+            if (m_entry.kind != view_kind::array || m_entry.elem_kind != view_kind_of<value_t>()
+                || m_entry.elem_size != sizeof(value_t))
+            {
+                throw function_mismatch(mismatch_string(typeid(no_ref_t).name()));
+            }
+
+            if (reinterpret_cast<uintptr_t>(payload()) % alignof(value_t) != 0)
+            {
+                throw deserialization_error("view: misaligned message buffer");
+            }
+
+            return no_ref_t(reinterpret_cast<const value_t*>(payload()), size());
+        }
+        else if constexpr (detail::is_container_v<no_ref_t>)
+        {
+            using value_t = typename no_ref_t::value_type;
+
+            no_ref_t container{};
+
+            if constexpr (std::is_arithmetic_v<value_t> && !std::is_same_v<value_t, bool>)
+            {
+                if (m_entry.kind != view_kind::array
+                    || m_entry.elem_kind != view_kind_of<value_t>()
+                    || m_entry.elem_size != sizeof(value_t))
+                {
+                    throw function_mismatch(mismatch_string(typeid(no_ref_t).name()));
+                }
+
+                // data() may be null for an empty container
+                if constexpr (detail::is_fixed_extent_v<no_ref_t>)
+                {
+                    detail::check_extent<no_ref_t>(size());
+
+                    if constexpr (std::tuple_size_v<no_ref_t> != 0)
+                    {
+                        memcpy(container.data(), payload(), m_entry.size);
+                    }
+                }
+                else
+                {
+                    container.resize(size());
+
+                    if (m_entry.size != 0)
+                    {
+                        memcpy(container.data(), payload(), m_entry.size);
+                    }
+                }
+            }
+            else if constexpr (detail::is_fixed_extent_v<no_ref_t>)
+            {
+                detail::check_extent<no_ref_t>(size());
+
+                for (size_t i = 0; i < container.size(); ++i)
+                {
+                    container[i] = (*this)[i].template as<value_t>();
+                }
+            }
+            else
+            {
+                const auto count = size();
+                container.reserve(count);
+
+                for (size_t i = 0; i < count; ++i)
+                {
+                    container.push_back((*this)[i].template as<value_t>());
+                }
+            }
+
+            return container;
+        }
+        else if constexpr (detail::is_tuple_v<no_ref_t>)
+        {
+            no_ref_t tuple{};
+            size_t index = 0;
+
+            detail::for_each_tuple(tuple,
+                [this, &index](auto& elem)
+                {
+                    elem = (*this)[index++]
+                               .template as<std::remove_reference_t<decltype(elem)>>();
+                });
+
+            return tuple;
+        }
+        else if constexpr (detail::is_reflected_v<no_ref_t>)
+        {
+            no_ref_t val{};
+            size_t index = 0;
+
+            detail::for_each_field(val,
+                [this, &index](std::string_view, auto& field)
+                {
+                    field = (*this)[index++]
+                                .template as<std::remove_reference_t<decltype(field)>>();
+                });
+
+            return val;
+        }
+        else
+        {
+            return view_adapter::deserialize<no_ref_t>(*this);
+        }
+    }
+} // namespace adapters
+} // namespace rpc_hpp
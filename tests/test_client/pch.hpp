@@ -39,3 +39,7 @@
 #    include <rapidjson/stringbuffer.h>
 #    include <rapidjson/writer.h>
 #endif
+
+#if defined(RPC_HPP_ENABLE_SIMDJSON)
+#    include <simdjson.h>
+#endif
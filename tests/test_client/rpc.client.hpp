@@ -50,10 +50,18 @@ using rpc_hpp::adapters::bitsery_adapter;
 using rpc_hpp::adapters::boost_json_adapter;
 #endif
 
+#if defined(RPC_HPP_ENABLE_MSGPACK)
+#    include <rpc_adapters/rpc_msgpack.hpp>
+
+using rpc_hpp::adapters::msgpack_adapter;
+#endif
+
 #if defined(RPC_HPP_ENABLE_NJSON)
 #    include <rpc_adapters/rpc_njson.hpp>
 
 using rpc_hpp::adapters::njson_adapter;
+using rpc_hpp::adapters::njson_cbor_adapter;
+using rpc_hpp::adapters::njson_text_adapter;
 #endif
 
 #if defined(RPC_HPP_ENABLE_RAPIDJSON)
@@ -62,6 +70,24 @@ using rpc_hpp::adapters::njson_adapter;
 using rpc_hpp::adapters::rapidjson_adapter;
 #endif
 
+#if defined(RPC_HPP_ENABLE_RAW)
+#    include <rpc_adapters/rpc_raw.hpp>
+
+using rpc_hpp::adapters::raw_adapter;
+#endif
+
+#if defined(RPC_HPP_ENABLE_SIMDJSON)
+#    include <rpc_adapters/rpc_simdjson.hpp>
+
+using rpc_hpp::adapters::simdjson_adapter;
+#endif
+
+#if defined(RPC_HPP_ENABLE_VIEW)
+#    include <rpc_adapters/rpc_view.hpp>
+
+using rpc_hpp::adapters::view_adapter;
+#endif
+
 using asio::ip::tcp;
 
 template<typename Serial>
@@ -82,14 +108,15 @@ public:
 
     void send(const typename Serial::bytes_t& mesg) override
     {
-        asio::write(m_socket, asio::buffer(mesg, mesg.size()));
+        asio::write(m_socket, asio::buffer(mesg.data(), mesg.size()));
     }
 
     // nodiscard because data is lost after receive
     [[nodiscard]] typename Serial::bytes_t receive() override
     {
         const auto sz = m_socket.read_some(asio::buffer(m_buffer, m_buffer.size()));
-        return typename Serial::bytes_t{ m_buffer.begin(), m_buffer.begin() + sz };
+        return rpc_hpp::buffer_pool<typename Serial::bytes_t>::local().acquire(
+            m_buffer.begin(), m_buffer.begin() + sz);
     }
 
 private:
@@ -135,3 +162,63 @@ template<>
     return client;
 }
 #endif
+
+#if defined(RPC_HPP_ENABLE_MSGPACK)
+template<>
+[[nodiscard]] inline TestClient<msgpack_adapter>& GetClient()
+{
+    static TestClient<msgpack_adapter> client("127.0.0.1", "5004");
+    return client;
+}
+#endif
+
+#if defined(RPC_HPP_ENABLE_VIEW)
+template<>
+[[nodiscard]] inline TestClient<view_adapter>& GetClient()
+{
+    static TestClient<view_adapter> client("127.0.0.1", "5005");
+    return client;
+}
+#endif
+
+#if defined(RPC_HPP_ENABLE_RAW)
+template<>
+[[nodiscard]] inline TestClient<raw_adapter>& GetClient()
+{
+    static TestClient<raw_adapter> client("127.0.0.1", "5006");
+    return client;
+}
+#endif
+
+#if defined(RPC_HPP_ENABLE_SIMDJSON)
+template<>
+[[nodiscard]] inline TestClient<simdjson_adapter>& GetClient()
+{
+    static TestClient<simdjson_adapter> client("127.0.0.1", "5007");
+    return client;
+}
+#endif
+
+#if defined(RPC_HPP_ENABLE_NJSON)
+template<>
+[[nodiscard]] inline TestClient<njson_cbor_adapter>& GetClient()
+{
+    static TestClient<njson_cbor_adapter> client("127.0.0.1", "5008");
+    return client;
+}
+
+template<>
+[[nodiscard]] inline TestClient<njson_text_adapter>& GetClient()
+{
+    static TestClient<njson_text_adapter> client("127.0.0.1", "5009");
+    return client;
+}
+
+// Client of the server serving every njson format on a single port
+template<typename Serial>
+[[nodiscard]] inline TestClient<Serial>& GetMultiClient()
+{
+    static TestClient<Serial> client("127.0.0.1", "5010");
+    return client;
+}
+#endif
@@ -40,6 +40,12 @@
 #include "../test_structs.hpp"
 #include "../static_funcs.hpp"
 
+#include <array>
+#include <map>
+#include <optional>
+#include <set>
+#include <variant>
+
 #define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
 #include <doctest/doctest.h>
 
@@ -63,6 +69,16 @@ TEST_CASE("NJSON")
 {
     TestType<njson_adapter>();
 }
+
+TEST_CASE("NJSON_CBOR")
+{
+    TestType<njson_cbor_adapter>();
+}
+
+TEST_CASE("NJSON_TEXT")
+{
+    TestType<njson_text_adapter>();
+}
 #endif
 
 #if defined(RPC_HPP_ENABLE_RAPIDJSON)
@@ -86,6 +102,34 @@ TEST_CASE("BITSERY")
 }
 #endif
 
+#if defined(RPC_HPP_ENABLE_MSGPACK)
+TEST_CASE("MSGPACK")
+{
+    TestType<msgpack_adapter>();
+}
+#endif
+
+#if defined(RPC_HPP_ENABLE_SIMDJSON)
+TEST_CASE("SIMDJSON")
+{
+    TestType<simdjson_adapter>();
+}
+#endif
+
+#if defined(RPC_HPP_ENABLE_VIEW)
+TEST_CASE("VIEW")
+{
+    TestType<view_adapter>();
+}
+#endif
+
+#if defined(RPC_HPP_ENABLE_RAW)
+TEST_CASE("RAW")
+{
+    TestType<raw_adapter>();
+}
+#endif
+
 // TODO: Clean this up somehow
 #if defined(RPC_HPP_ENABLE_BITSERY)
 #    if defined(TEST_USE_COMMA)
@@ -109,11 +153,22 @@ TEST_CASE("BITSERY")
 #    define TEST_BOOST_JSON_T
 #endif
 
+#if defined(RPC_HPP_ENABLE_MSGPACK)
+#    if defined(TEST_USE_COMMA)
+#        define TEST_MSGPACK_T , msgpack_adapter
+#    else
+#        define TEST_MSGPACK_T msgpack_adapter
+#        define TEST_USE_COMMA
+#    endif
+#else
+#    define TEST_MSGPACK_T
+#endif
+
 #if defined(RPC_HPP_ENABLE_NJSON)
 #    if defined(TEST_USE_COMMA)
-#        define TEST_NJSON_T , njson_adapter
+#        define TEST_NJSON_T , njson_adapter, njson_cbor_adapter, njson_text_adapter
 #    else
-#        define TEST_NJSON_T njson_adapter
+#        define TEST_NJSON_T njson_adapter, njson_cbor_adapter, njson_text_adapter
 #        define TEST_USE_COMMA
 #    endif
 #else
@@ -131,7 +186,43 @@ TEST_CASE("BITSERY")
 #    define TEST_RAPIDJSON_T
 #endif
 
-#define RPC_TEST_TYPES TEST_BITSERY_T TEST_BOOST_JSON_T TEST_NJSON_T TEST_RAPIDJSON_T
+#if defined(RPC_HPP_ENABLE_SIMDJSON)
+#    if defined(TEST_USE_COMMA)
+#        define TEST_SIMDJSON_T , simdjson_adapter
+#    else
+#        define TEST_SIMDJSON_T simdjson_adapter
+#        define TEST_USE_COMMA
+#    endif
+#else
+#    define TEST_SIMDJSON_T
+#endif
+
+#if defined(RPC_HPP_ENABLE_VIEW)
+#    if defined(TEST_USE_COMMA)
+#        define TEST_VIEW_T , view_adapter
+#    else
+#        define TEST_VIEW_T view_adapter
+#        define TEST_USE_COMMA
+#    endif
+#else
+#    define TEST_VIEW_T
+#endif
+
+#define RPC_TEST_TYPES TEST_BITSERY_T TEST_BOOST_JSON_T TEST_MSGPACK_T TEST_NJSON_T TEST_RAPIDJSON_T TEST_SIMDJSON_T TEST_VIEW_T
+
+// raw_adapter only supports trivially copyable types, so it is only used for those tests
+#if defined(RPC_HPP_ENABLE_RAW)
+#    if defined(TEST_USE_COMMA)
+#        define TEST_RAW_T , raw_adapter
+#    else
+#        define TEST_RAW_T raw_adapter
+#        define TEST_USE_COMMA
+#    endif
+#else
+#    define TEST_RAW_T
+#endif
+
+#define RPC_POD_TEST_TYPES RPC_TEST_TYPES TEST_RAW_T
 
 TEST_CASE_TEMPLATE("CountChars (static)", TestType, RPC_TEST_TYPES)
 {
@@ -197,7 +288,18 @@ TEST_CASE_TEMPLATE("AddOneToEachRef", TestType, RPC_TEST_TYPES)
     }
 }
 
-TEST_CASE_TEMPLATE("Fibonacci", TestType, RPC_TEST_TYPES)
+TEST_CASE_TEMPLATE("CrossProduct", TestType, RPC_POD_TEST_TYPES)
+{
+    auto& client = GetClient<TestType>();
+    const std::array<double, 3> x_axis{ 1.0, 0.0, 0.0 };
+    const std::array<double, 3> y_axis{ 0.0, 1.0, 0.0 };
+    const auto result =
+        client.template call_func<std::array<double, 3>>("CrossProduct", x_axis, y_axis);
+
+    REQUIRE(result == std::array<double, 3>{ 0.0, 0.0, 1.0 });
+}
+
+TEST_CASE_TEMPLATE("Fibonacci", TestType, RPC_POD_TEST_TYPES)
 {
     static constexpr uint64_t expected = 10946;
     static constexpr uint64_t input = 20;
@@ -208,7 +310,7 @@ TEST_CASE_TEMPLATE("Fibonacci", TestType, RPC_TEST_TYPES)
     REQUIRE(expected == test);
 }
 
-TEST_CASE_TEMPLATE("FibonacciRef", TestType, RPC_TEST_TYPES)
+TEST_CASE_TEMPLATE("FibonacciRef", TestType, RPC_POD_TEST_TYPES)
 {
     static constexpr uint64_t expected = 10946;
     auto& client = GetClient<TestType>();
@@ -219,7 +321,7 @@ TEST_CASE_TEMPLATE("FibonacciRef", TestType, RPC_TEST_TYPES)
     REQUIRE(expected == test);
 }
 
-TEST_CASE_TEMPLATE("StdDev", TestType, RPC_TEST_TYPES)
+TEST_CASE_TEMPLATE("StdDev", TestType, RPC_POD_TEST_TYPES)
 {
     static constexpr double expected = 3313.695594785;
     auto& client = GetClient<TestType>();
@@ -230,7 +332,7 @@ TEST_CASE_TEMPLATE("StdDev", TestType, RPC_TEST_TYPES)
     REQUIRE(test == doctest::Approx(expected));
 }
 
-TEST_CASE_TEMPLATE("SquareRootRef", TestType, RPC_TEST_TYPES)
+TEST_CASE_TEMPLATE("SquareRootRef", TestType, RPC_POD_TEST_TYPES)
 {
     static constexpr double expected = 313.2216436152;
     auto& client = GetClient<TestType>();
@@ -296,7 +398,7 @@ TEST_CASE_TEMPLATE("HashComplexRef", TestType, RPC_TEST_TYPES)
     REQUIRE(expected == test);
 }
 
-TEST_CASE_TEMPLATE("Function not found", TestType, RPC_TEST_TYPES)
+TEST_CASE_TEMPLATE("Function not found", TestType, RPC_POD_TEST_TYPES)
 {
     auto& client = GetClient<TestType>();
 
@@ -308,6 +410,65 @@ TEST_CASE_TEMPLATE("Function not found", TestType, RPC_TEST_TYPES)
     REQUIRE_THROWS_AS(exp(), rpc_hpp::function_not_found);
 }
 
+TEST_CASE_TEMPLATE("CountWords", TestType, RPC_TEST_TYPES)
+{
+    if constexpr (has_std_types_v<TestType>)
+    {
+        const std::map<std::string, int> expected{ { "a", 2 }, { "peck", 1 }, { "peter", 2 } };
+        auto& client = GetClient<TestType>();
+
+        const auto test = client.template call_func<std::map<std::string, int>>(
+            "CountWords", std::string{ "peter a peck a peter" });
+
+        REQUIRE(expected == test);
+    }
+}
+
+TEST_CASE_TEMPLATE("UniqueSorted", TestType, RPC_TEST_TYPES)
+{
+    if constexpr (has_std_types_v<TestType>)
+    {
+        const std::set<int> expected{ 1, 2, 3, 5 };
+        const std::vector<int> input{ 5, 3, 1, 3, 2, 5 };
+        auto& client = GetClient<TestType>();
+
+        const auto test = client.template call_func<std::set<int>>("UniqueSorted", input);
+
+        REQUIRE(expected == test);
+    }
+}
+
+TEST_CASE_TEMPLATE("FindIndex", TestType, RPC_TEST_TYPES)
+{
+    if constexpr (has_std_types_v<TestType>)
+    {
+        const std::vector<int> input{ 5, 3, 1, 3, 2, 5 };
+        using result_t = std::optional<size_t>;
+        auto& client = GetClient<TestType>();
+
+        const auto found = client.template call_func<result_t>("FindIndex", input, 1);
+        const auto missing = client.template call_func<result_t>("FindIndex", input, 4);
+
+        REQUIRE(found == result_t{ 2 });
+        REQUIRE(!missing.has_value());
+    }
+}
+
+TEST_CASE_TEMPLATE("ParseInt", TestType, RPC_TEST_TYPES)
+{
+    if constexpr (has_std_types_v<TestType>)
+    {
+        using result_t = std::variant<int64_t, std::string>;
+        auto& client = GetClient<TestType>();
+
+        const auto num = client.template call_func<result_t>("ParseInt", std::string{ "-42" });
+        const auto err = client.template call_func<result_t>("ParseInt", std::string{ "4x" });
+
+        REQUIRE(num == result_t{ int64_t{ -42 } });
+        REQUIRE(err == result_t{ std::string{ "Not an integer: 4x" } });
+    }
+}
+
 TEST_CASE_TEMPLATE("FunctionMismatch", TestType, RPC_TEST_TYPES)
 {
     auto& client = GetClient<TestType>();
@@ -352,7 +513,7 @@ TEST_CASE_TEMPLATE("FunctionMismatch", TestType, RPC_TEST_TYPES)
     REQUIRE_THROWS_AS(more_params(), rpc_hpp::function_mismatch);
 }
 
-TEST_CASE_TEMPLATE("ThrowError", TestType, RPC_TEST_TYPES)
+TEST_CASE_TEMPLATE("ThrowError", TestType, RPC_POD_TEST_TYPES)
 {
     auto& client = GetClient<TestType>();
 
@@ -364,16 +525,8 @@ TEST_CASE_TEMPLATE("ThrowError", TestType, RPC_TEST_TYPES)
     REQUIRE_THROWS_AS(exp(), rpc_hpp::remote_exec_error);
 }
 
-TEST_CASE_TEMPLATE("InvalidObject", TestType, RPC_TEST_TYPES)
+TEST_CASE_TEMPLATE("InvalidObject", TestType, RPC_POD_TEST_TYPES)
 {
-#if defined(RPC_HPP_ENABLE_BITSERY)
-    if (std::is_same_v<TestType, bitsery_adapter>)
-    {
-        // TODO: Verify bitsery data somehow
-        return;
-    }
-#endif
-
     typename TestType::bytes_t bytes{};
     bytes.resize(8);
 
@@ -389,6 +542,30 @@ TEST_CASE_TEMPLATE("InvalidObject", TestType, RPC_TEST_TYPES)
         == rpc_hpp::exception_type::server_receive);
 }
 
+#if defined(RPC_HPP_ENABLE_NJSON)
+TEST_CASE("MultiFormat")
+{
+    auto& msgpack_client = GetMultiClient<njson_adapter>();
+    auto& cbor_client = GetMultiClient<njson_cbor_adapter>();
+    auto& text_client = GetMultiClient<njson_text_adapter>();
+
+    REQUIRE(msgpack_client.call_func<int>("SimpleSum", 1, 2) == 3);
+    REQUIRE(cbor_client.call_func<int>("SimpleSum", 1, 2) == 3);
+    REQUIRE(text_client.call_func<size_t>("StrLen", std::string("multi")) == 5);
+
+    std::vector<int> vec{ 1, 2, 3 };
+    cbor_client.call_func("AddOneToEachRef", vec);
+    REQUIRE(vec == std::vector<int>({ 2, 3, 4 }));
+
+    REQUIRE_THROWS_AS(text_client.call_func("ThrowError"), rpc_hpp::remote_exec_error);
+
+    // The callback is shared, so its state is too
+    const auto count = msgpack_client.call_func<size_t>("CountCalls");
+    REQUIRE(cbor_client.call_func<size_t>("CountCalls") == count + 1);
+    REQUIRE(text_client.call_func<size_t>("CountCalls") == count + 2);
+}
+#endif
+
 TEST_CASE("KillServer")
 {
     auto& client = GetClient<njson_adapter>();
@@ -0,0 +1,52 @@
+#pragma once
+
+// Standard Library
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <map>
+#include <memory>
+#include <numeric>
+#include <optional>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <variant>
+#include <vector>
+
+// 3rd Party
+#if defined(RPC_HPP_ENABLE_BITSERY)
+#    include <bitsery/bitsery.h>
+#    include <bitsery/adapter/buffer.h>
+#    include <bitsery/ext/std_tuple.h>
+#    include <bitsery/traits/array.h>
+#    include <bitsery/traits/string.h>
+#    include <bitsery/traits/vector.h>
+#endif
+
+#if defined(RPC_HPP_ENABLE_BOOST_JSON)
+#    include <boost/json.hpp>
+#endif
+
+#if defined(RPC_HPP_ENABLE_NJSON)
+#    include <nlohmann/json.hpp>
+#endif
+
+#if defined(RPC_HPP_ENABLE_RAPIDJSON)
+#    include <rapidjson/document.h>
+#    include <rapidjson/stringbuffer.h>
+#    include <rapidjson/writer.h>
+#endif
+
+#if defined(RPC_HPP_ENABLE_SIMDJSON)
+#    include <simdjson.h>
+#endif
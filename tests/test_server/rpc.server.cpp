@@ -44,6 +44,8 @@
 #    include <rpc_adapters/rpc_njson.hpp>
 
 using rpc_hpp::adapters::njson_adapter;
+using rpc_hpp::adapters::njson_cbor_adapter;
+using rpc_hpp::adapters::njson_text_adapter;
 #endif
 
 #if defined(RPC_HPP_ENABLE_RAPIDJSON)
@@ -68,10 +70,41 @@ constexpr uint64_t bitsery_adapter::config::max_string_size = 2048;
 constexpr uint64_t bitsery_adapter::config::max_container_size = 1'000;
 #endif
 
+#if defined(RPC_HPP_ENABLE_MSGPACK)
+#    include <rpc_adapters/rpc_msgpack.hpp>
+
+using rpc_hpp::adapters::msgpack_adapter;
+#endif
+
+#if defined(RPC_HPP_ENABLE_RAW)
+#    include <rpc_adapters/rpc_raw.hpp>
+
+using rpc_hpp::adapters::raw_adapter;
+#endif
+
+#if defined(RPC_HPP_ENABLE_VIEW)
+#    include <rpc_adapters/rpc_view.hpp>
+
+using rpc_hpp::adapters::view_adapter;
+#endif
+
+#if defined(RPC_HPP_ENABLE_SIMDJSON)
+#    include <rpc_adapters/rpc_simdjson.hpp>
+
+using rpc_hpp::adapters::simdjson_adapter;
+#endif
+
 #include <algorithm>
+#include <array>
 #include <cmath>
+#include <map>
+#include <memory>
+#include <optional>
+#include <set>
 #include <sstream>
 #include <thread>
+#include <unordered_map>
+#include <variant>
 
 #if defined(RPC_HPP_ENABLE_SERVER_CACHE)
 #    include <filesystem>
@@ -81,6 +114,16 @@ constexpr uint64_t bitsery_adapter::config::max_container_size = 1'000;
 
 std::atomic_bool RUNNING{ false };
 
+#if defined(RPC_HPP_ENABLE_SERVER_CACHE)
+// Every server shares one set of function caches, so a result computed through one adapter is a
+// hit through the others
+const std::shared_ptr<rpc_hpp::shared_cache>& SharedCache()
+{
+    static const auto cache = std::make_shared<rpc_hpp::shared_cache>();
+    return cache;
+}
+#endif
+
 [[noreturn]] void ThrowError() noexcept(false)
 {
     throw std::runtime_error("THIS IS A TEST ERROR!");
@@ -118,6 +161,21 @@ void AddOneToEachRef(std::vector<int>& vec)
     }
 }
 
+#if defined(RPC_HPP_ENABLE_VIEW)
+// cached, reads its argument in place from the request
+size_t StrLenView(const std::string_view str)
+{
+    return str.size();
+}
+
+// cached, reads its argument in place from the request
+double AverageContainerView(const rpc_hpp::adapters::array_view<double> vals)
+{
+    const double sum = std::accumulate(vals.begin(), vals.end(), 0.00);
+    return sum / static_cast<double>(vals.size());
+}
+#endif
+
 int CountChars(const std::string& str, char c)
 {
     return static_cast<int>(
@@ -170,6 +228,61 @@ void SquareRootRef(double& n1, double& n2, double& n3, double& n4, double& n5, d
     n10 = std::sqrt(n10);
 }
 
+std::map<std::string, int> CountWords(const std::string& str)
+{
+    std::map<std::string, int> counts;
+    std::istringstream stream(str);
+    std::string word;
+
+    while (stream >> word)
+    {
+        ++counts[word];
+    }
+
+    return counts;
+}
+
+std::set<int> UniqueSorted(const std::vector<int>& vec)
+{
+    return { vec.begin(), vec.end() };
+}
+
+std::optional<size_t> FindIndex(const std::vector<int>& vec, const int val)
+{
+    if (const auto it = std::find(vec.begin(), vec.end(), val); it != vec.end())
+    {
+        return static_cast<size_t>(std::distance(vec.begin(), it));
+    }
+
+    return std::nullopt;
+}
+
+std::variant<int64_t, std::string> ParseInt(const std::string& str)
+{
+    try
+    {
+        size_t pos = 0;
+        const int64_t val = std::stoll(str, &pos);
+
+        if (pos == str.size())
+        {
+            return val;
+        }
+    }
+    catch (const std::exception&)
+    {
+        // Not a number, fall through and return an error message
+    }
+
+    return "Not an integer: " + str;
+}
+
+std::array<double, 3> CrossProduct(
+    const std::array<double, 3>& a, const std::array<double, 3>& b)
+{
+    return { a[1] * b[2] - a[2] * b[1], a[2] * b[0] - a[0] * b[2], a[0] * b[1] - a[1] * b[0] };
+}
+
 std::vector<uint64_t> GenRandInts(const uint64_t min, const uint64_t max, const size_t sz)
 {
     std::vector<uint64_t> vec;
@@ -224,6 +337,11 @@ void HashComplexRef(ComplexObject& cx, std::string& hashStr)
 template<typename Serial>
 void BindFuncs(TestServer<Serial>& server)
 {
+#if defined(RPC_HPP_ENABLE_SERVER_CACHE)
+    server.share_cache(SharedCache());
+    server.enable_prefetch({});
+#endif
+
     server.bind("KillServer", &KillServer);
     server.bind("ThrowError", &ThrowError);
     server.bind("AddOneToEachRef", &AddOneToEachRef);
@@ -231,76 +349,160 @@ void BindFuncs(TestServer<Serial>& server)
     server.bind("SquareRootRef", &SquareRootRef);
     server.bind("GenRandInts", &GenRandInts);
     server.bind("HashComplexRef", &HashComplexRef);
+    server.bind("CrossProduct", &CrossProduct);
     server.template bind<void, size_t&>("AddOne", [](size_t& n) { AddOne(n); });
 
     server.bind_cached("SimpleSum", &SimpleSum);
-    server.bind_cached("StrLen", &StrLen);
+
+#if defined(RPC_HPP_ENABLE_VIEW)
+    if constexpr (std::is_same_v<Serial, view_adapter>)
+    {
+        server.bind_cached("StrLen", &StrLenView);
+        server.bind_cached("AverageContainer<double>", &AverageContainerView);
+    }
+    else
+#endif
+    {
+        server.bind_cached("StrLen", &StrLen);
+        server.bind_cached("AverageContainer<double>", &AverageContainer<double>);
+    }
+
     server.bind_cached("AddOneToEach", &AddOneToEach);
     server.bind_cached("Fibonacci", &Fibonacci);
     server.bind_cached("Average", &Average);
     server.bind_cached("StdDev", &StdDev);
     server.bind_cached("AverageContainer<uint64_t>", &AverageContainer<uint64_t>);
-    server.bind_cached("AverageContainer<double>", &AverageContainer<double>);
     server.bind_cached("HashComplex", &HashComplex);
     server.bind_cached("CountChars", &CountChars);
+
+    if constexpr (has_std_types_v<Serial>)
+    {
+        server.bind("CountWords", &CountWords);
+        server.bind("UniqueSorted", &UniqueSorted);
+        server.bind("FindIndex", &FindIndex);
+        server.bind("ParseInt", &ParseInt);
+    }
 }
 
-#if defined(RPC_HPP_ENABLE_SERVER_CACHE)
-template<typename Serial, typename R, typename... Args>
-void dump_cache(TestServer<Serial>& server, [[maybe_unused]] R (*func)(Args...),
-    const std::string& func_name, const std::string& dump_dir)
+#if defined(RPC_HPP_ENABLE_NJSON)
+using MultiServer = MultiTestServer<njson_adapter, njson_cbor_adapter, njson_text_adapter>;
+
+void BindMultiFuncs(MultiServer& server)
 {
-    auto& cache = server.template get_func_cache<R>(func_name);
-    std::string file_name = func_name;
+#    if defined(RPC_HPP_ENABLE_SERVER_CACHE)
+    server.share_cache(SharedCache());
+#    endif
+
+    server.bind("ThrowError", &ThrowError);
+    server.bind("AddOneToEachRef", &AddOneToEachRef);
 
-    std::replace(file_name.begin(), file_name.end(), '<', '(');
-    std::replace(file_name.begin(), file_name.end(), '>', ')');
+    // Bound once, so every format counts the same calls (made one at a time by the tests)
+    server.bind("CountCalls",
+        std::function<size_t()>{ [count = size_t{ 0 }]() mutable { return ++count; } });
 
-    std::ofstream ofile(dump_dir + "/" + std::move(file_name) + ".dump");
+    server.bind_cached("SimpleSum", &SimpleSum);
+    server.bind_cached("StrLen", &StrLen);
+}
+#endif
 
-    if constexpr (std::is_arithmetic_v<R> || std::is_same_v<R, std::string>)
+#if defined(RPC_HPP_ENABLE_RAW)
+// raw_adapter only supports functions whose arguments and result are trivially copyable
+void BindRawFuncs(TestServer<raw_adapter>& server)
+{
+#    if defined(RPC_HPP_ENABLE_SERVER_CACHE)
+    server.share_cache(SharedCache());
+    server.enable_prefetch({});
+#    endif
+
+    server.bind("KillServer", &KillServer);
+    server.bind("ThrowError", &ThrowError);
+    server.bind("FibonacciRef", &FibonacciRef);
+    server.bind("SquareRootRef", &SquareRootRef);
+    server.bind("CrossProduct", &CrossProduct);
+
+    server.bind_cached("SimpleSum", &SimpleSum);
+    server.bind_cached("Fibonacci", &Fibonacci);
+    server.bind_cached("Average", &Average);
+    server.bind_cached("StdDev", &StdDev);
+}
+#endif
+
+#if defined(RPC_HPP_ENABLE_SERVER_CACHE)
+// Dumps are a series of length-prefixed records (key, then value), as the cache keys are binary
+template<typename T>
+void write_dump_value(std::ostream& ofile, const T& val)
+{
+    if constexpr (std::is_arithmetic_v<T>)
     {
-        for (const auto& [key, value] : cache)
-        {
-            ofile << key << '\034' << value << '\n';
-        }
+        ofile.write(reinterpret_cast<const char*>(&val), sizeof(val));
+    }
+    else
+    {
+        using value_t = typename T::value_type;
+        static_assert(std::is_arithmetic_v<value_t>,
+            "dump values must be arithmetic, or strings or vectors of arithmetic values");
+
+        const auto size = static_cast<uint64_t>(val.size());
+        ofile.write(reinterpret_cast<const char*>(&size), sizeof(size));
+        ofile.write(reinterpret_cast<const char*>(val.data()),
+            static_cast<std::streamsize>(val.size() * sizeof(value_t)));
     }
-    else if constexpr (std::is_same_v<R, std::vector<int>>)
+}
+
+template<typename T>
+[[nodiscard]] bool read_dump_value(std::istream& ifile, T& val)
+{
+    if constexpr (std::is_arithmetic_v<T>)
     {
-        std::stringstream ss;
+        return static_cast<bool>(ifile.read(reinterpret_cast<char*>(&val), sizeof(val)));
+    }
+    else
+    {
+        using value_t = typename T::value_type;
+        static constexpr uint64_t max_size = uint64_t{ 64 } * 1'024 * 1'024 / sizeof(value_t);
+
+        uint64_t size = 0;
 
-        for (const auto& [key, value] : cache)
+        if (!ifile.read(reinterpret_cast<char*>(&size), sizeof(size)) || size > max_size)
         {
-            if (value.empty())
-            {
-                continue;
-            }
+            return false;
+        }
 
-            ss << '[';
-            auto it = value.begin();
+        val.resize(static_cast<size_t>(size));
+        return static_cast<bool>(ifile.read(reinterpret_cast<char*>(val.data()),
+            static_cast<std::streamsize>(val.size() * sizeof(value_t))));
+    }
+}
 
-            for (; it != value.end() - 1; ++it)
-            {
-                ss << *it << ',';
-            }
+std::string dump_file_path(std::string func_name, const std::string& dump_dir)
+{
+    std::replace(func_name.begin(), func_name.end(), '<', '(');
+    std::replace(func_name.begin(), func_name.end(), '>', ')');
 
-            ss << *it << ']';
-            ofile << key << '\034' << ss.str() << '\n';
-        }
-    }
+    return dump_dir + "/" + std::move(func_name) + ".dump";
 }
 
-template<typename Serial, typename R, typename... Args>
-void load_cache(TestServer<Serial>& server, [[maybe_unused]] R (*func)(Args...),
+template<typename R, typename... Args>
+void dump_cache(rpc_hpp::shared_cache& shared_cache, [[maybe_unused]] R (*func)(Args...),
     const std::string& func_name, const std::string& dump_dir)
 {
-    auto& cache = server.template get_func_cache<R>(func_name);
-    std::string file_name = func_name;
+    const auto cache = shared_cache.with_func_cache<R>(func_name,
+        [](const std::unordered_map<std::string, R>& func_cache) { return func_cache; });
+
+    std::ofstream ofile(dump_file_path(func_name, dump_dir), std::ios::binary);
 
-    std::replace(file_name.begin(), file_name.end(), '<', '(');
-    std::replace(file_name.begin(), file_name.end(), '>', ')');
+    for (const auto& [key, value] : cache)
+    {
+        write_dump_value(ofile, key);
+        write_dump_value(ofile, value);
+    }
+}
 
-    std::ifstream ifile(dump_dir + "/" + std::move(file_name) + ".dump");
+template<typename R, typename... Args>
+void load_cache(rpc_hpp::shared_cache& shared_cache, [[maybe_unused]] R (*func)(Args...),
+    const std::string& func_name, const std::string& dump_dir)
+{
+    std::ifstream ifile(dump_file_path(func_name, dump_dir), std::ios::binary);
 
     if (!ifile.is_open())
     {
@@ -308,56 +510,24 @@ void load_cache(TestServer<Serial>& server, [[maybe_unused]] R (*func)(Args...),
         return;
     }
 
-    std::stringstream ss;
-    std::string val_str;
+    std::unordered_map<std::string, R> cache{};
+    std::string key;
+    R value{};
 
-    while (ifile.get(*ss.rdbuf(), '\034'))
+    // Stops at the end of the file, or at a truncated record
+    while (read_dump_value(ifile, key) && read_dump_value(ifile, value))
     {
-        // Toss out separator
-        std::ignore = ifile.get();
-
-        std::getline(ifile, val_str);
-
-        if constexpr (std::is_arithmetic_v<R>)
-        {
-            R value;
-            std::stringstream ss2(val_str);
-
-            ss2 >> value;
-            cache.emplace(ss.str(), value);
-        }
-        else if constexpr (std::is_same_v<R, std::string>)
-        {
-            cache.emplace(ss.str(), std::move(val_str));
-        }
-        else if constexpr (std::is_same_v<R, std::vector<int>>)
-        {
-            std::vector<int> value;
-            std::stringstream ss2(val_str);
-
-            // ignore first '['
-            ss2.ignore();
-
-            for (int i; ss2 >> i;)
-            {
-                value.push_back(i);
-
-                if (ss2.peek() == ',' || ss2.peek() == ']')
-                {
-                    ss2.ignore();
-                }
-            }
-
-            cache.emplace(ss.str(), std::move(value));
-        }
-
-        // clear stream and its buffer
-        std::stringstream{}.swap(ss);
+        cache.insert_or_assign(std::move(key), std::move(value));
+        key = std::string{};
+        value = R{};
     }
+
+    shared_cache.with_func_cache<R>(func_name,
+        [&cache](std::unordered_map<std::string, R>& func_cache) { func_cache.merge(cache); });
 }
 
-#    define DUMP_CACHE(SERVER, FUNCNAME, DIR) dump_cache(SERVER, FUNCNAME, #    FUNCNAME, DIR)
-#    define LOAD_CACHE(SERVER, FUNCNAME, DIR) load_cache(SERVER, FUNCNAME, #    FUNCNAME, DIR)
+#    define DUMP_CACHE(CACHE, FUNCNAME, DIR) dump_cache(CACHE, FUNCNAME, #    FUNCNAME, DIR)
+#    define LOAD_CACHE(CACHE, FUNCNAME, DIR) load_cache(CACHE, FUNCNAME, #    FUNCNAME, DIR)
 #endif
 
 int main(const int argc, char* argv[])
@@ -374,28 +544,27 @@ int main(const int argc, char* argv[])
 
         std::vector<std::thread> threads;
 
-#if defined(RPC_HPP_ENABLE_NJSON)
-        TestServer<njson_adapter> njson_server{ io_context, 5000U };
-        BindFuncs(njson_server);
-
-#    if defined(RPC_HPP_ENABLE_SERVER_CACHE)
-        const std::string njson_dump_path("dump_cache");
+#if defined(RPC_HPP_ENABLE_SERVER_CACHE)
+        const std::string dump_path("dump_cache");
 
-        if (std::filesystem::exists(njson_dump_path)
-            && std::filesystem::is_directory(njson_dump_path))
+        if (std::filesystem::exists(dump_path) && std::filesystem::is_directory(dump_path))
         {
-            LOAD_CACHE(njson_server, SimpleSum, njson_dump_path);
-            LOAD_CACHE(njson_server, StrLen, njson_dump_path);
-            LOAD_CACHE(njson_server, AddOneToEach, njson_dump_path);
-            LOAD_CACHE(njson_server, Fibonacci, njson_dump_path);
-            LOAD_CACHE(njson_server, Average, njson_dump_path);
-            LOAD_CACHE(njson_server, StdDev, njson_dump_path);
-            LOAD_CACHE(njson_server, AverageContainer<uint64_t>, njson_dump_path);
-            LOAD_CACHE(njson_server, AverageContainer<double>, njson_dump_path);
-            LOAD_CACHE(njson_server, HashComplex, njson_dump_path);
-            LOAD_CACHE(njson_server, CountChars, njson_dump_path);
+            LOAD_CACHE(*SharedCache(), SimpleSum, dump_path);
+            LOAD_CACHE(*SharedCache(), StrLen, dump_path);
+            LOAD_CACHE(*SharedCache(), AddOneToEach, dump_path);
+            LOAD_CACHE(*SharedCache(), Fibonacci, dump_path);
+            LOAD_CACHE(*SharedCache(), Average, dump_path);
+            LOAD_CACHE(*SharedCache(), StdDev, dump_path);
+            LOAD_CACHE(*SharedCache(), AverageContainer<uint64_t>, dump_path);
+            LOAD_CACHE(*SharedCache(), AverageContainer<double>, dump_path);
+            LOAD_CACHE(*SharedCache(), HashComplex, dump_path);
+            LOAD_CACHE(*SharedCache(), CountChars, dump_path);
         }
-#    endif
+#endif
+
+#if defined(RPC_HPP_ENABLE_NJSON)
+        TestServer<njson_adapter> njson_server{ io_context, 5000U };
+        BindFuncs(njson_server);
 
         threads.emplace_back(&TestServer<njson_adapter>::Run, &njson_server);
         puts("Running njson server on port 5000...");
@@ -422,22 +591,73 @@ int main(const int argc, char* argv[])
         puts("Running Bitsery server on port 5003...");
 #endif
 
+#if defined(RPC_HPP_ENABLE_MSGPACK)
+        TestServer<msgpack_adapter> msgpack_server{ io_context, 5004U };
+        BindFuncs(msgpack_server);
+        threads.emplace_back(&TestServer<msgpack_adapter>::Run, &msgpack_server);
+        puts("Running MessagePack server on port 5004...");
+#endif
+
+#if defined(RPC_HPP_ENABLE_VIEW)
+        TestServer<view_adapter> view_server{ io_context, 5005U };
+        BindFuncs(view_server);
+        threads.emplace_back(&TestServer<view_adapter>::Run, &view_server);
+        puts("Running view server on port 5005...");
+#endif
+
+#if defined(RPC_HPP_ENABLE_RAW)
+        TestServer<raw_adapter> raw_server{ io_context, 5006U };
+        BindRawFuncs(raw_server);
+        threads.emplace_back(&TestServer<raw_adapter>::Run, &raw_server);
+        puts("Running raw server on port 5006...");
+#endif
+
+#if defined(RPC_HPP_ENABLE_SIMDJSON)
+        TestServer<simdjson_adapter> simdjson_server{ io_context, 5007U };
+        BindFuncs(simdjson_server);
+        threads.emplace_back(&TestServer<simdjson_adapter>::Run, &simdjson_server);
+        puts("Running simdjson server on port 5007...");
+#endif
+
+#if defined(RPC_HPP_ENABLE_NJSON)
+        TestServer<njson_cbor_adapter> njson_cbor_server{ io_context, 5008U };
+        BindFuncs(njson_cbor_server);
+        threads.emplace_back(&TestServer<njson_cbor_adapter>::Run, &njson_cbor_server);
+        puts("Running njson (CBOR) server on port 5008...");
+
+        TestServer<njson_text_adapter> njson_text_server{ io_context, 5009U };
+        BindFuncs(njson_text_server);
+        threads.emplace_back(&TestServer<njson_text_adapter>::Run, &njson_text_server);
+        puts("Running njson (text) server on port 5009...");
+
+        MultiServer multi_server{ io_context, 5010U };
+        BindMultiFuncs(multi_server);
+        threads.emplace_back(&MultiServer::Run, &multi_server);
+        puts("Running multi-format njson server on port 5010...");
+#endif
+
         for (auto& th : threads)
         {
             th.join();
         }
 
-#if defined(RPC_HPP_ENABLE_NJSON) && defined(RPC_HPP_ENABLE_SERVER_CACHE)
-        DUMP_CACHE(njson_server, SimpleSum, njson_dump_path);
-        DUMP_CACHE(njson_server, StrLen, njson_dump_path);
-        DUMP_CACHE(njson_server, AddOneToEach, njson_dump_path);
-        DUMP_CACHE(njson_server, Fibonacci, njson_dump_path);
-        DUMP_CACHE(njson_server, Average, njson_dump_path);
-        DUMP_CACHE(njson_server, StdDev, njson_dump_path);
-        DUMP_CACHE(njson_server, AverageContainer<uint64_t>, njson_dump_path);
-        DUMP_CACHE(njson_server, AverageContainer<double>, njson_dump_path);
-        DUMP_CACHE(njson_server, HashComplex, njson_dump_path);
-        DUMP_CACHE(njson_server, CountChars, njson_dump_path);
+#if defined(RPC_HPP_ENABLE_SERVER_CACHE)
+        DUMP_CACHE(*SharedCache(), SimpleSum, dump_path);
+        DUMP_CACHE(*SharedCache(), StrLen, dump_path);
+        DUMP_CACHE(*SharedCache(), AddOneToEach, dump_path);
+        DUMP_CACHE(*SharedCache(), Fibonacci, dump_path);
+        DUMP_CACHE(*SharedCache(), Average, dump_path);
+        DUMP_CACHE(*SharedCache(), StdDev, dump_path);
+        DUMP_CACHE(*SharedCache(), AverageContainer<uint64_t>, dump_path);
+        DUMP_CACHE(*SharedCache(), AverageContainer<double>, dump_path);
+        DUMP_CACHE(*SharedCache(), HashComplex, dump_path);
+        DUMP_CACHE(*SharedCache(), CountChars, dump_path);
+
+        for (const auto& [func_name, stats] : SharedCache()->cache_stats())
+        {
+            printf("Cache for %s: %zu hits, %zu misses, %zu entries (~%zu bytes)\n",
+                func_name.c_str(), stats.hits, stats.misses, stats.entries, stats.mem_size);
+        }
 #endif
 
         puts("Exited normally");
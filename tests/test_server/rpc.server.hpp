@@ -41,14 +41,20 @@
 #include <asio.hpp>
 #include <rpc.hpp>
 
+#include <algorithm>
 #include <array>
 #include <atomic>
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
 #include <cstdio>
+#include <future>
 #include <numeric>
+#include <optional>
 #include <stdexcept>
 #include <string>
+#include <string_view>
+#include <thread>
 #include <vector>
 
 using asio::ip::tcp;
@@ -103,6 +109,69 @@ std::vector<uint64_t> GenRandInts(uint64_t min, uint64_t max, size_t sz);
 std::string HashComplex(const ComplexObject& cx);
 void HashComplexRef(ComplexObject& cx, std::string& hashStr);
 
+// Accepts the next connection, or closes the acceptor and returns std::nullopt once the server is killed
+[[nodiscard]] inline std::optional<tcp::socket> AcceptConnection(tcp::acceptor& accept)
+{
+    // Polled, so that KillServer is noticed while no client is connecting
+    static constexpr auto POLL_INTERVAL = std::chrono::milliseconds(50);
+    accept.non_blocking(true);
+
+    while (RUNNING)
+    {
+        asio::error_code error;
+        tcp::socket sock = accept.accept(error);
+
+        if (!error)
+        {
+            return sock;
+        }
+
+        if (error != asio::error::would_block && error != asio::error::try_again)
+        {
+            throw asio::system_error(error);
+        }
+
+        std::this_thread::sleep_for(POLL_INTERVAL);
+    }
+
+    accept.close();
+    return std::nullopt;
+}
+
+// Calls on_request(data, len) for each request received on sock, until it is closed
+template<typename OnRequest>
+void ServeConnection(tcp::socket& sock, OnRequest&& on_request)
+{
+    static constexpr auto BUFFER_SZ = 64U * 1024UL;
+    std::array<uint8_t, BUFFER_SZ> data{};
+
+    try
+    {
+        while (RUNNING)
+        {
+            asio::error_code error;
+            const size_t len = sock.read_some(asio::buffer(data.data(), BUFFER_SZ), error);
+
+            if (error == asio::error::eof)
+            {
+                break;
+            }
+
+            // other error
+            if (error)
+            {
+                throw asio::system_error(error);
+            }
+
+            on_request(data.data(), len);
+        }
+    }
+    catch (const std::exception& ex)
+    {
+        fprintf(stderr, "Exception in thread: %s\n", ex.what());
+    }
+}
+
 template<typename Serial>
 class TestServer final : public rpc_hpp::server_interface<Serial>
 {
@@ -114,42 +183,105 @@ public:
 
     void Run()
     {
-        static constexpr auto BUFFER_SZ = 64U * 1024UL;
-        std::array<uint8_t, BUFFER_SZ> data{};
+        while (auto sock = AcceptConnection(m_accept))
+        {
+#if defined(RPC_HPP_ENABLE_SERVER_CACHE)
+            const size_t connection_id = m_next_connection_id++;
+#endif
 
-        while (RUNNING)
+            // Reused for every reply, and requests are received into pooled buffers, so that no
+            // message buffers are allocated once warmed up
+            typename Serial::bytes_t reply{};
+
+            ServeConnection(*sock,
+                [&](const uint8_t* data, const size_t len)
+                {
+                    auto request = rpc_hpp::buffer_pool<typename Serial::bytes_t>::local().acquire(
+                        data, data + len);
+
+#if defined(RPC_HPP_ENABLE_SERVER_CACHE)
+                    this->dispatch(std::move(request), connection_id, reply);
+#else
+                    this->dispatch(std::move(request), reply);
+#endif
+                    write(*sock, asio::buffer(reply.data(), reply.size()));
+                });
+
+#if defined(RPC_HPP_ENABLE_SERVER_CACHE)
+            this->forget_connection(connection_id);
+#endif
+        }
+    }
+
+private:
+    tcp::acceptor m_accept;
+
+#if defined(RPC_HPP_ENABLE_SERVER_CACHE)
+    size_t m_next_connection_id{ 0 };
+#endif
+};
+
+// Serves clients of every one of Serials on a single port
+template<typename... Serials>
+class MultiTestServer final : public rpc_hpp::multi_server<Serials...>
+{
+public:
+    MultiTestServer(asio::io_context& io, const uint16_t port)
+        : m_accept(io, tcp::endpoint(tcp::v4(), port))
+    {
+    }
+
+    void Run()
+    {
+        // Clients of each format stay connected to the same port, so each connection gets a thread
+        std::vector<std::future<void>> connections{};
+
+        while (auto sock = AcceptConnection(m_accept))
         {
-            tcp::socket sock = m_accept.accept();
+            // Reap the threads of closed connections
+            connections.erase(std::remove_if(connections.begin(), connections.end(),
+                                  [](const std::future<void>& connection) {
+                                      return connection.wait_for(std::chrono::seconds(0))
+                                          == std::future_status::ready;
+                                  }),
+                connections.end());
+
+            connections.push_back(std::async(std::launch::async,
+                [this, sock = std::move(*sock), connection_id = m_next_connection_id++]() mutable
+                { Serve(sock, connection_id); }));
+        }
 
-            try
+        // Waits for the remaining connections to close
+        connections.clear();
+    }
+
+private:
+    void Serve(tcp::socket& sock, [[maybe_unused]] const size_t connection_id)
+    {
+        ServeConnection(sock,
+            [&](const uint8_t* data, const size_t len)
             {
-                while (RUNNING)
+                const std::string_view bytes{ reinterpret_cast<const char*>(data), len };
+                const auto write_reply = [&sock](const auto& reply)
+                { write(sock, asio::buffer(reply.data(), reply.size())); };
+
+#if defined(RPC_HPP_ENABLE_SERVER_CACHE)
+                const bool handled = this->dispatch(bytes, connection_id, write_reply);
+#else
+                const bool handled = this->dispatch(bytes, write_reply);
+#endif
+
+                if (!handled)
                 {
-                    asio::error_code error;
-                    const size_t len = sock.read_some(asio::buffer(data.data(), BUFFER_SZ), error);
-
-                    if (error == asio::error::eof)
-                    {
-                        break;
-                    }
-
-                    // other error
-                    if (error)
-                    {
-                        throw asio::system_error(error);
-                    }
-
-                    const auto bytes = this->dispatch({ std::begin(data), std::begin(data) + len });
-                    write(sock, asio::buffer(bytes, bytes.size()));
+                    throw std::runtime_error("Received a request in an unknown format");
                 }
-            }
-            catch (const std::exception& ex)
-            {
-                fprintf(stderr, "Exception in thread: %s\n", ex.what());
-            }
-        }
+            });
+
+#if defined(RPC_HPP_ENABLE_SERVER_CACHE)
+        this->forget_connection(connection_id);
+#endif
     }
 
-private:
     tcp::acceptor m_accept;
+    size_t m_next_connection_id{ 0 };
 };
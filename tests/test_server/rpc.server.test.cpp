@@ -0,0 +1,1822 @@
+///@file rpc.server.test.cpp
+///@author Jackson Harmer (jharmer95@gmail.com)
+///@brief Unit tests for rpc.hpp servers, dispatching in-process (without a socket)
+///
+///@copyright
+///BSD 3-Clause License
+///
+///Copyright (c) 2020-2022, Jackson Harmer
+///All rights reserved.
+///
+///Redistribution and use in source and binary forms, with or without
+///modification, are permitted provided that the following conditions are met:
+///
+///1. Redistributions of source code must retain the above copyright notice, this
+///   list of conditions and the following disclaimer.
+///
+///2. Redistributions in binary form must reproduce the above copyright notice,
+///   this list of conditions and the following disclaimer in the documentation
+///   and/or other materials provided with the distribution.
+///
+///3. Neither the name of the copyright holder nor the names of its
+///   contributors may be used to endorse or promote products derived from
+///   this software without specific prior written permission.
+///
+///THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+///AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+///IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+///DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+///FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+///DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+///SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+///CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+///OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+///OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+///
+
+#define RPC_HPP_CLIENT_IMPL
+#define RPC_HPP_SERVER_IMPL
+
+#include "../test_structs.hpp"
+
+#include <rpc.hpp>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <map>
+#include <memory>
+#include <numeric>
+#include <optional>
+#include <set>
+#include <stdexcept>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+
+#if defined(RPC_HPP_ENABLE_BITSERY)
+constexpr uint64_t bitsery_adapter::config::max_func_name_size = 30;
+constexpr uint64_t bitsery_adapter::config::max_string_size = 2048;
+constexpr uint64_t bitsery_adapter::config::max_container_size = 100;
+#endif
+
+template<typename Serial>
+class LocalServer final : public rpc_hpp::server_interface<Serial>
+{
+};
+
+// Client whose requests are dispatched straight to a server in the same process
+template<typename Serial>
+class LocalClient final : public rpc_hpp::client_interface<Serial>
+{
+public:
+    explicit LocalClient(LocalServer<Serial>& server) noexcept : m_server(server) {}
+
+    // Prevent copying (the client refers to its server)
+    LocalClient(const LocalClient&) = delete;
+    LocalClient& operator=(const LocalClient&) = delete;
+
+#if defined(RPC_HPP_ENABLE_SERVER_CACHE)
+    // Appends every request sent from now on to trace
+    void record_to(std::ostream& trace) noexcept { m_trace = &trace; }
+
+    // Dispatches every request sent from now on as received on a connection
+    void set_connection(const size_t connection_id) noexcept { m_connection_id = connection_id; }
+#endif
+
+    // Applies tamper to every request sent from now on, before the server receives it
+    void tamper_with(std::function<void(typename Serial::bytes_t&)> tamper) noexcept
+    {
+        m_tamper = std::move(tamper);
+    }
+
+    void send(const typename Serial::bytes_t& mesg) override
+    {
+        typename Serial::bytes_t request{ mesg };
+
+        if (m_tamper)
+        {
+            m_tamper(request);
+        }
+
+#if defined(RPC_HPP_ENABLE_SERVER_CACHE)
+        if (m_trace != nullptr)
+        {
+            LocalServer<Serial>::record_request(*m_trace, request);
+        }
+
+        if (m_connection_id.has_value())
+        {
+            reply() = m_server.dispatch(std::move(request), m_connection_id.value());
+            return;
+        }
+#endif
+
+        reply() = m_server.dispatch(std::move(request));
+    }
+
+    [[nodiscard]] typename Serial::bytes_t receive() override { return std::move(reply()); }
+
+private:
+    // Kept per thread, so that calls may be made from several threads at once
+    [[nodiscard]] static typename Serial::bytes_t& reply() noexcept
+    {
+        thread_local typename Serial::bytes_t reply_bytes{};
+        return reply_bytes;
+    }
+
+    LocalServer<Serial>& m_server;
+    std::function<void(typename Serial::bytes_t&)> m_tamper{};
+
+#if defined(RPC_HPP_ENABLE_SERVER_CACHE)
+    std::ostream* m_trace{ nullptr };
+    std::optional<size_t> m_connection_id{};
+#endif
+};
+
+#if defined(RPC_HPP_ENABLE_SERVER_CACHE) && defined(RPC_HPP_ENABLE_NJSON)
+TEST_CASE("SharedCache")
+{
+    const auto cache = std::make_shared<rpc_hpp::shared_cache>();
+    LocalServer<njson_adapter> msgpack_server;
+    LocalServer<njson_cbor_adapter> cbor_server;
+    msgpack_server.share_cache(cache);
+    cbor_server.share_cache(cache);
+    size_t num_calls = 0;
+
+    const std::function<int(int)> square = [&num_calls](const int n)
+    {
+        ++num_calls;
+        return n * n;
+    };
+
+    msgpack_server.bind_cached("SharedSquare", std::function<int(int)>{ square });
+    cbor_server.bind_cached("SharedSquare", std::function<int(int)>{ square });
+
+    LocalClient<njson_adapter> msgpack_client{ msgpack_server };
+    LocalClient<njson_cbor_adapter> cbor_client{ cbor_server };
+
+    REQUIRE(msgpack_client.call_func<int>("SharedSquare", 7) == 49);
+    REQUIRE(cbor_client.call_func<int>("SharedSquare", 7) == 49);
+    REQUIRE(num_calls == 1);
+
+    const auto stats = cbor_server.cache_stats().at("SharedSquare");
+    REQUIRE(stats.misses == 1);
+    REQUIRE(stats.hits == 1);
+    REQUIRE(stats.entries == 1);
+    REQUIRE(msgpack_server.with_func_cache<int>("SharedSquare",
+                [](const std::unordered_map<std::string, int>& func_cache) { return func_cache.size(); })
+        == 1);
+
+    // The shared object sees the same caches and activity
+    REQUIRE(cache->cache_stats().at("SharedSquare").hits == 1);
+    REQUIRE(cache->with_func_cache<int>("SharedSquare",
+                [](const std::unordered_map<std::string, int>& func_cache) { return func_cache.size(); })
+        == 1);
+
+    // Servers not given the cache keep their own
+    LocalServer<njson_adapter> other_server;
+    other_server.bind_cached("SharedSquare", std::function<int(int)>{ square });
+
+    LocalClient<njson_adapter> other_client{ other_server };
+    REQUIRE(other_client.call_func<int>("SharedSquare", 7) == 49);
+    REQUIRE(num_calls == 2);
+    REQUIRE(other_server.cache_stats().at("SharedSquare").misses == 1);
+    REQUIRE(cbor_server.cache_stats().at("SharedSquare").misses == 1);
+}
+
+TEST_CASE("CacheSignatureTag")
+{
+    // Same name and return type, but different arguments whose values have the same bytes
+    const auto cache = std::make_shared<rpc_hpp::shared_cache>();
+    LocalServer<njson_adapter> signed_server;
+    LocalServer<njson_cbor_adapter> unsigned_server;
+    signed_server.share_cache(cache);
+    unsigned_server.share_cache(cache);
+
+    signed_server.bind_cached(
+        "TaggedConvert", std::function<int64_t(int32_t)>{ [](const int32_t n) { return int64_t{ n }; } });
+
+    unsigned_server.bind_cached("TaggedConvert",
+        std::function<int64_t(uint32_t)>{ [](const uint32_t n) { return int64_t{ n } + 1'000; } });
+
+    LocalClient<njson_adapter> signed_client{ signed_server };
+    LocalClient<njson_cbor_adapter> unsigned_client{ unsigned_server };
+
+    REQUIRE(signed_client.call_func<int64_t>("TaggedConvert", int32_t{ 5 }) == 5);
+    REQUIRE(unsigned_client.call_func<int64_t>("TaggedConvert", uint32_t{ 5 }) == 1'005);
+}
+
+TEST_CASE("WarmCache")
+{
+    const std::function<uint64_t(uint64_t)> triple = [](const uint64_t n) { return 3 * n; };
+    size_t num_increments = 0;
+
+    const std::function<void(uint64_t&)> increment = [&num_increments](uint64_t& n)
+    {
+        ++num_increments;
+        ++n;
+    };
+
+    std::stringstream trace{};
+
+    {
+        // Not cached, so that recording does not fill the cache
+        LocalServer<njson_adapter> recorded_server;
+        recorded_server.bind("WarmTriple", std::function<uint64_t(uint64_t)>{ triple });
+        recorded_server.bind("WarmIncrement", std::function<void(uint64_t&)>{ increment });
+
+        LocalClient<njson_adapter> client{ recorded_server };
+        client.record_to(trace);
+
+        for (uint64_t n = 1; n <= 4; ++n)
+        {
+            REQUIRE(client.call_func<uint64_t>("WarmTriple", n) == 3 * n);
+
+            uint64_t val = n;
+            client.call_func("WarmIncrement", val);
+        }
+    }
+
+    REQUIRE(num_increments == 4);
+
+    LocalServer<njson_adapter> server;
+    server.bind_cached("WarmTriple", std::function<uint64_t(uint64_t)>{ triple });
+    server.bind("WarmIncrement", std::function<void(uint64_t&)>{ increment });
+
+    // Only the cached function is replayed, the side effects of the other are not repeated
+    REQUIRE(server.warm_cache(trace, 2) == 4);
+    REQUIRE(server.cache_stats().at("WarmTriple").entries == 4);
+    REQUIRE(num_increments == 4);
+
+    LocalClient<njson_adapter> client{ server };
+    REQUIRE(client.call_func<uint64_t>("WarmTriple", uint64_t{ 3 }) == 9);
+
+    const auto stats = server.cache_stats().at("WarmTriple");
+    REQUIRE(stats.hits == 1);
+    REQUIRE(stats.misses == 4);
+}
+
+TEST_CASE("WarmCacheCorruptTrace")
+{
+    std::stringstream trace{};
+
+    {
+        LocalServer<njson_adapter> recorded_server;
+        recorded_server.bind("WarmCorruptSquare",
+            std::function<uint64_t(uint64_t)>{ [](const uint64_t n) { return n * n; } });
+
+        LocalClient<njson_adapter> client{ recorded_server };
+        client.record_to(trace);
+        REQUIRE(client.call_func<uint64_t>("WarmCorruptSquare", uint64_t{ 5 }) == 25);
+    }
+
+    // A record claiming to be far larger than any request, which must not be allocated
+    const uint64_t bad_len = ~uint64_t{ 0 };
+    trace.write(reinterpret_cast<const char*>(&bad_len), sizeof(bad_len));
+    trace.write("junk", 4);
+
+    LocalServer<njson_adapter> server;
+    server.bind_cached("WarmCorruptSquare",
+        std::function<uint64_t(uint64_t)>{ [](const uint64_t n) { return n * n; } });
+
+    REQUIRE(server.warm_cache(trace) == 1);
+    REQUIRE(server.cache_stats().at("WarmCorruptSquare").entries == 1);
+}
+
+TEST_CASE("Prefetch")
+{
+    LocalServer<njson_adapter> server;
+    server.enable_prefetch({ 0.9, 4, 64 });
+
+    server.bind("PrefetchRange",
+        std::function<std::vector<uint64_t>(uint64_t, uint64_t)>{
+            [](const uint64_t first, const uint64_t count)
+            {
+                std::vector<uint64_t> vals(count);
+                std::iota(vals.begin(), vals.end(), first);
+                return vals;
+            } });
+
+    server.bind_cached("PrefetchFibonacci",
+        std::function<uint64_t(uint64_t)>{ [](const uint64_t n)
+            {
+                uint64_t prev = 0;
+                uint64_t cur = 1;
+
+                for (uint64_t i = 0; i < n; ++i)
+                {
+                    cur += std::exchange(prev, cur);
+                }
+
+                return cur;
+            } });
+
+    LocalClient<njson_adapter> client{ server };
+    client.set_connection(1);
+
+    // Every value of the first range is passed to the next calls, so the sequence is learned
+    for (const auto val : client.call_func<std::vector<uint64_t>>("PrefetchRange", 10, 4))
+    {
+        std::ignore = client.call_func<uint64_t>("PrefetchFibonacci", val);
+    }
+
+    const auto learned = server.cache_stats().at("PrefetchFibonacci");
+    REQUIRE(learned.hits == 0);
+    REQUIRE(learned.entries == 4);
+
+    const auto next_vals = client.call_func<std::vector<uint64_t>>("PrefetchRange", 20, 4);
+
+    // Prefetching happens in the background, once the server is idle
+    server.wait_for_prefetch();
+    REQUIRE(server.cache_stats().at("PrefetchFibonacci").entries == 8);
+
+    REQUIRE(client.call_func<uint64_t>("PrefetchFibonacci", next_vals.front()) == 10'946);
+
+    for (const auto val : next_vals)
+    {
+        std::ignore = client.call_func<uint64_t>("PrefetchFibonacci", val);
+    }
+
+    const auto stats = server.cache_stats().at("PrefetchFibonacci");
+    REQUIRE(stats.hits == learned.hits + next_vals.size() + 1);
+    REQUIRE(stats.misses == learned.misses);
+}
+
+TEST_CASE("CacheStats")
+{
+    LocalServer<njson_adapter> server;
+
+    server.bind_cached("StatsRepeat",
+        std::function<std::string(std::string, size_t)>{
+            [](const std::string& str, const size_t count)
+            {
+                std::string result{};
+
+                for (size_t i = 0; i < count; ++i)
+                {
+                    result += str;
+                }
+
+                return result;
+            } });
+
+    LocalClient<njson_adapter> client{ server };
+    REQUIRE(server.cache_stats().at("StatsRepeat").mem_size > 0);
+
+    std::ignore = client.call_func<std::string>("StatsRepeat", std::string{ "ab" }, size_t{ 2 });
+    std::ignore = client.call_func<std::string>("StatsRepeat", std::string{ "cd" }, size_t{ 100 });
+    std::ignore = client.call_func<std::string>("StatsRepeat", std::string{ "ab" }, size_t{ 2 });
+
+    const auto stats = server.cache_stats().at("StatsRepeat");
+    REQUIRE(stats.hits == 1);
+    REQUIRE(stats.misses == 2);
+    REQUIRE(stats.inserts == 2);
+    REQUIRE(stats.evictions == 0);
+    REQUIRE(stats.entries == 2);
+
+    // At least both keys and results are accounted for (the 200 character result is on the heap)
+    REQUIRE(stats.mem_size >= 200 + 4 + 2 * sizeof(std::string));
+
+    server.clear_all_cache();
+
+    const auto cleared = server.cache_stats().at("StatsRepeat");
+    REQUIRE(cleared.hits == 1);
+    REQUIRE(cleared.misses == 2);
+    REQUIRE(cleared.evictions == 2);
+    REQUIRE(cleared.entries == 0);
+    REQUIRE(cleared.mem_size < stats.mem_size - 200);
+}
+#endif
+
+// Plain calls must round-trip through every adapter: results, reference arguments, and errors
+template<typename Serial>
+void CheckRoundTrip()
+{
+    LocalServer<Serial> server;
+
+    server.bind("RoundTripSum",
+        std::function<int(int, int)>{ [](const int n1, const int n2) { return n1 + n2; } });
+
+    server.bind("RoundTripAppend",
+        std::function<void(std::string&)>{ [](std::string& str) { str += "!"; } });
+
+    server.bind("RoundTripReverse",
+        std::function<std::vector<double>(std::vector<double>)>{ [](const std::vector<double>& vals)
+            { return std::vector<double>(vals.rbegin(), vals.rend()); } });
+
+    server.bind("RoundTripThrow",
+        std::function<int(int)>{ [](const int) -> int { throw std::runtime_error("failed"); } });
+
+    LocalClient<Serial> client{ server };
+
+    REQUIRE(client.template call_func<int>("RoundTripSum", 2, 3) == 5);
+
+    std::string str{ "hello" };
+    client.template call_func<void>("RoundTripAppend", str);
+    REQUIRE(str == "hello!");
+
+    REQUIRE(client.template call_func<std::vector<double>>(
+                "RoundTripReverse", std::vector<double>{ 1.5, -2.25, 3.0 })
+        == std::vector<double>{ 3.0, -2.25, 1.5 });
+
+    const auto throwing = [&client]
+    { std::ignore = client.template call_func<int>("RoundTripThrow", 1); };
+
+    REQUIRE_THROWS_AS(throwing(), rpc_hpp::remote_exec_error);
+
+    const auto missing = [&client]
+    { std::ignore = client.template call_func<int>("RoundTripMissing", 1); };
+
+    REQUIRE_THROWS_AS(missing(), rpc_hpp::function_not_found);
+
+    const auto mismatched = [&client]
+    { std::ignore = client.template call_func<int>("RoundTripSum", std::string{ "two" }, 3); };
+
+    REQUIRE_THROWS_AS(mismatched(), rpc_hpp::rpc_exception);
+}
+
+#if defined(RPC_HPP_ENABLE_NJSON)
+TEST_CASE_TEMPLATE("NjsonRoundTrip", TestType, njson_adapter, njson_cbor_adapter, njson_text_adapter)
+{
+    CheckRoundTrip<TestType>();
+}
+#endif
+
+#if defined(RPC_HPP_ENABLE_MSGPACK)
+TEST_CASE("MsgpackRoundTrip")
+{
+    CheckRoundTrip<msgpack_adapter>();
+}
+#endif
+
+#if defined(RPC_HPP_ENABLE_RAPIDJSON)
+TEST_CASE("RapidjsonRoundTrip")
+{
+    CheckRoundTrip<rapidjson_adapter>();
+}
+#endif
+
+#if defined(RPC_HPP_ENABLE_BOOST_JSON)
+TEST_CASE("BoostJsonRoundTrip")
+{
+    CheckRoundTrip<boost_json_adapter>();
+}
+#endif
+
+#if defined(RPC_HPP_ENABLE_SIMDJSON)
+TEST_CASE("SimdjsonRoundTrip")
+{
+    CheckRoundTrip<simdjson_adapter>();
+}
+#endif
+
+#if defined(RPC_HPP_ENABLE_NJSON)
+TEST_CASE("ConcurrentCalls")
+{
+    static constexpr uint64_t num_threads = 4;
+    static constexpr uint64_t calls_per_thread = 500;
+
+    LocalServer<njson_adapter> server;
+    server.bind("ConcurrentSquare",
+        std::function<uint64_t(uint64_t)>{ [](const uint64_t n) { return n * n; } });
+
+    // One client shared by every thread
+    LocalClient<njson_adapter> client{ server };
+    std::atomic<size_t> num_wrong{ 0 };
+    std::vector<std::thread> threads{};
+
+    for (uint64_t i = 0; i < num_threads; ++i)
+    {
+        threads.emplace_back(
+            [&client, &num_wrong, i]
+            {
+                for (uint64_t n = i * calls_per_thread; n < (i + 1) * calls_per_thread; ++n)
+                {
+                    if (client.call_func<uint64_t>("ConcurrentSquare", n) != n * n)
+                    {
+                        ++num_wrong;
+                    }
+                }
+            });
+    }
+
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    REQUIRE(num_wrong == 0);
+}
+#endif
+
+// Containers of optionals, variants and containers must round-trip, both through dispatch and through
+// serial objects (which adapters with typed parsing still use, e.g. to rebuild compact envelopes)
+template<typename Serial>
+void CheckNestedContainers()
+{
+    using opt_vec_t = std::vector<std::optional<int>>;
+    using var_vec_t = std::vector<std::variant<int, std::string>>;
+    using nested_vec_t = std::vector<std::vector<int>>;
+
+    LocalServer<Serial> server;
+
+    server.bind("NestedEchoOptionals",
+        std::function<opt_vec_t(opt_vec_t)>{ [](opt_vec_t vals) { return vals; } });
+
+    server.bind("NestedEchoVariants",
+        std::function<var_vec_t(var_vec_t)>{ [](var_vec_t vals) { return vals; } });
+
+    server.bind("NestedEchoNested",
+        std::function<nested_vec_t(nested_vec_t)>{ [](nested_vec_t vals) { return vals; } });
+
+    LocalClient<Serial> client{ server };
+
+    const opt_vec_t optionals{ 1, std::nullopt, 3 };
+    const var_vec_t variants{ 1, std::string{ "two" }, 3 };
+    const nested_vec_t nested{ { 1, 2 }, {}, { 3 } };
+
+    REQUIRE(client.template call_func<opt_vec_t>("NestedEchoOptionals", optionals) == optionals);
+    REQUIRE(client.template call_func<var_vec_t>("NestedEchoVariants", variants) == variants);
+    REQUIRE(client.template call_func<nested_vec_t>("NestedEchoNested", nested) == nested);
+
+    const rpc_hpp::detail::packed_func<void, opt_vec_t, var_vec_t, nested_vec_t> pack{
+        "NestedPack", { optionals, variants, nested }
+    };
+
+    // Kept alive while the serial object is used, as it may refer to the parsed bytes
+    auto bytes = Serial::to_bytes(Serial::serialize_pack(pack));
+    const auto serial_obj = Serial::from_bytes(std::move(bytes));
+    REQUIRE(serial_obj.has_value());
+
+    const auto parsed = Serial::template deserialize_pack<void, opt_vec_t, var_vec_t, nested_vec_t>(
+        serial_obj.value());
+
+    REQUIRE(parsed.get_args() == pack.get_args());
+}
+
+#if defined(RPC_HPP_ENABLE_NJSON)
+TEST_CASE_TEMPLATE(
+    "NjsonNestedContainers", TestType, njson_adapter, njson_cbor_adapter, njson_text_adapter)
+{
+    CheckNestedContainers<TestType>();
+}
+#endif
+
+#if defined(RPC_HPP_ENABLE_MSGPACK)
+TEST_CASE("MsgpackNestedContainers")
+{
+    CheckNestedContainers<msgpack_adapter>();
+}
+#endif
+
+#if defined(RPC_HPP_ENABLE_MSGPACK)
+TEST_CASE("MsgpackDuplicateKeys")
+{
+    using pairs_t = std::vector<std::vector<int>>;
+
+    // Maps with non-string keys and sets are both sent as arrays, so a vector can smuggle in a key
+    // twice
+    const auto bytes = msgpack_adapter::to_bytes(msgpack_adapter::serialize_pack(
+        rpc_hpp::detail::packed_func<void, pairs_t, std::vector<int>>{
+            "DuplicateKeys", { pairs_t{ { 1, 2 }, { 1, 3 } }, std::vector<int>{ 4, 4 } } }));
+
+    const auto serial_obj = msgpack_adapter::from_bytes(std::string{ bytes });
+    REQUIRE(serial_obj.has_value());
+
+    const auto as_map = [&serial_obj]
+    {
+        std::ignore = msgpack_adapter::deserialize_pack<void, std::map<int, int>, std::vector<int>>(
+            serial_obj.value());
+    };
+
+    const auto as_set = [&serial_obj]
+    {
+        std::ignore = msgpack_adapter::deserialize_pack<void, pairs_t, std::set<int>>(
+            serial_obj.value());
+    };
+
+    REQUIRE_THROWS_AS(as_map(), rpc_hpp::deserialization_error);
+    REQUIRE_THROWS_AS(as_set(), rpc_hpp::deserialization_error);
+
+    // Containers that allow equal keys keep every element
+    const auto parsed =
+        msgpack_adapter::deserialize_pack<void, std::multimap<int, int>, std::multiset<int>>(
+            serial_obj.value());
+
+    REQUIRE(std::get<0>(parsed.get_args()).size() == 2);
+    REQUIRE(std::get<1>(parsed.get_args()).count(4) == 2);
+}
+#endif
+
+#if defined(RPC_HPP_ENABLE_RAPIDJSON)
+TEST_CASE("RapidjsonNestedContainers")
+{
+    CheckNestedContainers<rapidjson_adapter>();
+}
+#endif
+
+#if defined(RPC_HPP_ENABLE_BOOST_JSON)
+TEST_CASE("BoostJsonNestedContainers")
+{
+    CheckNestedContainers<boost_json_adapter>();
+}
+#endif
+
+#if defined(RPC_HPP_ENABLE_SIMDJSON)
+TEST_CASE("SimdjsonNestedContainers")
+{
+    CheckNestedContainers<simdjson_adapter>();
+}
+#endif
+
+#if defined(RPC_HPP_ENABLE_SIMDJSON) || defined(RPC_HPP_ENABLE_RAPIDJSON) \
+    || defined(RPC_HPP_ENABLE_BOOST_JSON)
+TEST_CASE("JsonReaderSkip")
+{
+    using rpc_hpp::adapters::json_reader;
+
+    const auto skips = [](const std::string_view text)
+    {
+        json_reader reader{ text };
+        reader.skip();
+        return reader.at_end();
+    };
+
+    SUBCASE("Valid values")
+    {
+        REQUIRE(skips(R"([1, -2.5e3, "a\"b", {"k": [true, false, null]}, {}, [], [[]]])"));
+        REQUIRE(skips(R"({ "a" : { "b" : [ 1 , 2 ] } , "c" : "😀" })"));
+
+        json_reader reader{ R"([1, {"k": 2}] , 3)" };
+        REQUIRE(reader.read_raw() == R"([1, {"k": 2}])");
+        REQUIRE(reader.next_element());
+    }
+
+    SUBCASE("Malformed separators")
+    {
+        for (const auto* text : { "[1 2]", "[1,]", "[,1]", "[1,,2]", "[1}", "{\"a\" 1}",
+                 "{\"a\":1,}", "{\"a\":1 \"b\":2}", "{1:2}", "{\"a\"}", "{\"a\":1]", "[", "]" })
+        {
+            REQUIRE_THROWS_AS(std::ignore = skips(text), rpc_hpp::deserialization_error);
+        }
+    }
+
+    SUBCASE("Unpaired surrogates")
+    {
+        for (const auto* text :
+            { R"(["\udc00"])", R"(["\ud800"])", R"(["\ud800x"])", R"(["\ud800A"])" })
+        {
+            REQUIRE_THROWS_AS(std::ignore = skips(text), rpc_hpp::deserialization_error);
+        }
+
+        std::string buffer{};
+        json_reader reader{ R"("\udfff")" };
+        REQUIRE_THROWS_AS(std::ignore = reader.read_string(buffer), rpc_hpp::deserialization_error);
+    }
+}
+#endif
+
+// A MessagePack container claiming more elements than the request holds must be rejected before
+// the server reserves room for them
+template<typename Serial>
+void CheckOversizedContainer()
+{
+    LocalServer<Serial> server;
+    size_t num_calls = 0;
+
+    server.bind("OversizedCount",
+        std::function<size_t(std::vector<uint64_t>)>{
+            [&num_calls](const std::vector<uint64_t>& vals)
+            {
+                ++num_calls;
+                return vals.size();
+            } });
+
+    // {"func_name": "OversizedCount", "args": [<array of 0x7FFFFFFF elements>]}
+    const std::string func_name{ "OversizedCount" };
+    std::string body{ '\x82', '\xA9' };
+    body += "func_name";
+    body += static_cast<char>(0xA0U | func_name.size());
+    body += func_name;
+    body += '\xA4';
+    body += "args";
+    body += { '\x91', '\xDD', '\x7F', '\xFF', '\xFF', '\xFF' };
+
+    typename Serial::bytes_t request(body.begin(), body.end());
+
+#if defined(RPC_HPP_ENABLE_MESSAGE_HEADER)
+    rpc_hpp::message_header header{};
+    header.request_id = 1;
+    header.func_name = func_name;
+    header.prepend(request);
+#endif
+
+    auto reply = server.dispatch(std::move(request));
+
+#if defined(RPC_HPP_ENABLE_MESSAGE_HEADER)
+    const auto reply_header = rpc_hpp::message_header::read(reply);
+    REQUIRE(reply_header.has_value());
+    reply_header->remove_from(reply);
+#endif
+
+    const auto reply_obj = Serial::from_bytes(std::move(reply));
+    REQUIRE(reply_obj.has_value());
+    REQUIRE(Serial::extract_exception(reply_obj.value()).get_type()
+        != rpc_hpp::exception_type::none);
+    REQUIRE(num_calls == 0);
+}
+
+#if defined(RPC_HPP_ENABLE_NJSON)
+TEST_CASE("MsgpackOversizedContainer")
+{
+    // Array header claiming 0x7FFFFFFF elements, followed by a single one
+    const std::string bytes{ '\xDD', '\x7F', '\xFF', '\xFF', '\xFF', '\x01' };
+    rpc_hpp::adapters::msgpack_reader reader{ bytes };
+    REQUIRE_THROWS_AS(std::ignore = reader.read_array_header(), rpc_hpp::deserialization_error);
+
+    CheckOversizedContainer<njson_adapter>();
+
+#    if defined(RPC_HPP_ENABLE_MSGPACK)
+    CheckOversizedContainer<msgpack_adapter>();
+#    endif
+}
+#endif
+
+// The compact envelope makes njson_adapter write messages as an array instead of msgpack_adapter's map
+#if defined(RPC_HPP_ENABLE_MSGPACK) && defined(RPC_HPP_ENABLE_NJSON) \
+    && !defined(RPC_HPP_NJSON_COMPACT_ENVELOPE)
+namespace interop
+{
+using str_map_t = std::map<std::string, int>;
+using int_map_t = std::unordered_map<int, std::string>;
+using set_t = std::set<int>;
+using opt_t = std::optional<std::string>;
+using var_t = std::variant<int, std::string>;
+using pack_t = rpc_hpp::detail::packed_func<var_t, str_map_t, int_map_t, set_t, opt_t, opt_t>;
+} // namespace interop
+
+// msgpack_adapter and njson_adapter must encode maps, sets, optionals, and variants the same way
+template<typename From, typename To>
+void CheckMsgpackInterop()
+{
+    using namespace interop;
+
+    const pack_t pack{ "Interop", var_t{ std::string{ "result" } },
+        { str_map_t{ { "one", 1 }, { "two", 2 } }, int_map_t{ { 3, "three" }, { -4, "four" } },
+            set_t{ 5, 1, 3 }, opt_t{ "five" }, std::nullopt } };
+
+    const auto bytes = From::to_bytes(From::serialize_pack(pack));
+    const auto serial_obj = To::from_bytes(typename To::bytes_t(bytes.begin(), bytes.end()));
+    REQUIRE(serial_obj.has_value());
+
+    const auto parsed = To::template deserialize_pack<var_t, str_map_t, int_map_t, set_t, opt_t, opt_t>(
+        serial_obj.value());
+
+    REQUIRE(parsed.get_args() == pack.get_args());
+    REQUIRE(parsed.get_result() == pack.get_result());
+}
+
+TEST_CASE("MsgpackInterop")
+{
+    using namespace interop;
+
+    CheckMsgpackInterop<msgpack_adapter, njson_adapter>();
+    CheckMsgpackInterop<njson_adapter, msgpack_adapter>();
+
+    // A msgpack_adapter request, read by njson_adapter's typed parser on the server
+    LocalServer<njson_adapter> server;
+    server.bind("InteropDescribe",
+        std::function<opt_t(str_map_t, int_map_t, set_t, opt_t, var_t)>{
+            [](const str_map_t& strs, const int_map_t& ints, const set_t& vals, const opt_t& opt,
+                const var_t& var) -> opt_t
+            {
+                if (!opt.has_value())
+                {
+                    return std::nullopt;
+                }
+
+                return *opt + std::to_string(strs.size() + ints.size() + vals.size() + var.index());
+            } });
+
+    const auto call = [&server](const opt_t& opt)
+    {
+        const rpc_hpp::detail::packed_func<void, str_map_t, int_map_t, set_t, opt_t, var_t> pack{
+            "InteropDescribe",
+            { str_map_t{ { "one", 1 } }, int_map_t{ { 2, "two" } }, set_t{ 3, 4 }, opt,
+                var_t{ std::string{ "five" } } }
+        };
+
+        auto request = msgpack_adapter::to_bytes(msgpack_adapter::serialize_pack(pack));
+
+#    if defined(RPC_HPP_ENABLE_MESSAGE_HEADER)
+        rpc_hpp::message_header header{};
+        header.request_id = 1;
+        header.func_name = pack.get_func_name();
+        header.prepend(request);
+#    endif
+
+        auto reply = server.dispatch(typename njson_adapter::bytes_t(request.begin(), request.end()));
+
+#    if defined(RPC_HPP_ENABLE_MESSAGE_HEADER)
+        const auto reply_header = rpc_hpp::message_header::read(reply);
+        REQUIRE(reply_header.has_value());
+        reply_header->remove_from(reply);
+#    endif
+
+        const auto serial_obj = msgpack_adapter::from_bytes(std::string(reply.begin(), reply.end()));
+        REQUIRE(serial_obj.has_value());
+
+        return msgpack_adapter::deserialize_pack<opt_t, str_map_t, int_map_t, set_t, opt_t, var_t>(
+            serial_obj.value())
+            .get_result();
+    };
+
+    REQUIRE(call(opt_t{ "total: " }) == opt_t{ "total: 5" });
+    REQUIRE(call(std::nullopt) == std::nullopt);
+}
+#endif
+
+#if defined(RPC_HPP_ENABLE_MESSAGE_HEADER) && defined(RPC_HPP_ENABLE_NJSON)
+TEST_CASE_TEMPLATE(
+    "HeaderNameMismatch", TestType, njson_adapter, njson_cbor_adapter, njson_text_adapter)
+{
+    LocalServer<TestType> server;
+    size_t num_calls = 0;
+
+    server.bind("HeaderDouble",
+        std::function<int(int)>{ [&num_calls](const int n)
+            {
+                ++num_calls;
+                return n * 2;
+            } });
+
+    server.bind("HeaderNegate",
+        std::function<int(int)>{ [&num_calls](const int n)
+            {
+                ++num_calls;
+                return -n;
+            } });
+
+    LocalClient<TestType> client{ server };
+    REQUIRE(client.template call_func<int>("HeaderDouble", 4) == 8);
+
+    // Routes the request to another function than the one named in its body
+    client.tamper_with(
+        [](typename TestType::bytes_t& request)
+        {
+            auto header = rpc_hpp::message_header::read(request);
+            REQUIRE(header.has_value());
+
+            request.erase(
+                request.begin(), request.begin() + static_cast<std::ptrdiff_t>(header->size()));
+
+            header->func_name = "HeaderNegate";
+            header->prepend(request);
+        });
+
+    const auto call = [&client] { std::ignore = client.template call_func<int>("HeaderDouble", 4); };
+
+    REQUIRE_THROWS_AS(call(), rpc_hpp::function_mismatch);
+    REQUIRE(num_calls == 1);
+}
+
+TEST_CASE_TEMPLATE("HeaderInvalid", TestType, njson_adapter, njson_cbor_adapter, njson_text_adapter)
+{
+    using bytes_t = typename TestType::bytes_t;
+
+    LocalServer<TestType> server;
+    server.bind("HeaderSquare", std::function<int(int)>{ [](const int n) { return n * n; } });
+
+    LocalClient<TestType> client{ server };
+    const auto call = [&client] { std::ignore = client.template call_func<int>("HeaderSquare", 3); };
+
+    // The fixed part is intact, so the reply is matched to the request and carries the server's error
+    client.tamper_with(
+        [](bytes_t& request) { request.resize(rpc_hpp::message_header::fixed_size + 1); });
+    REQUIRE_THROWS_AS(call(), rpc_hpp::server_receive_error);
+
+    // Nothing identifies the request, so the reply has request ID 0 and still carries the server's error
+    client.tamper_with([](bytes_t& request) { request[0] = typename bytes_t::value_type{ 'X' }; });
+    REQUIRE_THROWS_AS(call(), rpc_hpp::server_receive_error);
+
+    client.tamper_with(nullptr);
+    REQUIRE(client.template call_func<int>("HeaderSquare", 3) == 9);
+}
+#endif
+
+TEST_CASE("BufferPool")
+{
+    using pool_t = rpc_hpp::buffer_pool<std::vector<uint8_t>>;
+
+    SUBCASE("Rounds up to a size class")
+    {
+        pool_t pool;
+        const auto buffer = pool.acquire(300);
+        REQUIRE(buffer.empty());
+        REQUIRE(buffer.capacity() >= 512);
+    }
+
+    SUBCASE("Recycles buffers")
+    {
+        pool_t pool;
+        auto buffer = pool.acquire(300);
+        const auto* const storage = buffer.data();
+        pool.release(std::move(buffer));
+
+        // Any request the class can serve gets the same buffer back, emptied
+        auto reused = pool.acquire(400);
+        REQUIRE(reused.data() == storage);
+        REQUIRE(reused.empty());
+        pool.release(std::move(reused));
+
+        reused = pool.acquire(10);
+        REQUIRE(reused.data() == storage);
+        pool.release(std::move(reused));
+
+        // But not a request larger than the buffer
+        const auto larger = pool.acquire(600);
+        REQUIRE(larger.data() != storage);
+        REQUIRE(larger.capacity() >= 1'024);
+    }
+
+    SUBCASE("Keeps a limited number per class")
+    {
+        pool_t pool;
+        std::vector<std::vector<uint8_t>> buffers;
+        std::set<const uint8_t*> storage;
+
+        for (size_t i = 0; i < pool_t::max_per_class + 1; ++i)
+        {
+            buffers.push_back(pool.acquire(pool_t::min_capacity));
+            storage.insert(buffers.back().data());
+        }
+
+        for (auto& buffer : buffers)
+        {
+            pool.release(std::move(buffer));
+        }
+
+        size_t num_reused = 0;
+
+        for (size_t i = 0; i < pool_t::max_per_class + 1; ++i)
+        {
+            buffers[i] = pool.acquire(pool_t::min_capacity);
+            num_reused += storage.count(buffers[i].data());
+        }
+
+        REQUIRE(num_reused == pool_t::max_per_class);
+    }
+
+    SUBCASE("Does not keep buffers outside of the classes")
+    {
+        pool_t pool;
+        std::vector<uint8_t> small;
+        small.reserve(pool_t::min_capacity / 2);
+        const auto* const small_storage = small.data();
+        pool.release(std::move(small));
+
+        std::vector<uint8_t> large;
+        large.reserve(pool_t::max_capacity * 2);
+        const auto* const large_storage = large.data();
+        pool.release(std::move(large));
+
+        REQUIRE(pool.acquire(1).data() != small_storage);
+        REQUIRE(pool.acquire(pool_t::max_capacity).data() != large_storage);
+    }
+
+    SUBCASE("Copies a range")
+    {
+        pool_t pool;
+        const std::vector<uint8_t> bytes{ 1, 2, 3 };
+        REQUIRE(pool.acquire(bytes.begin(), bytes.end()) == bytes);
+    }
+}
+
+TEST_CASE("MessageSizeHints")
+{
+    using hints = rpc_hpp::detail::message_size_hints;
+
+    REQUIRE(hints::get("HintUnknown") == hints::default_hint);
+
+    // The first size is taken as is
+    hints::update("HintFunc", 1'000);
+    REQUIRE(hints::get("HintFunc") == 1'000);
+
+    // Larger messages raise the hint at once
+    hints::update("HintFunc", 2'000);
+    REQUIRE(hints::get("HintFunc") == 2'000);
+
+    // Smaller messages lower it by an eighth at a time
+    hints::update("HintFunc", 10);
+    REQUIRE(hints::get("HintFunc") == 1'750);
+
+    hints::update("HintFunc", 10);
+    REQUIRE(hints::get("HintFunc") == 1'532);
+
+    // Until it settles on the message size
+    for (size_t i = 0; i < 100; ++i)
+    {
+        hints::update("HintFunc", 10);
+    }
+
+    REQUIRE(hints::get("HintFunc") == 10);
+
+    // Other functions keep their own hints
+    REQUIRE(hints::get("HintUnknown") == hints::default_hint);
+}
+
+// Fields listed out of declaration order are still matched to their members by name
+struct SwappedFields
+{
+    int first{};
+    int second{};
+};
+
+RPC_HPP_REFLECT(SwappedFields, second, first)
+
+TEST_CASE("ReflectFieldNames")
+{
+    SwappedFields obj{ 1, 2 };
+    const auto fields = rpc_hpp_fields(obj);
+
+    REQUIRE(&std::get<0>(fields) == &obj.second);
+    REQUIRE(&std::get<1>(fields) == &obj.first);
+
+#if defined(RPC_HPP_ENABLE_NJSON)
+    LocalServer<njson_text_adapter> server;
+    server.bind("SwapFields",
+        std::function<SwappedFields(SwappedFields)>{
+            [](const SwappedFields val) { return SwappedFields{ val.second, val.first }; } });
+
+    LocalClient<njson_text_adapter> client{ server };
+    const auto result = client.call_func<SwappedFields>("SwapFields", obj);
+
+    REQUIRE(result.first == 2);
+    REQUIRE(result.second == 1);
+#endif
+}
+
+#if defined(RPC_HPP_ENABLE_NJSON)
+TEST_CASE("MultiFormatOverlap")
+{
+    using rpc_hpp::multi_server;
+    using rpc_hpp::adapters::njson_bson_adapter;
+
+    // The catch-all last adapter accepts anything not accepted before it
+    REQUIRE_NOTHROW((multi_server<njson_text_adapter, njson_bson_adapter>{}));
+
+    // Nothing is left for the last adapter
+    REQUIRE_THROWS_AS((multi_server<njson_bson_adapter, njson_text_adapter>{}), std::logic_error);
+
+#    if defined(RPC_HPP_NJSON_COMPACT_ENVELOPE)
+    // Both write their envelope as an array, and MessagePack's short arrays begin with bytes that
+    // also begin CBOR arrays
+    REQUIRE_THROWS_AS(
+        (multi_server<njson_adapter, njson_cbor_adapter, njson_text_adapter>{}), std::logic_error);
+#    else
+    REQUIRE_NOTHROW((multi_server<njson_adapter, njson_cbor_adapter, njson_text_adapter>{}));
+#    endif
+
+#    if defined(RPC_HPP_ENABLE_MSGPACK) && !defined(RPC_HPP_NJSON_COMPACT_ENVELOPE)
+    // Both write messages as a MessagePack map
+    REQUIRE_THROWS_AS(
+        (multi_server<njson_adapter, msgpack_adapter, njson_text_adapter>{}), std::logic_error);
+#    endif
+
+#    if defined(RPC_HPP_ENABLE_RAPIDJSON)
+    // Both write JSON text
+    REQUIRE_THROWS_AS(
+        (multi_server<njson_text_adapter, rapidjson_adapter, njson_adapter>{}), std::logic_error);
+#    endif
+}
+#endif
+
+// Numeric containers sent as raw bytes must arrive intact, and must not be reinterpreted as
+// containers of another element type
+template<typename Serial>
+void CheckBinaryArrays()
+{
+    LocalServer<Serial> server;
+
+    server.bind("BinaryEchoDoubles",
+        std::function<std::vector<double>(std::vector<double>)>{
+            [](std::vector<double> vals) { return vals; } });
+
+    server.bind("BinaryEchoInts",
+        std::function<std::vector<int32_t>(std::vector<int32_t>)>{
+            [](std::vector<int32_t> vals) { return vals; } });
+
+    server.bind("BinaryEchoArray",
+        std::function<std::array<float, 3>(std::array<float, 3>)>{
+            [](const std::array<float, 3> vals) { return vals; } });
+
+    LocalClient<Serial> client{ server };
+
+    const std::vector<double> doubles{ 1.5, -2.25, 1e300, 0.0 };
+    const std::vector<int32_t> ints{ std::numeric_limits<int32_t>::min(), -1, 0, 7 };
+    const std::array<float, 3> floats{ 1.0F, 2.5F, -3.75F };
+
+    REQUIRE(client.template call_func<std::vector<double>>("BinaryEchoDoubles", doubles) == doubles);
+    REQUIRE(client.template call_func<std::vector<double>>(
+                "BinaryEchoDoubles", std::vector<double>{})
+                .empty());
+    REQUIRE(client.template call_func<std::vector<int32_t>>("BinaryEchoInts", ints) == ints);
+    REQUIRE(client.template call_func<std::array<float, 3>>("BinaryEchoArray", floats) == floats);
+
+    const auto wrong_type = [&client]
+    {
+        std::ignore = client.template call_func<std::vector<double>>(
+            "BinaryEchoDoubles", std::vector<float>{ 1.0F, 2.0F, 3.0F });
+    };
+
+    REQUIRE_THROWS_AS(wrong_type(), rpc_hpp::function_mismatch);
+
+    client.tamper_with([](typename Serial::bytes_t& request)
+        { request.resize(request.size() / 2); });
+
+    const auto truncated = [&client, &doubles]
+    { std::ignore = client.template call_func<std::vector<double>>("BinaryEchoDoubles", doubles); };
+
+    REQUIRE_THROWS_AS(truncated(), rpc_hpp::rpc_exception);
+}
+
+#if defined(RPC_HPP_ENABLE_NJSON) && defined(RPC_HPP_NJSON_BINARY_ARRAYS)
+TEST_CASE_TEMPLATE(
+    "NjsonBinaryArrays", TestType, njson_adapter, njson_cbor_adapter, njson_text_adapter)
+{
+    CheckBinaryArrays<TestType>();
+}
+#endif
+
+#if defined(RPC_HPP_ENABLE_RAPIDJSON) && defined(RPC_HPP_RAPIDJSON_BINARY_ARRAYS)
+TEST_CASE("RapidjsonBinaryArrays")
+{
+    CheckBinaryArrays<rapidjson_adapter>();
+}
+#endif
+
+#if defined(RPC_HPP_ENABLE_SIMDJSON) && defined(RPC_HPP_SIMDJSON_BINARY_ARRAYS)
+TEST_CASE("SimdjsonBinaryArrays")
+{
+    CheckBinaryArrays<simdjson_adapter>();
+}
+#endif
+
+#if defined(RPC_HPP_ENABLE_BOOST_JSON) && defined(RPC_HPP_BOOST_JSON_BINARY_ARRAYS)
+TEST_CASE("BoostJsonBinaryArrays")
+{
+    CheckBinaryArrays<boost_json_adapter>();
+}
+#endif
+
+// Requests written as a compact envelope must round-trip, including errors and reference arguments,
+// and requests with a corrupted envelope must be rejected before reaching the function
+template<typename Serial>
+void CheckCompactEnvelope()
+{
+    using bytes_t = typename Serial::bytes_t;
+    static constexpr bool is_text = std::is_same_v<bytes_t, std::string>;
+
+    LocalServer<Serial> server;
+    size_t num_calls = 0;
+
+    server.bind("CompactSum",
+        std::function<int(int, int)>{ [&num_calls](const int n1, const int n2)
+            {
+                ++num_calls;
+                return n1 + n2;
+            } });
+
+    server.bind("CompactAppend",
+        std::function<void(std::string&)>{ [](std::string& str) { str += "!"; } });
+
+    server.bind("CompactFind",
+        std::function<std::optional<int>(int)>{ [](const int n)
+            { return n > 0 ? std::make_optional(n) : std::nullopt; } });
+
+    server.bind("CompactThrow",
+        std::function<int(int)>{ [](const int) -> int { throw std::runtime_error("failed"); } });
+
+    LocalClient<Serial> client{ server };
+    bool compact_request = false;
+
+    client.tamper_with(
+        [&compact_request](const bytes_t& request)
+        {
+            if constexpr (is_text)
+            {
+                compact_request = !request.empty() && request.front() == '[';
+            }
+            else
+            {
+                const auto serial_obj = Serial::from_bytes(bytes_t{ request });
+                compact_request = serial_obj.has_value() && serial_obj->is_array();
+            }
+        });
+
+    REQUIRE(client.template call_func<int>("CompactSum", 2, 3) == 5);
+    REQUIRE(compact_request);
+
+    std::string str{ "hello" };
+    client.template call_func<void>("CompactAppend", str);
+    REQUIRE(str == "hello!");
+
+    REQUIRE(client.template call_func<std::optional<int>>("CompactFind", 4) == 4);
+    REQUIRE_FALSE(client.template call_func<std::optional<int>>("CompactFind", -4).has_value());
+
+    const auto throwing = [&client] { std::ignore = client.template call_func<int>("CompactThrow", 1); };
+    REQUIRE_THROWS_AS(throwing(), rpc_hpp::remote_exec_error);
+
+    const auto sum = [&client] { std::ignore = client.template call_func<int>("CompactSum", 2, 3); };
+
+    // The envelope version directly follows the opening of the array, in a single byte
+    client.tamper_with(
+        [](bytes_t& request)
+        {
+            using value_t = typename bytes_t::value_type;
+            request[1] = is_text ? value_t{ '9' } : value_t{ 9 };
+        });
+
+    REQUIRE_THROWS_AS(sum(), rpc_hpp::rpc_exception);
+
+    client.tamper_with([](bytes_t& request) { request.resize(request.size() / 2); });
+    REQUIRE_THROWS_AS(sum(), rpc_hpp::rpc_exception);
+
+    REQUIRE(num_calls == 1);
+}
+
+#if defined(RPC_HPP_ENABLE_NJSON) && defined(RPC_HPP_NJSON_COMPACT_ENVELOPE)
+TEST_CASE_TEMPLATE(
+    "NjsonCompactEnvelope", TestType, njson_adapter, njson_cbor_adapter, njson_text_adapter)
+{
+    CheckCompactEnvelope<TestType>();
+}
+#endif
+
+#if defined(RPC_HPP_ENABLE_RAPIDJSON) && defined(RPC_HPP_RAPIDJSON_COMPACT_ENVELOPE)
+TEST_CASE("RapidjsonCompactEnvelope")
+{
+    CheckCompactEnvelope<rapidjson_adapter>();
+}
+#endif
+
+#if defined(RPC_HPP_ENABLE_SIMDJSON) && defined(RPC_HPP_SIMDJSON_COMPACT_ENVELOPE)
+TEST_CASE("SimdjsonCompactEnvelope")
+{
+    CheckCompactEnvelope<simdjson_adapter>();
+}
+#endif
+
+#if defined(RPC_HPP_ENABLE_RAW)
+// raw_adapter header: signature (4 bytes), exception type (4), error length (2), name length (1),
+// result flag (1)
+static constexpr size_t raw_header_size = 12;
+static constexpr size_t raw_err_len_offset = 8;
+static constexpr size_t raw_name_len_offset = 10;
+
+TEST_CASE("RawRoundTrip")
+{
+    LocalServer<raw_adapter> server;
+
+    server.bind("RawSum",
+        std::function<double(int, double)>{ [](const int n, const double d) { return n + d; } });
+
+    server.bind("RawIncrement", std::function<void(int&)>{ [](int& n) { ++n; } });
+
+    LocalClient<raw_adapter> client{ server };
+
+    REQUIRE(client.call_func<double>("RawSum", 2, 0.5) == 2.5);
+
+    int n = 41;
+    client.call_func<void>("RawIncrement", n);
+    REQUIRE(n == 42);
+
+    const auto missing = [&client] { std::ignore = client.call_func<int>("RawMissing", 1); };
+    REQUIRE_THROWS_AS(missing(), rpc_hpp::function_not_found);
+}
+
+TEST_CASE("RawBuffer")
+{
+    const std::vector<uint8_t> bytes{ 1, 2, 3 };
+    const raw_adapter::buffer_t buffer(bytes.begin(), bytes.end());
+
+    // Only the bytes in use are exposed, regardless of capacity
+    REQUIRE(buffer.size() == 3);
+    REQUIRE(buffer.capacity() == rpc_hpp::adapters::raw_buffer_size);
+    REQUIRE(std::vector<uint8_t>(buffer.begin(), buffer.end()) == bytes);
+    REQUIRE_FALSE(buffer.overflowed());
+
+    const std::vector<uint8_t> too_long(rpc_hpp::adapters::raw_buffer_size + 1, 0);
+    const raw_adapter::buffer_t truncated(too_long.begin(), too_long.end());
+
+    REQUIRE(truncated.size() == rpc_hpp::adapters::raw_buffer_size);
+    REQUIRE(truncated.overflowed());
+}
+
+TEST_CASE("RawFromBytesRejects")
+{
+    const rpc_hpp::detail::packed_func<int, int> pack{ "RawSquare", std::nullopt, { 3 } };
+    const auto request = raw_adapter::serialize_pack(pack);
+
+    REQUIRE(raw_adapter::from_bytes(raw_adapter::buffer_t{ request }).has_value());
+
+    SUBCASE("Truncated header")
+    {
+        const raw_adapter::buffer_t truncated(
+            request.begin(), request.begin() + raw_header_size - 1);
+
+        REQUIRE_FALSE(raw_adapter::from_bytes(raw_adapter::buffer_t{ truncated }).has_value());
+    }
+
+    SUBCASE("Overlong message")
+    {
+        std::vector<uint8_t> overlong(request.begin(), request.end());
+        overlong.resize(raw_adapter::buffer_t::capacity() + 1);
+
+        REQUIRE_FALSE(
+            raw_adapter::from_bytes(raw_adapter::buffer_t(overlong.begin(), overlong.end()))
+                .has_value());
+    }
+
+    SUBCASE("Name past the end")
+    {
+        auto corrupted = request;
+        corrupted[raw_name_len_offset] = std::numeric_limits<uint8_t>::max();
+        REQUIRE_FALSE(raw_adapter::from_bytes(std::move(corrupted)).has_value());
+    }
+
+    SUBCASE("Error message past the end")
+    {
+        auto corrupted = request;
+        corrupted[raw_err_len_offset] = std::numeric_limits<uint8_t>::max();
+        REQUIRE_FALSE(raw_adapter::from_bytes(std::move(corrupted)).has_value());
+    }
+
+    SUBCASE("Empty name")
+    {
+        auto corrupted = request;
+        corrupted[raw_name_len_offset] = 0;
+        REQUIRE_FALSE(raw_adapter::from_bytes(std::move(corrupted)).has_value());
+    }
+}
+
+TEST_CASE("RawSignatureMismatch")
+{
+    LocalServer<raw_adapter> server;
+    size_t num_calls = 0;
+
+    server.bind("RawSquare",
+        std::function<int(int)>{ [&num_calls](const int n)
+            {
+                ++num_calls;
+                return n * n;
+            } });
+
+    LocalClient<raw_adapter> client{ server };
+
+    SUBCASE("Different argument type")
+    {
+        const auto call = [&client] { std::ignore = client.call_func<int>("RawSquare", 3.0); };
+        REQUIRE_THROWS_AS(call(), rpc_hpp::function_mismatch);
+    }
+
+    SUBCASE("Different result type")
+    {
+        const auto call = [&client] { std::ignore = client.call_func<double>("RawSquare", 3); };
+        REQUIRE_THROWS_AS(call(), rpc_hpp::function_mismatch);
+    }
+
+    SUBCASE("Same signature, but extra bytes")
+    {
+        const rpc_hpp::detail::packed_func<int, int> pack{ "RawSquare", std::nullopt, { 3 } };
+        auto request = raw_adapter::serialize_pack(pack);
+        request.resize(request.size() + 1);
+
+        const auto parse = [&request]
+        { std::ignore = raw_adapter::deserialize_pack<int, int>(request); };
+
+        REQUIRE_THROWS_AS(parse(), rpc_hpp::function_mismatch);
+    }
+
+    REQUIRE(num_calls == 0);
+}
+
+TEST_CASE("RawSetExceptionTruncates")
+{
+    const rpc_hpp::detail::packed_func<int, int> pack{ "RawSquare", std::nullopt, { 3 } };
+    auto serial_obj = raw_adapter::serialize_pack(pack);
+    const auto request_size = serial_obj.size();
+    const auto room = raw_adapter::buffer_t::capacity() - request_size;
+
+    // Messages are cut at the buffer's capacity, so that errors can always be reported
+    const std::string long_mesg(raw_adapter::buffer_t::capacity() * 2, 'E');
+    raw_adapter::set_exception(serial_obj, rpc_hpp::remote_exec_error{ long_mesg });
+
+    REQUIRE(serial_obj.size() == raw_adapter::buffer_t::capacity());
+
+    const auto ex = raw_adapter::extract_exception(serial_obj);
+    REQUIRE(ex.get_type() == rpc_hpp::exception_type::remote_exec);
+    REQUIRE(std::string{ ex.what() } == long_mesg.substr(0, room));
+
+    // Replacing the message frees the space taken by the old one
+    raw_adapter::set_exception(serial_obj, rpc_hpp::function_not_found{ "short" });
+
+    REQUIRE(serial_obj.size() == request_size + 5);
+    REQUIRE(std::string{ raw_adapter::extract_exception(serial_obj).what() } == "short");
+    REQUIRE(raw_adapter::from_bytes(std::move(serial_obj)).has_value());
+}
+
+TEST_CASE("RawBoolNormalized")
+{
+    LocalServer<raw_adapter> server;
+    bool received = false;
+
+    server.bind("RawNot",
+        std::function<bool(bool)>{ [&received](const bool b)
+            {
+                received = b;
+                return !b;
+            } });
+
+    LocalClient<raw_adapter> client{ server };
+
+    // The request has no result or error, so its last byte is the argument
+    client.tamper_with([](raw_adapter::buffer_t& request) { request[request.size() - 1] = 2; });
+    REQUIRE_FALSE(client.call_func<bool>("RawNot", true));
+    REQUIRE(static_cast<int>(received) == 1);
+
+    // Likewise, a result byte other than 0 or 1 is read as true
+    rpc_hpp::detail::packed_func<bool, bool> pack{ "RawNot", true, { false } };
+    auto reply = raw_adapter::serialize_pack(pack);
+    reply[reply.size() - 1] = 0x80;
+
+    const auto result = raw_adapter::deserialize_pack<bool, bool>(reply);
+    REQUIRE(static_cast<int>(result.get_result()) == 1);
+    REQUIRE(static_cast<int>(std::get<0>(result.get_args())) == 0);
+}
+#endif
+
+#if defined(RPC_HPP_ENABLE_VIEW)
+TEST_CASE("ViewEmptyContainers")
+{
+    LocalServer<view_adapter> server;
+
+    server.bind("ViewEcho",
+        std::function<std::vector<double>(std::vector<double>)>{
+            [](std::vector<double> vals) { return vals; } });
+
+    LocalClient<view_adapter> client{ server };
+
+    REQUIRE(client.call_func<std::vector<double>>("ViewEcho", std::vector<double>{}).empty());
+    REQUIRE(client.call_func<std::vector<double>>("ViewEcho", std::vector<double>{ 1.5, 2.5 })
+        == std::vector<double>{ 1.5, 2.5 });
+}
+
+TEST_CASE("ViewEmptyArray")
+{
+    LocalServer<view_adapter> server;
+
+    server.bind("ViewEchoEmptyArray",
+        std::function<std::array<double, 0>(std::array<double, 0>)>{
+            [](const std::array<double, 0> vals) { return vals; } });
+
+    server.bind("ViewEchoArray",
+        std::function<std::array<double, 3>(std::array<double, 3>)>{
+            [](const std::array<double, 3> vals) { return vals; } });
+
+    LocalClient<view_adapter> client{ server };
+
+    REQUIRE(client.call_func<std::array<double, 0>>("ViewEchoEmptyArray", std::array<double, 0>{})
+                .empty());
+
+    REQUIRE(client.call_func<std::array<double, 3>>(
+                "ViewEchoArray", std::array<double, 3>{ 1.0, 2.0, 3.0 })
+        == std::array<double, 3>{ 1.0, 2.0, 3.0 });
+
+    // A zero-length array does not fit a fixed extent of 3
+    const auto wrong_extent = [&client]
+    {
+        std::ignore =
+            client.call_func<std::array<double, 3>>("ViewEchoArray", std::array<double, 0>{});
+    };
+
+    REQUIRE_THROWS_AS(wrong_extent(), rpc_hpp::function_mismatch);
+}
+
+using rpc_hpp::adapters::view_entry;
+using rpc_hpp::adapters::view_kind;
+using rpc_hpp::adapters::view_message;
+
+// Entries of a list are stored after its uint32 count
+view_entry GetViewEntry(const std::string& bytes, const size_t list_offset, const size_t index)
+{
+    view_entry entry{};
+    memcpy(&entry, bytes.data() + list_offset + sizeof(uint32_t) + index * sizeof(view_entry),
+        sizeof(view_entry));
+
+    return entry;
+}
+
+void SetViewEntry(
+    std::string& bytes, const size_t list_offset, const size_t index, const view_entry& entry)
+{
+    memcpy(bytes.data() + list_offset + sizeof(uint32_t) + index * sizeof(view_entry), &entry,
+        sizeof(view_entry));
+}
+
+// Builds a request whose arguments are depth lists, each nested in the last
+std::string MakeNestedViewRequest(const size_t depth)
+{
+    static constexpr size_t level_size = sizeof(uint32_t) + sizeof(view_entry);
+    static const std::string func_name{ "ViewNested" };
+
+    std::string bytes(view_message::min_size, '\0');
+    memcpy(bytes.data(), &view_message::magic, sizeof(uint32_t));
+
+    const auto field_count = static_cast<uint32_t>(view_message::field_count);
+    memcpy(bytes.data() + view_message::root_offset, &field_count, sizeof(uint32_t));
+
+    SetViewEntry(bytes, view_message::root_offset, view_message::func_name,
+        view_entry{ static_cast<uint32_t>(bytes.size()), static_cast<uint32_t>(func_name.size()),
+            view_kind::string, view_kind::none, 0 });
+
+    bytes += func_name;
+    bytes.resize((bytes.size() + 7U) & ~size_t{ 7U }, '\0');
+
+    const size_t args_offset = bytes.size();
+    const size_t total_size = args_offset + (depth - 1) * level_size + sizeof(uint32_t);
+    bytes.resize(total_size, '\0');
+
+    for (size_t level = 0; level + 1 < depth; ++level)
+    {
+        const size_t offset = args_offset + level * level_size;
+        const uint32_t count = 1;
+        memcpy(bytes.data() + offset, &count, sizeof(uint32_t));
+
+        SetViewEntry(bytes, offset, 0,
+            view_entry{ static_cast<uint32_t>(offset + level_size),
+                static_cast<uint32_t>(total_size - offset - level_size), view_kind::list,
+                view_kind::none, 0 });
+    }
+
+    SetViewEntry(bytes, view_message::root_offset, view_message::args,
+        view_entry{ static_cast<uint32_t>(args_offset),
+            static_cast<uint32_t>(total_size - args_offset), view_kind::list, view_kind::none,
+            0 });
+
+    const auto size = static_cast<uint32_t>(bytes.size());
+    memcpy(bytes.data() + sizeof(uint32_t), &size, sizeof(uint32_t));
+    return bytes;
+}
+
+TEST_CASE("ViewRejectsCorruptEntries")
+{
+    const rpc_hpp::detail::packed_func<int, std::string, std::vector<double>> pack{ "ViewCorrupt",
+        std::nullopt, { "abc", { 1.0, 2.0, 3.0 } } };
+
+    const auto request = view_adapter::serialize_pack(pack).bytes;
+    REQUIRE(view_adapter::from_bytes(std::string{ request }).has_value());
+
+    const auto args = GetViewEntry(request, view_message::root_offset, view_message::args);
+    const auto array = GetViewEntry(request, args.offset, 1);
+    REQUIRE(args.kind == view_kind::list);
+    REQUIRE(array.kind == view_kind::array);
+
+    const auto rejects = [&request](const size_t list_offset, const size_t index,
+                             const view_entry& entry)
+    {
+        auto corrupted = request;
+        SetViewEntry(corrupted, list_offset, index, entry);
+        return !view_adapter::from_bytes(std::move(corrupted)).has_value();
+    };
+
+    SUBCASE("Out of bounds")
+    {
+        auto past_end = array;
+        past_end.size += 8;
+        REQUIRE(rejects(args.offset, 1, past_end));
+
+        auto after_end = array;
+        after_end.offset = static_cast<uint32_t>(request.size() + 8);
+        after_end.size = 0;
+        REQUIRE(rejects(args.offset, 1, after_end));
+    }
+
+    SUBCASE("Overlapping an entry table")
+    {
+        // A list pointing back at the root would otherwise be walked forever
+        auto cycle = args;
+        cycle.offset = static_cast<uint32_t>(view_message::root_offset);
+        REQUIRE(rejects(view_message::root_offset, view_message::args, cycle));
+
+        auto own_table = array;
+        own_table.offset = args.offset + 8;
+        REQUIRE(rejects(args.offset, 1, own_table));
+    }
+
+    SUBCASE("Misaligned")
+    {
+        auto misaligned_array = array;
+        misaligned_array.offset += 4;
+        misaligned_array.size -= 8;
+        REQUIRE(rejects(args.offset, 1, misaligned_array));
+
+        auto misaligned_list = args;
+        misaligned_list.offset += 1;
+        misaligned_list.size -= 1;
+        REQUIRE(rejects(view_message::root_offset, view_message::args, misaligned_list));
+    }
+
+    SUBCASE("Invalid kind or width")
+    {
+        auto bad_width = array;
+        bad_width.elem_size = 3;
+        REQUIRE(rejects(args.offset, 1, bad_width));
+
+        auto bad_kind = array;
+        bad_kind.kind = static_cast<view_kind>(0x7F);
+        REQUIRE(rejects(args.offset, 1, bad_kind));
+    }
+}
+
+TEST_CASE("ViewRejectsDeepNesting")
+{
+    REQUIRE(view_adapter::from_bytes(MakeNestedViewRequest(64)).has_value());
+    REQUIRE_FALSE(view_adapter::from_bytes(MakeNestedViewRequest(65)).has_value());
+}
+#endif
+
+#if defined(RPC_HPP_ENABLE_BITSERY)
+TEST_CASE("BitseryRoundTrip")
+{
+    LocalServer<bitsery_adapter> server;
+
+    server.bind("BitseryNegate",
+        std::function<int64_t(int64_t)>{ [](const int64_t n) { return -n; } });
+
+    server.bind("BitseryEcho",
+        std::function<std::vector<uint64_t>(std::vector<uint64_t>)>{
+            [](std::vector<uint64_t> vals) { return vals; } });
+
+    LocalClient<bitsery_adapter> client{ server };
+
+    // Covers every encoded width, including the sign handling of compact values
+    for (const int64_t n : { int64_t{ 0 }, int64_t{ 1 }, int64_t{ -1 }, int64_t{ 127 },
+             int64_t{ -128 }, int64_t{ 70'000 }, std::numeric_limits<int64_t>::max(),
+             std::numeric_limits<int64_t>::min() + 1 })
+    {
+        REQUIRE(client.call_func<int64_t>("BitseryNegate", n) == -n);
+    }
+
+    const std::vector<uint64_t> vals{ 0, 1, 300, uint64_t{ 1 } << 40U,
+        std::numeric_limits<uint64_t>::max() };
+
+    REQUIRE(client.call_func<std::vector<uint64_t>>("BitseryEcho", vals) == vals);
+}
+
+TEST_CASE("BitseryTruncatedRequest")
+{
+    LocalServer<bitsery_adapter> server;
+
+    server.bind("BitseryTruncated",
+        std::function<std::vector<uint64_t>(std::vector<uint64_t>)>{
+            [](std::vector<uint64_t> vals) { return vals; } });
+
+    LocalClient<bitsery_adapter> client{ server };
+    client.tamper_with([](std::vector<uint8_t>& request) { request.pop_back(); });
+
+    const auto call = [&client]
+    {
+        std::ignore = client.call_func<std::vector<uint64_t>>(
+            "BitseryTruncated", std::vector<uint64_t>{ 1, 1'000, 1'000'000 });
+    };
+
+    REQUIRE_THROWS_AS(call(), rpc_hpp::rpc_exception);
+}
+
+TEST_CASE("BitseryToBytesInto")
+{
+    static_assert(rpc_hpp::detail::has_to_bytes_into<bitsery_adapter>::value,
+        "replies should be written into the caller's buffer");
+
+    using pool_t = rpc_hpp::buffer_pool<std::vector<uint8_t>>;
+
+    const rpc_hpp::detail::packed_func<int64_t, int64_t> pack{ "BitseryNegate", int64_t{ -5 },
+        { 5 } };
+
+    const auto expected = bitsery_adapter::to_bytes(bitsery_adapter::serialize_pack(pack));
+
+    std::vector<uint8_t> out;
+    out.reserve(pool_t::max_capacity);
+    const auto* const old_storage = out.data();
+
+    bitsery_adapter::to_bytes(bitsery_adapter::serialize_pack(pack), out);
+
+    // Same message as the returning overload, but out's previous buffer went back to the pool
+    REQUIRE(out == expected);
+    REQUIRE(pool_t::local().acquire(pool_t::max_capacity).data() == old_storage);
+}
+
+#    if defined(RPC_HPP_BITSERY_COMPACT)
+TEST_CASE("BitseryCompactSize")
+{
+    const rpc_hpp::detail::packed_func<int, std::vector<uint64_t>> pack{ "BitseryCompactSize",
+        std::nullopt, { std::vector<uint64_t>(64, 1) } };
+
+    // Small values take a single byte each instead of their full width
+    REQUIRE(bitsery_adapter::serialize_pack(pack).size() < 64 * sizeof(uint64_t));
+}
+#    endif
+
+#    if defined(RPC_HPP_BITSERY_CHECKSUM)
+TEST_CASE("BitseryChecksum")
+{
+    const rpc_hpp::detail::packed_func<int, std::vector<uint64_t>> pack{ "BitseryChecksum",
+        std::nullopt, { std::vector<uint64_t>{ 1, 2, 3 } } };
+
+    const auto frame = bitsery_adapter::to_bytes(bitsery_adapter::serialize_pack(pack));
+
+    SUBCASE("Intact frame")
+    {
+        const auto serial_obj = bitsery_adapter::from_bytes(std::vector<uint8_t>{ frame });
+        REQUIRE(serial_obj.has_value());
+        REQUIRE(bitsery_adapter::get_func_name(*serial_obj) == "BitseryChecksum");
+
+        const auto result =
+            bitsery_adapter::deserialize_pack<int, std::vector<uint64_t>>(*serial_obj);
+
+        const std::vector<uint64_t> expected{ 1, 2, 3 };
+        REQUIRE(std::get<0>(result.get_args()) == expected);
+    }
+
+    SUBCASE("Corrupted payload")
+    {
+        auto corrupted = frame;
+        corrupted.back() ^= 0x01U;
+        REQUIRE_FALSE(bitsery_adapter::from_bytes(std::move(corrupted)).has_value());
+    }
+
+    SUBCASE("Corrupted checksum")
+    {
+        auto corrupted = frame;
+        corrupted[sizeof(uint32_t)] ^= 0x01U;
+        REQUIRE_FALSE(bitsery_adapter::from_bytes(std::move(corrupted)).has_value());
+    }
+
+    SUBCASE("Truncated frame")
+    {
+        auto truncated = frame;
+        truncated.pop_back();
+        REQUIRE_FALSE(bitsery_adapter::from_bytes(std::move(truncated)).has_value());
+    }
+
+    SUBCASE("Truncated header")
+    {
+        REQUIRE_FALSE(bitsery_adapter::from_bytes(
+            std::vector<uint8_t>(frame.begin(), frame.begin() + sizeof(uint32_t)))
+                          .has_value());
+    }
+}
+
+TEST_CASE("BitseryChecksumRejectsRequest")
+{
+    LocalServer<bitsery_adapter> server;
+    size_t num_calls = 0;
+
+    server.bind("BitseryChecked",
+        std::function<int64_t(int64_t)>{ [&num_calls](const int64_t n)
+            {
+                ++num_calls;
+                return n;
+            } });
+
+    const rpc_hpp::detail::packed_func<int64_t, int64_t> pack{ "BitseryChecked", std::nullopt,
+        { 5 } };
+
+    auto request = bitsery_adapter::to_bytes(bitsery_adapter::serialize_pack(pack));
+    request.back() ^= 0x01U;
+
+    const auto reply = bitsery_adapter::from_bytes(server.dispatch(std::move(request)));
+
+    REQUIRE(reply.has_value());
+    REQUIRE(bitsery_adapter::extract_exception(reply.value()).get_type()
+        == rpc_hpp::exception_type::server_receive);
+    REQUIRE(num_calls == 0);
+}
+#    endif
+#endif